@@ -0,0 +1,126 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file naviConStandIn.cpp
+ *
+ * @brief Implements NaviCon.dll stand-in library used by unit tests.
+ *
+ * The library exports the same 5 entry points as NaviCon.dll. The "terrain
+ * file" is a text file with the latitude and longitude of the landscape origin
+ * and the landscape is projected with a simple spherical projection.
+ *
+ * NOTE: Unlike NaviCon.dll the state is kept per thread so unit tests may run
+ * NaviCon.dll workers in threads of a single process and still have them
+ * initialized with different terrains. The state is kept in a TLS slot allocated
+ * when the library is loaded because __declspec(thread) variables do not work in
+ * libraries loaded with LoadLibrary() on Windows XP.
+ */
+
+#include <windows.h>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+  const double METERS_PER_DEGREE = 111120.0;
+  const double PI = 3.14159265358979323846;
+
+  /**
+   * @brief Per thread library state.
+   */
+  struct TState {
+    double originLat;
+    double originLon;
+  };
+
+  DWORD tlsIndex = TLS_OUT_OF_INDEXES;
+
+  TState &State()
+  {
+    TState *state = static_cast<TState *>(TlsGetValue(tlsIndex));
+    if(!state) {
+      state = new TState{};
+      TlsSetValue(tlsIndex, state);
+    }
+    return *state;
+  }
+
+  void StateFree()
+  {
+    delete static_cast<TState *>(TlsGetValue(tlsIndex));
+    TlsSetValue(tlsIndex, nullptr);
+  }
+
+}
+
+extern "C" {
+
+  BOOL WINAPI DllMain(HINSTANCE, DWORD reason, LPVOID)
+  {
+    switch(reason) {
+    case DLL_PROCESS_ATTACH:
+      tlsIndex = TlsAlloc();
+      return tlsIndex != TLS_OUT_OF_INDEXES;
+    case DLL_THREAD_DETACH:
+      StateFree();
+      break;
+    case DLL_PROCESS_DETACH:
+      StateFree();
+      TlsFree(tlsIndex);
+      break;
+    }
+    return TRUE;
+  }
+
+  int WINAPI NaviConInit(const char *trnFile)
+  {
+    FILE *file = fopen(trnFile, "r");
+    if(!file)
+      return 0;
+    TState &state = State();
+    const bool valid = fscanf(file, "%lf %lf", &state.originLat, &state.originLon) == 2;
+    fclose(file);
+    return valid ? 1 : 0;
+  }
+
+  float WINAPI GetMaxX()
+  {
+    return 200000.0f;
+  }
+
+  float WINAPI GetMaxY()
+  {
+    return 200000.0f;
+  }
+
+  float WINAPI XYToLat(float x, float y)
+  {
+    return static_cast<float>(State().originLat + y / METERS_PER_DEGREE);
+  }
+
+  float WINAPI XYToLon(float x, float y)
+  {
+    const TState &state = State();
+    return static_cast<float>(state.originLon + x / (METERS_PER_DEGREE * cos(state.originLat * PI / 180)));
+  }
+
+}
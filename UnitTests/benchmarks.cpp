@@ -0,0 +1,421 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+* @file benchmarks.cpp
+*
+* @brief Provides performance benchmarks for Condor2Nav project.
+*/
+
+#include "tools.h"
+#include "fileParserINI.h"
+#include "condor.h"
+#include "csvTokenizer.h"
+#include "istream.h"
+#include "projectionGrid.h"
+#include "mapIndex.h"
+#include "CppUnitTest.h"
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+using namespace condor2nav;
+
+namespace unitTests
+{
+  using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+  const bfs::path MAIN_SRC_DIR = "..";
+
+  /**
+   * @brief Measures the time of the operation.
+   *
+   * @param ops     The number of operations done by a single @p func call.
+   * @param repeats The number of @p func calls.
+   * @param func    The benchmarked operation.
+   *
+   * @return The average time of one operation in nanoseconds.
+   */
+  template<typename Func>
+  double Measure(size_t ops, unsigned repeats, Func func)
+  {
+    func();                                           // warm up
+    auto start = std::chrono::high_resolution_clock::now();
+    for(unsigned i=0; i<repeats; i++)
+      func();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / (static_cast<double>(ops) * repeats);
+  }
+
+  /**
+   * @brief Writes the benchmark result to the test log.
+   *
+   * @param name  The name of the benchmarked variant.
+   * @param value The result.
+   * @param unit  The unit of the result.
+   */
+  void Report(const std::string &name, double value, const char *unit = "ns/op")
+  {
+    std::ostringstream stream;
+    stream << name << ": " << value << " " << unit << std::endl;
+    Logger::WriteMessage(stream.str().c_str());
+  }
+
+  /**
+   * @brief Temporary file removed on destruction.
+   */
+  class CTempFile {
+    const bfs::path _path;
+  public:
+    CTempFile() : _path{bfs::temp_directory_path() / bfs::unique_path()} {}
+    ~CTempFile() { boost::system::error_code ec; bfs::remove(_path, ec); }
+    const bfs::path &Path() const { return _path; }
+  };
+
+
+  ////////////////////////   I N I   P A R S E R   ////////////////////////
+
+  TEST_CLASS(BenchmarkFileParserINI) {
+
+    /**
+     * @brief The layout of CFileParserINI before switching to hash tables.
+     */
+    class CLegacyINI {
+      using CValuesMap = std::map<std::string, std::string>;
+      std::deque<std::pair<std::string, CValuesMap>> _chaptersList;
+    public:
+      void Value(const std::string &chapter, const std::string &key, const std::string &value)
+      {
+        for(auto &ch : _chaptersList)
+          if(ch.first == chapter) {
+            ch.second[key] = value;
+            return;
+          }
+        _chaptersList.emplace_back(chapter, CValuesMap{});
+        _chaptersList.back().second[key] = value;
+      }
+      const std::string &Value(const std::string &chapter, const std::string &key) const
+      {
+        for(auto &ch : _chaptersList)
+          if(ch.first == chapter)
+            return ch.second.find(key)->second;
+        throw EOperationFailed{"ERROR: Chapter '" + chapter + "' not found!!!"};
+      }
+    };
+
+  public:
+    TEST_METHOD(Lookup)
+    {
+      // profile-like file: a few chapters with hundreds of keys, 'Task' being the last one
+      const char *chapters[] = { "Condor2Nav", "XCSoar", "LK8000", "Plane", "Weather", "Task" };
+      const unsigned keysNum = 300;
+      std::vector<std::string> keys;
+      for(unsigned i=0; i<keysNum; i++)
+        keys.push_back("TPPosX" + Convert(i));
+
+      CTempFile file;
+      CLegacyINI legacy;
+      {
+        bfs::ofstream stream{file.Path()};
+        for(auto ch : chapters) {
+          stream << "[" << ch << "]" << std::endl;
+          for(unsigned i=0; i<keysNum; i++) {
+            stream << keys[i] << "=" << i << std::endl;
+            legacy.Value(ch, keys[i], Convert(i));
+          }
+        }
+      }
+      CFileParserINI parser{file.Path()};
+
+      const unsigned repeats = 1000;
+      size_t sum1 = 0, sum2 = 0;
+      auto legacyNs = Measure(keys.size(), repeats, [&]{
+        for(const auto &k : keys)
+          sum1 += legacy.Value("Task", k).size();
+      });
+      auto hashedNs = Measure(keys.size(), repeats, [&]{
+        for(const auto &k : keys)
+          sum2 += parser.Value("Task", k).size();
+      });
+      Report("std::map/std::deque", legacyNs);
+      Report("CHashTable", hashedNs);
+      Assert::AreEqual(sum1, sum2);
+    }
+  };
+
+
+
+  ////////////////////////   C S V   T O K E N I Z E R   ////////////////////////
+
+  TEST_CLASS(BenchmarkCSVTokenizer) {
+  public:
+    TEST_METHOD(WaypointFilesThroughput)
+    {
+      // load all waypoint files to memory
+      std::vector<std::string> lines;
+      size_t bytes = 0;
+      for(bfs::directory_iterator it(MAIN_SRC_DIR / "data/LK8000/Waypoints"), end; it != end; ++it) {
+        CIStream stream(it->path());
+        std::string line;
+        while(stream.GetLine(line)) {
+          bytes += line.size();
+          lines.emplace_back(std::move(line));
+        }
+      }
+
+      std::vector<std::pair<TCSVTokenizer, const char *>> tokenizers{ { TCSVTokenizer::SCALAR, "Scalar" } };
+      if(CSVTokenizerBest() != TCSVTokenizer::SCALAR)
+        tokenizers.emplace_back(TCSVTokenizer::SSE2, "SSE2");
+      if(CSVTokenizerBest() == TCSVTokenizer::AVX2)
+        tokenizers.emplace_back(TCSVTokenizer::AVX2, "AVX2");
+
+      const unsigned repeats = 20;
+      CFieldViews fields;
+      for(auto &t : tokenizers) {
+        size_t count = 0;
+        auto ns = Measure(bytes, repeats, [&]{
+          for(const auto &line : lines) {
+            CSVTokenize(line, fields, t.first);
+            count += fields.size();
+          }
+        });
+        Report(t.second, 1000.0 / ns, "MB/s");
+        Assert::IsTrue(count > 0);
+      }
+    }
+  };
+
+
+
+  ////////////////////////   C O N V E R S I O N S   ////////////////////////
+
+  TEST_CLASS(BenchmarkConvert) {
+    template<class T>
+    static T StreamConvert(const std::string &str)
+    {
+      T value;
+      std::stringstream stream{str};
+      stream >> value;
+      return value;
+    }
+
+    template<class T>
+    static std::string StreamConvert(const T &val)
+    {
+      std::stringstream stream;
+      stream << val;
+      return stream.str();
+    }
+
+    static const unsigned SIZE = 1000;
+    static const unsigned REPEATS = 100;
+
+  public:
+    TEST_METHOD(UnsignedFromText)
+    {
+      std::vector<std::string> texts;
+      for(unsigned i=0; i<SIZE; i++)
+        texts.push_back(StreamConvert(i * 7919));
+      unsigned sum1 = 0, sum2 = 0;
+      Report("stream", Measure(SIZE, REPEATS, [&]{ for(const auto &t : texts) sum1 += StreamConvert<unsigned>(t); }));
+      Report("Convert", Measure(SIZE, REPEATS, [&]{ for(const auto &t : texts) sum2 += Convert<unsigned>(t); }));
+      Assert::AreEqual(sum1, sum2);
+    }
+
+    TEST_METHOD(DoubleFromText)
+    {
+      std::vector<std::string> texts;
+      for(unsigned i=0; i<SIZE; i++)
+        texts.push_back(StreamConvert(i * 0.731 - 250));
+      double sum1 = 0, sum2 = 0;
+      Report("stream", Measure(SIZE, REPEATS, [&]{ for(const auto &t : texts) sum1 += StreamConvert<double>(t); }));
+      Report("Convert", Measure(SIZE, REPEATS, [&]{ for(const auto &t : texts) sum2 += Convert<double>(t); }));
+      Assert::AreEqual(sum1, sum2);
+    }
+
+    TEST_METHOD(UnsignedToText)
+    {
+      size_t len1 = 0, len2 = 0;
+      Report("stream", Measure(SIZE, REPEATS, [&]{ for(unsigned i=0; i<SIZE; i++) len1 += StreamConvert(i).size(); }));
+      Report("Convert", Measure(SIZE, REPEATS, [&]{ for(unsigned i=0; i<SIZE; i++) len2 += Convert(i).size(); }));
+      Assert::AreEqual(len1, len2);
+    }
+
+    TEST_METHOD(DoubleToText)
+    {
+      size_t len1 = 0, len2 = 0;
+      Report("stream", Measure(SIZE, REPEATS, [&]{ for(unsigned i=0; i<SIZE; i++) len1 += StreamConvert(i * 0.731 - 250).size(); }));
+      Report("Convert", Measure(SIZE, REPEATS, [&]{ for(unsigned i=0; i<SIZE; i++) len2 += Convert(i * 0.731 - 250).size(); }));
+      Assert::AreEqual(len1, len2);
+    }
+  };
+
+
+
+  ////////////////////////   P R O J E C T I O N   G R I D   ////////////////////////
+
+  TEST_CLASS(BenchmarkProjectionGrid) {
+  public:
+    TEST_METHOD(Interpolation)
+    {
+      // spherical stand-in of NaviCon.dll projection
+      auto lat = [](float x, float y){ return 45.0 + Rad2Deg(y / 6371000.0); };
+      auto lon = [&](float x, float y){ return 7.0 - Rad2Deg(x / (6371000.0 * cos(Deg2Rad(lat(x, y))))); };
+      CProjectionGrid::TStamp stamp = { 0, 0 };
+      const CProjectionGrid grid{stamp, 600000.0f, 600000.0f, CCondor::CCoordConverter::GRID_STEP, lat, lon};
+
+      const unsigned size = 10000;
+      std::vector<float> x, y;
+      for(unsigned i=0; i<size; i++) {
+        x.push_back(static_cast<float>((i * 7919) % 600000));
+        y.push_back(static_cast<float>((i * 104729) % 600000));
+      }
+      std::vector<double> latitude(size), longitude(size);
+
+      double sum = 0;
+      Report("stand-in projection", Measure(size, 10, [&]{ for(unsigned i=0; i<size; i++) sum += lat(x[i], y[i]) + lon(x[i], y[i]); }));
+      Report("Scalar", Measure(size, 100, [&]{
+        grid.LatLon(x.data(), y.data(), size, latitude.data(), longitude.data(), CProjectionGrid::TInterpolation::SCALAR);
+      }));
+      if(CProjectionGrid::InterpolationBest() == CProjectionGrid::TInterpolation::SSE2)
+        Report("SSE2", Measure(size, 100, [&]{
+          grid.LatLon(x.data(), y.data(), size, latitude.data(), longitude.data(), CProjectionGrid::TInterpolation::SSE2);
+        }));
+      Assert::IsTrue(sum != 0);
+    }
+  };
+
+
+
+  ////////////////////////   M A P   I N D E X   ////////////////////////
+
+  TEST_CLASS(BenchmarkMapIndex) {
+  public:
+    TEST_METHOD(LandscapesMatch)
+    {
+      // synthetic catalogue of LK8000 maps templates and Condor landscapes inside some of them
+      const unsigned mapsNum = 10000;
+      const unsigned landscapesNum = 100;
+      const unsigned scales[] = { 250, 500, 1000 };
+      std::mt19937 random{2012};
+      std::uniform_real_distribution<double> lon{-180, 170}, lat{-70, 60}, size{1, 10}, ratio{0, 0.5};
+
+      CTempFile file;
+      bfs::ofstream{file.Path()};
+      std::vector<std::unique_ptr<CFileParserINI>> maps;
+      for(unsigned i=0; i<mapsNum; i++) {
+        const double lonMin = lon(random), latMin = lat(random);
+        maps.emplace_back(new CFileParserINI{file.Path()});
+        auto &map = *maps.back();
+        map.Value("", "LONMIN", Convert(lonMin));
+        map.Value("", "LONMAX", Convert(lonMin + size(random)));
+        map.Value("", "LATMIN", Convert(latMin));
+        map.Value("", "LATMAX", Convert(latMin + size(random)));
+        const unsigned scale = scales[random() % 3];
+        map.Value("", "RES250", scale == 250 ? "YES" : "NO");
+        map.Value("", "RES500", scale == 500 ? "YES" : "NO");
+        map.Value("", "RES1000", scale == 1000 ? "YES" : "NO");
+      }
+      auto scale = [](const CFileParserINI &map) -> unsigned {
+        if(map.Value("", "RES250") == "YES")
+          return 250;
+        if(map.Value("", "RES500") == "YES")
+          return 500;
+        return 1000;
+      };
+      auto bounds = [](const CFileParserINI &ini) {
+        const CMapIndex::TBox box = {
+          Convert<double>(ini.Value("", "LONMIN")), Convert<double>(ini.Value("", "LONMAX")),
+          Convert<double>(ini.Value("", "LATMIN")), Convert<double>(ini.Value("", "LATMAX"))
+        };
+        return box;
+      };
+
+      std::vector<CMapIndex::TBox> landscapes;
+      for(unsigned i=0; i<landscapesNum; i++) {
+        const auto box = bounds(*maps[random() % mapsNum]);
+        const double width = box.lonMax - box.lonMin, height = box.latMax - box.latMin;
+        const CMapIndex::TBox landscape = {
+          box.lonMin + width * ratio(random), box.lonMax - width * ratio(random),
+          box.latMin + height * ratio(random), box.latMax - height * ratio(random)
+        };
+        landscapes.push_back(landscape);
+      }
+
+      // string parsing of every landscape and map pair
+      std::vector<size_t> legacy(landscapesNum);
+      auto legacyNs = Measure(landscapesNum, 1, [&]{
+        for(unsigned l=0; l<landscapesNum; l++) {
+          size_t best = CMapIndex::NOT_FOUND;
+          for(size_t m=0; m<maps.size(); m++)
+            if(bounds(*maps[m]).Contains(landscapes[l]) && (best == CMapIndex::NOT_FOUND || scale(*maps[m]) < scale(*maps[best])))
+              best = m;
+          legacy[l] = best;
+        }
+      });
+
+      // bounds parsed once and sorted by scale
+      std::vector<size_t> order(mapsNum);
+      std::vector<CMapIndex::TBox> boxes;
+      auto buildNs = Measure(mapsNum, 1, [&]{
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t l, size_t r) { return scale(*maps[l]) < scale(*maps[r]); });
+        boxes.clear();
+        for(auto m : order)
+          boxes.push_back(bounds(*maps[m]));
+      });
+      std::vector<size_t> linear(landscapesNum);
+      auto linearNs = Measure(landscapesNum, 100, [&]{
+        for(unsigned l=0; l<landscapesNum; l++) {
+          size_t m = 0;
+          while(m < boxes.size() && !boxes[m].Contains(landscapes[l]))
+            m++;
+          linear[l] = m < boxes.size() ? order[m] : CMapIndex::NOT_FOUND;
+        }
+      });
+
+      // spatial index
+      std::unique_ptr<CMapIndex> index;
+      auto indexBuildNs = Measure(mapsNum, 10, [&]{ index.reset(new CMapIndex{boxes}); });
+      std::vector<size_t> indexed(landscapesNum);
+      auto indexNs = Measure(landscapesNum, 1000, [&]{
+        for(unsigned l=0; l<landscapesNum; l++) {
+          const size_t m = index->Find(landscapes[l]);
+          indexed[l] = m != CMapIndex::NOT_FOUND ? order[m] : CMapIndex::NOT_FOUND;
+        }
+      });
+
+      Report("INI values parsing per pair", legacyNs, "ns/landscape");
+      Report("bounds parsing and sorting", buildNs, "ns/map");
+      Report("linear scan of sorted bounds", linearNs, "ns/landscape");
+      Report("CMapIndex build", indexBuildNs, "ns/map");
+      Report("CMapIndex", indexNs, "ns/landscape");
+      Assert::IsTrue(legacy == linear);
+      Assert::IsTrue(legacy == indexed);
+    }
+  };
+
+}
@@ -1,331 +1,2617 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
-* @file unittests.cpp
-*
-* @brief Provides unit tests for Condor2Nav project.
-*/
-
-#include "tools.h"
-#include "activeObject.h"
-#include "condor.h"
-#include "istream.h"
-#include "fileParserCSV.h"
-#include "fileParserINI.h"
-#include "CppUnitTest.h"
-#include <boost/filesystem.hpp>
-#include <boost/filesystem/fstream.hpp>
-
-using namespace condor2nav;
-
-template<> static std::wstring Microsoft::VisualStudio::CppUnitTestFramework::ToString<TPathType>(const TPathType& val)
-{
-  return val == TPathType::LOCAL ? L"LOCAL" : L"ACTIVE_SYNC";
-}
-
-namespace unitTests
-{
-  using namespace Microsoft::VisualStudio::CppUnitTestFramework;
-
-  const bfs::path MAIN_SRC_DIR = "..";
-
-
-  ////////////////////////   U T I L I T I E S   ////////////////////////
-
-  TEST_CLASS(TestUtilities) {
-  public:
-    TEST_METHOD(ConversionsToText)
-    {
-      Assert::AreEqual(std::string{"0"},      Convert(0));
-      Assert::AreEqual(std::string{"3"},      Convert(3));
-      Assert::AreEqual(std::string{"-123"},   Convert(-123));
-      Assert::AreEqual(std::string{"99.123"}, Convert(99.123));
-    }
-
-    TEST_METHOD(ConversionsFromText)
-    {
-      Assert::AreEqual(0,      Convert<int>("0"));
-      Assert::AreEqual(3,      Convert<int>("3"));
-      Assert::AreEqual(-123,   Convert<int>("-123"));
-      Assert::AreEqual(99.123, Convert<double>("99.123"));
-    }
-
-    TEST_METHOD(ConversionsCoordinatesToText)
-    {
-      Assert::AreEqual(std::string{ "00:00.000N"}, Coord2DDMMFF(TLatitude{0}));
-      Assert::AreEqual(std::string{"000:00.000E"}, Coord2DDMMFF(TLongitude{0}));
-      Assert::AreEqual(std::string{ "54:22.000N"}, Coord2DDMMFF(TLatitude{54.366667}));
-      Assert::AreEqual(std::string{"018:38.000E"}, Coord2DDMMFF(TLongitude{18.6333336}));
-      Assert::AreEqual(std::string{ "21:34.767N"}, Coord2DDMMFF(TLatitude{21.5794446}));
-      Assert::AreEqual(std::string{"158:11.833W"}, Coord2DDMMFF(TLongitude{-158.1972226}));
-      Assert::AreEqual(std::string{ "13:09.783S"}, Coord2DDMMFF(TLatitude{-13.163056}));
-      Assert::AreEqual(std::string{"072:32.733W"}, Coord2DDMMFF(TLongitude{-72.545556}));
-
-      Assert::AreEqual(std::string{ "00:00:00N"},  Coord2DDMMSS(TLatitude{0}));
-      Assert::AreEqual(std::string{"000:00:00E"},  Coord2DDMMSS(TLongitude{0}));
-      Assert::AreEqual(std::string{ "54:22:00N"},  Coord2DDMMSS(TLatitude{54.366667}));
-      Assert::AreEqual(std::string{"018:38:00E"},  Coord2DDMMSS(TLongitude{18.6333336}));
-      Assert::AreEqual(std::string{ "21:34:46N"},  Coord2DDMMSS(TLatitude{21.5794446}));
-      Assert::AreEqual(std::string{"158:11:50W"},  Coord2DDMMSS(TLongitude{-158.1972226}));
-      Assert::AreEqual(std::string{ "13:09:47S"},  Coord2DDMMSS(TLatitude{-13.163056}));
-      Assert::AreEqual(std::string{"072:32:44W"},  Coord2DDMMSS(TLongitude{-72.545556}));
-    }
-
-    TEST_METHOD(ConversionsSpeed)
-    {
-      Assert::AreEqual(0,  KmH2MS(0));
-      Assert::AreEqual(20, KmH2MS(72));
-      Assert::AreEqual(28, KmH2MS(100));
-    }
-
-    TEST_METHOD(ConversionsDeg2Rad)
-    {
-      Assert::AreEqual(0.0,         Deg2Rad(0));
-      Assert::AreEqual(0.785398163, Deg2Rad(45),  0.00001);
-      Assert::AreEqual(1.74532925,  Deg2Rad(100), 0.00001);
-    }
-
-    TEST_METHOD(ConversionsRad2Deg)
-    {
-      Assert::AreEqual(0.0,   Rad2Deg(0));
-      Assert::AreEqual(45.0,  Rad2Deg(0.785398163), 0.00001);
-      Assert::AreEqual(100.0, Rad2Deg(1.74532925),  0.00001);
-    }
-
-    TEST_METHOD(InsideAreaTest)
-    {
-      Assert::IsTrue(InsideArea(TLongitude{-10}, TLongitude{10}, TLatitude{-10}, TLatitude{10},
-                                TLongitude{-5}, TLongitude{5}, TLatitude{-5}, TLatitude{5}));
-      Assert::IsTrue(InsideArea(TLongitude{-10}, TLongitude{10}, TLatitude{-10}, TLatitude{10},
-                                TLongitude{-10}, TLongitude{10}, TLatitude{-10}, TLatitude{10}));
-      Assert::IsFalse(InsideArea(TLongitude{-10}, TLongitude{10}, TLatitude{-10}, TLatitude{10},
-                                 TLongitude{-20}, TLongitude{20}, TLatitude{-20}, TLatitude{20}));
-    }
-
-    TEST_METHOD(PathTypes)
-    {
-      Assert::AreEqual(TPathType::LOCAL, PathType(""));
-      Assert::AreEqual(TPathType::LOCAL, PathType("."));
-      Assert::AreEqual(TPathType::LOCAL, PathType(".."));
-      Assert::AreEqual(TPathType::LOCAL, PathType("dir"));
-      Assert::AreEqual(TPathType::LOCAL, PathType("dir/"));
-      Assert::AreEqual(TPathType::LOCAL, PathType("dir/subdir"));
-      Assert::AreEqual(TPathType::LOCAL, PathType("dir/subdir/"));
-      Assert::AreEqual(TPathType::LOCAL, PathType("../dir/subdir/"));
-      Assert::AreEqual(TPathType::LOCAL, PathType("dir\\"));
-      Assert::AreEqual(TPathType::LOCAL, PathType("dir\\subdir"));
-      Assert::AreEqual(TPathType::LOCAL, PathType("dir\\subdir\\"));
-      Assert::AreEqual(TPathType::LOCAL, PathType("..\\dir\\subdir\\"));
-      Assert::AreEqual(TPathType::LOCAL, PathType("c:\\"));
-      Assert::AreEqual(TPathType::LOCAL, PathType("c:\\dir"));
-      Assert::AreEqual(TPathType::LOCAL, PathType("d:"));
-      Assert::AreEqual(TPathType::ACTIVE_SYNC, PathType("\\dir"));
-    }
-
-    TEST_METHOD(FileExistsTest)
-    {
-      Assert::IsTrue(FileExists("UnitTests.dll"));
-      Assert::IsTrue(FileExists("unitTests.DLL"));
-      Assert::IsTrue(FileExists("./UnitTests.dll"));
-      Assert::IsTrue(FileExists(".\\UnitTests.dll"));
-      Assert::IsFalse(FileExists("nonexisting"));
-    }
-
-  };
-
-
-
-  ////////////////////////   A C T I V E   O B J E C T   ////////////////////////
-
-  TEST_CLASS(TestActiveObject) {
-  public:
-    TEST_METHOD(SimpleCommand)
-    {
-      int data = 123;
-      {
-        CActiveObject obj;
-        obj.Send([&]{ data = 234; });
-      }
-      Assert::AreEqual(234, data);
-    }
-  };
-
-
-
-  ////////////////////////   I S T R E A M   ////////////////////////
-
-  TEST_CLASS(TestIStream) {
-  public:
-    TEST_METHOD(InvalidInput)
-    {
-      Assert::ExpectException<EOperationFailed>([]{ CIStream stream("nonexisting.some_file"); });
-    }
-
-    TEST_METHOD(ValidInput)
-    {
-      CIStream actual(MAIN_SRC_DIR / "README.txt");
-      std::stringstream actualStr;
-      actualStr << actual;
-      bfs::ifstream expected(MAIN_SRC_DIR / "README.txt");
-      std::stringstream expectedStr;
-      expectedStr << expected.rdbuf();
-      Assert::AreEqual(expectedStr.str(), actualStr.str());
-    }
-
-    TEST_METHOD(GetLine)
-    {
-      CIStream stream(MAIN_SRC_DIR / "README.txt");
-      Assert::IsTrue(static_cast<bool>(stream));
-      std::string txt;
-      stream.GetLine(txt);
-      Assert::AreEqual(std::string( "================"), txt);
-      Assert::IsTrue(static_cast<bool>(stream));
-      while(stream)
-        stream.GetLine(txt);
-      Assert::AreEqual(std::string(""), txt);
-      Assert::IsFalse(static_cast<bool>(stream));
-    }
-  };
-
-
-
-  ////////////////////////   F I L E   P A R S E R    I N I   ////////////////////////
-
-  TEST_CLASS(TestFileParserINI) {
-  public:
-    TEST_METHOD(InvalidINIFile)
-    {
-      Assert::ExpectException<EOperationFailed>([]{ CFileParserINI parser("nonexisting.some_file"); });
-    }
-
-    TEST_METHOD(NotAnINIFile)
-    {
-      Assert::ExpectException<EOperationFailed>([]{ CFileParserINI parser(MAIN_SRC_DIR / "data/GliderData.csv"); });
-    }
-
-    TEST_METHOD(ValidINIFile)
-    {
-      CFileParserINI parser(MAIN_SRC_DIR / "data/condor2nav.ini");
-      Assert::AreEqual((MAIN_SRC_DIR / "data/condor2nav.ini").string(), parser.Path().string());
-      Assert::AreEqual(std::string("LK8000"), parser.Value("Condor2Nav", "Target"));
-      Assert::AreEqual(std::string("1"), parser.Value("LK8000", "DefaultTaskOverwrite"));
-      Assert::AreEqual(std::string("1"), parser.Value("LK8000", "CheckForMapUpdates"));
-    }
-
-    TEST_METHOD(InvalidINIEntry)
-    {
-      CFileParserINI parser(MAIN_SRC_DIR / "data/condor2nav.ini");
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("Condor2Nav", "DefaultTaskOverwrite"); });
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("", "DefaultTaskOverwrite"); });
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("Condor2Nav", "NonExisting"); });
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("NonExisting", "DefaultTaskOverwrite"); });
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("NonExisting", ""); });
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("", ""); });
-    }
-
-    TEST_METHOD(ValidINIValueOverwrite)
-    {
-      CFileParserINI parser(MAIN_SRC_DIR / "data/condor2nav.ini");
-      parser.Value("Condor2Nav", "Target", "UnitTest");
-      Assert::AreEqual(std::string("UnitTest"), parser.Value("Condor2Nav", "Target"));
-      parser.Value("LK8000", "DefaultTaskOverwrite", "99");
-      Assert::AreEqual(std::string("99"), parser.Value("LK8000", "DefaultTaskOverwrite"));
-      parser.Value("Condor2Nav", "NonExisting", "Test");
-      Assert::AreEqual(std::string("Test"), parser.Value("Condor2Nav", "NonExisting"));
-      parser.Value("", "NonExisting", "Test");
-      Assert::AreEqual(std::string("Test"), parser.Value("", "NonExisting"));
-    }
-
-    TEST_METHOD(InvalidINIValueOverwrite)
-    {
-      CFileParserINI parser(MAIN_SRC_DIR / "data/condor2nav.ini");
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("NonExisting", "DefaultTaskOverwrite", "Fail"); });
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("NonExisting", "", "Fail"); });
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("", "", "Fail"); });
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("", {}, "Fail"); });
-    }
-  };
-
-
-
-  ////////////////////////   F I L E   P A R S E R    C S V   ////////////////////////
-
-  TEST_CLASS(TestFileParserCSV) {
-  public:
-    TEST_METHOD(InvalidCSVFile)
-    {
-      Assert::ExpectException<EOperationFailed>([]{ CFileParserCSV parser("nonexisting.some_file"); });
-    }
-
-    TEST_METHOD(NotACSVFile)
-    {
-      Assert::ExpectException<EOperationFailed>([]{ CFileParserCSV parser(MAIN_SRC_DIR / "data/condor2nav.ini"); });
-    }
-
-    TEST_METHOD(ValidCSVFile)
-    {
-      CFileParserCSV parser(MAIN_SRC_DIR / "data/GliderData.csv");
-      Assert::AreEqual((MAIN_SRC_DIR / "data/GliderData.csv").string(), parser.Path().string());
-      Assert::AreEqual(24U, parser.Rows().size());
-      Assert::AreEqual(14U, parser.Rows()[0].size());
-      Assert::AreEqual(std::string("285"), parser.Row("ASW28")[1]);
-      Assert::AreEqual(std::string("285"), parser.Row("asw28", 0, true)[1]);
-      Assert::AreEqual(std::string("ASW22"), parser.Row("280", 1)[0]);
-    }
-
-    TEST_METHOD(InvalidCSVFileEntry)
-    {
-      CFileParserCSV parser(MAIN_SRC_DIR / "data/GliderData.csv");
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Row("asw28")[1]; });
-      Assert::ExpectException<EOperationFailed>([&]{ parser.Row("123", 1)[0]; });
-    }
-  };
-
-
-
-  ////////////////////////   C O N D O R   ////////////////////////
-
-  TEST_CLASS(TestCondor) {
-  public:
-    TEST_METHOD(InstallPath)
-    {
-      Assert::AreEqual("C:\\Program Files (x86)\\Condor", condor::InstallPath().string().c_str());
-    }
-
-    //TEST_METHOD(FPLPath)
-    //{
-    //  Assert::AreEqual("C:\\Program Files (x86)\\Condor", CCondor::InstallPath().string().c_str());
-    //}
-
-    //TEST_METHOD(TaskParser)
-    //{
-    //  Assert::AreEqual("C:\\Program Files (x86)\\Condor", CCondor::InstallPath().string().c_str());
-    //}
-
-    //TEST_METHOD(CoordConverter)
-    //{
-    //  Assert::AreEqual("C:\\Program Files (x86)\\Condor", CCondor::InstallPath().string().c_str());
-    //}
-
-  };
-
-}
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+* @file unittests.cpp
+*
+* @brief Provides unit tests for Condor2Nav project.
+*/
+
+#include <boost/asio.hpp>   // has to be included before Windows.h
+#include "tools.h"
+#include "activeObject.h"
+#include "archive.h"
+#include "hashTable.h"
+#include "condor.h"
+#include "istream.h"
+#include "ostream.h"
+#include "outputManifest.h"
+#include "vfs.h"
+#include "fileParserCSV.h"
+#include "csvTokenizer.h"
+#include "projectionGrid.h"
+#include "mapIndex.h"
+#include "transfer.h"
+#include "coordCache.h"
+#include "dirSync.h"
+#include "downloader.h"
+#include "httpCache.h"
+#include "naviConWorkers.h"
+#include "fileParserINI.h"
+#include "CppUnitTest.h"
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <thread>
+
+using namespace condor2nav;
+
+template<> static std::wstring Microsoft::VisualStudio::CppUnitTestFramework::ToString<TPathType>(const TPathType& val)
+{
+  switch(val) {
+  case TPathType::LOCAL:       return L"LOCAL";
+  case TPathType::ACTIVE_SYNC: return L"ACTIVE_SYNC";
+  default:                     return L"MEMORY";
+  }
+}
+
+namespace unitTests
+{
+  using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+  const bfs::path MAIN_SRC_DIR = "..";
+
+  /**
+   * @brief Unique temporary directory removed together with its content at the end of a test.
+   */
+  class CTempDir : CNonCopyable {
+    const bfs::path _path;
+
+  public:
+    CTempDir() :
+      _path{bfs::temp_directory_path() / bfs::unique_path()}
+    {
+      bfs::create_directories(_path);
+    }
+
+    ~CTempDir()
+    {
+      boost::system::error_code ec;
+      bfs::remove_all(_path, ec);
+    }
+
+    const bfs::path &Path() const { return _path; }
+  };
+
+  /**
+   * @brief File system backend registered for the scheme only in the scope of a test.
+   */
+  template<typename VFS = CVfsMemory>
+  class CVfsScoped : CNonCopyable {
+    const std::string _scheme;
+    const std::shared_ptr<VFS> _vfs;
+
+  public:
+    explicit CVfsScoped(std::string scheme) :
+      _scheme{std::move(scheme)}, _vfs{std::make_shared<VFS>()}
+    {
+      CVfs::Register(_scheme, _vfs);
+    }
+
+    ~CVfsScoped()
+    {
+      CVfs::Unregister(_scheme);
+    }
+
+    VFS *operator->() const { return _vfs.get(); }
+  };
+
+
+  ////////////////////////   U T I L I T I E S   ////////////////////////
+
+  TEST_CLASS(TestUtilities) {
+  public:
+    TEST_METHOD(ConversionsToText)
+    {
+      Assert::AreEqual(std::string{"0"},      Convert(0));
+      Assert::AreEqual(std::string{"3"},      Convert(3));
+      Assert::AreEqual(std::string{"-123"},   Convert(-123));
+      Assert::AreEqual(std::string{"99.123"}, Convert(99.123));
+    }
+
+    TEST_METHOD(ConversionsFromText)
+    {
+      Assert::AreEqual(0,      Convert<int>("0"));
+      Assert::AreEqual(3,      Convert<int>("3"));
+      Assert::AreEqual(-123,   Convert<int>("-123"));
+      Assert::AreEqual(99.123, Convert<double>("99.123"));
+    }
+
+    TEST_METHOD(ConversionsMatchStreams)
+    {
+      const char *texts[] = { "0", " 12", "-7", "+5", "42abc", "1.5", "-0.25e2", "  3.25 ", "1e5", "", "2.e1", "0x1A" };
+      for(auto text : texts) {
+        std::stringstream intStream{text}, doubleStream{text};
+        int intValue = 0;
+        double doubleValue = 0;
+        intStream >> intValue;
+        doubleStream >> doubleValue;
+        Assert::AreEqual(intValue, Convert<int>(text));
+        Assert::AreEqual(doubleValue, Convert<double>(text));
+      }
+
+      const double values[] = { 0, 1, -1, 0.1, 99.123, 1234567, 0.000012345, -123.456789, 1e20 };
+      for(auto value : values) {
+        std::stringstream stream;
+        stream << value;
+        Assert::AreEqual(stream.str(), Convert(value));
+      }
+      Assert::AreEqual(std::string{"-9223372036854775808"}, Convert(std::numeric_limits<long long>::min()));
+      Assert::AreEqual(std::string{"18446744073709551615"}, Convert(std::numeric_limits<unsigned long long>::max()));
+      Assert::AreEqual(std::string{"a"}, Convert('a'));
+    }
+
+    TEST_METHOD(ConversionsInvalidText)
+    {
+      Assert::ExpectException<EOperationFailed>([]{ Convert<int>("abc"); });
+      Assert::ExpectException<EOperationFailed>([]{ Convert<unsigned>("x1"); });
+      Assert::ExpectException<EOperationFailed>([]{ Convert<double>("abc"); });
+      Assert::ExpectException<EOperationFailed>([]{ Convert<float>(".x"); });
+      Assert::ExpectException<EOperationFailed>([]{ Convert<double>("inf"); });
+      Assert::ExpectException<EOperationFailed>([]{ Convert<double>("-INFINITY"); });
+      Assert::ExpectException<EOperationFailed>([]{ Convert<double>("nan"); });
+      Assert::ExpectException<EOperationFailed>([]{ Convert<double>("1e999"); });
+      Assert::AreEqual(0.0, Convert<double>("0x1A"));
+    }
+
+    TEST_METHOD(ConversionsOverflow)
+    {
+      Assert::IsTrue(Convert<int>("2147483647") == (std::numeric_limits<int>::max)());
+      Assert::IsTrue(Convert<int>("-2147483648") == (std::numeric_limits<int>::min)());
+      Assert::ExpectException<EOperationFailed>([]{ Convert<int>("2147483648"); });
+      Assert::ExpectException<EOperationFailed>([]{ Convert<int>("-2147483649"); });
+      Assert::ExpectException<EOperationFailed>([]{ Convert<unsigned short>("65536"); });
+      Assert::IsTrue(Convert<unsigned>("-1") == (std::numeric_limits<unsigned>::max)());
+      Assert::IsTrue(Convert<long long>("-9223372036854775808") == (std::numeric_limits<long long>::min)());
+      Assert::ExpectException<EOperationFailed>([]{ Convert<long long>("9223372036854775808"); });
+      Assert::IsTrue(Convert<unsigned long long>("18446744073709551615") == (std::numeric_limits<unsigned long long>::max)());
+      Assert::ExpectException<EOperationFailed>([]{ Convert<unsigned long long>("18446744073709551616"); });
+      Assert::ExpectException<EOperationFailed>([]{ Convert<unsigned long long>("99999999999999999999999"); });
+    }
+
+    TEST_METHOD(ConversionsCoordinatesToText)
+    {
+      Assert::AreEqual(std::string{ "00:00.000N"}, Coord2DDMMFF(TLatitude{0}));
+      Assert::AreEqual(std::string{"000:00.000E"}, Coord2DDMMFF(TLongitude{0}));
+      Assert::AreEqual(std::string{ "54:22.000N"}, Coord2DDMMFF(TLatitude{54.366667}));
+      Assert::AreEqual(std::string{"018:38.000E"}, Coord2DDMMFF(TLongitude{18.6333336}));
+      Assert::AreEqual(std::string{ "21:34.767N"}, Coord2DDMMFF(TLatitude{21.5794446}));
+      Assert::AreEqual(std::string{"158:11.833W"}, Coord2DDMMFF(TLongitude{-158.1972226}));
+      Assert::AreEqual(std::string{ "13:09.783S"}, Coord2DDMMFF(TLatitude{-13.163056}));
+      Assert::AreEqual(std::string{"072:32.733W"}, Coord2DDMMFF(TLongitude{-72.545556}));
+
+      Assert::AreEqual(std::string{ "00:00:00N"},  Coord2DDMMSS(TLatitude{0}));
+      Assert::AreEqual(std::string{"000:00:00E"},  Coord2DDMMSS(TLongitude{0}));
+      Assert::AreEqual(std::string{ "54:22:00N"},  Coord2DDMMSS(TLatitude{54.366667}));
+      Assert::AreEqual(std::string{"018:38:00E"},  Coord2DDMMSS(TLongitude{18.6333336}));
+      Assert::AreEqual(std::string{ "21:34:46N"},  Coord2DDMMSS(TLatitude{21.5794446}));
+      Assert::AreEqual(std::string{"158:11:50W"},  Coord2DDMMSS(TLongitude{-158.1972226}));
+      Assert::AreEqual(std::string{ "13:09:47S"},  Coord2DDMMSS(TLatitude{-13.163056}));
+      Assert::AreEqual(std::string{"072:32:44W"},  Coord2DDMMSS(TLongitude{-72.545556}));
+    }
+
+    TEST_METHOD(ConversionsSpeed)
+    {
+      Assert::AreEqual(0,  KmH2MS(0));
+      Assert::AreEqual(20, KmH2MS(72));
+      Assert::AreEqual(28, KmH2MS(100));
+    }
+
+    TEST_METHOD(ConversionsDeg2Rad)
+    {
+      Assert::AreEqual(0.0,         Deg2Rad(0));
+      Assert::AreEqual(0.785398163, Deg2Rad(45),  0.00001);
+      Assert::AreEqual(1.74532925,  Deg2Rad(100), 0.00001);
+    }
+
+    TEST_METHOD(ConversionsRad2Deg)
+    {
+      Assert::AreEqual(0.0,   Rad2Deg(0));
+      Assert::AreEqual(45.0,  Rad2Deg(0.785398163), 0.00001);
+      Assert::AreEqual(100.0, Rad2Deg(1.74532925),  0.00001);
+    }
+
+    TEST_METHOD(PathTypes)
+    {
+      Assert::AreEqual(TPathType::LOCAL, PathType(""));
+      Assert::AreEqual(TPathType::LOCAL, PathType("."));
+      Assert::AreEqual(TPathType::LOCAL, PathType(".."));
+      Assert::AreEqual(TPathType::LOCAL, PathType("dir"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("dir/"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("dir/subdir"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("dir/subdir/"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("../dir/subdir/"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("dir\\"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("dir\\subdir"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("dir\\subdir\\"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("..\\dir\\subdir\\"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("c:\\"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("c:\\dir"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("d:"));
+      Assert::AreEqual(TPathType::LOCAL, PathType("\\\\server\\share"));
+      Assert::AreEqual(TPathType::ACTIVE_SYNC, PathType("\\dir"));
+      Assert::AreEqual(TPathType::MEMORY, PathType("mem://seat1/Condor.tsk"));
+      Assert::AreEqual(TPathType::MEMORY, PathType("MEM://seat1"));
+      Assert::ExpectException<EOperationFailed>([]{ PathType("ftp://server/file"); });
+    }
+
+    TEST_METHOD(FileExistsTest)
+    {
+      Assert::IsTrue(FileExists("UnitTests.dll"));
+      Assert::IsTrue(FileExists("unitTests.DLL"));
+      Assert::IsTrue(FileExists("./UnitTests.dll"));
+      Assert::IsTrue(FileExists(".\\UnitTests.dll"));
+      Assert::IsFalse(FileExists("nonexisting"));
+    }
+
+  };
+
+
+
+  ////////////////////////   A C T I V E   O B J E C T   ////////////////////////
+
+  TEST_CLASS(TestActiveObject) {
+  public:
+    TEST_METHOD(SimpleCommand)
+    {
+      int data = 123;
+      {
+        CActiveObject obj;
+        obj.Send([&]{ data = 234; });
+      }
+      Assert::AreEqual(234, data);
+    }
+  };
+
+
+
+  ////////////////////////   H A S H   T A B L E   ////////////////////////
+
+  TEST_CLASS(TestHashTable) {
+  public:
+    TEST_METHOD(InsertFind)
+    {
+      CHashTable<int> table;
+      Assert::IsTrue(table.Empty());
+      Assert::IsNull(table.Find("key"));
+      Assert::IsTrue(table.Insert("key").second);
+      Assert::IsFalse(table.Insert("key").second);
+      *table.Find("key") = 5;
+      Assert::AreEqual(5, table["key"]);
+      Assert::IsNull(table.Find("Key"));
+      Assert::IsNull(table.Find(""));
+      table[""] = 1;
+      Assert::AreEqual(1, *table.Find(""));
+    }
+
+    TEST_METHOD(Growth)
+    {
+      CHashTable<int> table;
+      std::vector<const int *> refs;
+      for(int i=0; i<1000; i++) {
+        table[Convert(i)] = i;
+        refs.push_back(table.Find(Convert(i)));
+      }
+      Assert::AreEqual(size_t{1000}, table.Size());
+      int i = 0;
+      for(const auto &entry : table) {
+        Assert::AreEqual(Convert(i), entry.key);
+        Assert::AreEqual(i, entry.value);
+        Assert::IsTrue(refs[i] == table.Find(Convert(i)));
+        i++;
+      }
+    }
+
+    TEST_METHOD(XXH64)
+    {
+      auto hash = [](boost::string_ref data){ CHashXXH64 h; h.Update(data); return h.Digest(); };
+      Assert::IsTrue(hash("") == 0xEF46DB3751D8E999ULL);
+      Assert::IsTrue(hash("a") == 0xD24EC4F1A98C6E5BULL);
+      Assert::IsTrue(hash("abc") == 0x44BC2CF5AD770999ULL);
+
+      // result does not depend on the way data is split
+      std::string data;
+      for(int i=0; i<1000; i++)
+        data += Convert(i);
+      const auto expected = hash(data);
+      for(size_t split : { 1, 7, 31, 32, 33, 64, 100 }) {
+        CHashXXH64 h;
+        for(size_t pos=0; pos<data.size(); pos+=split)
+          h.Update(boost::string_ref{data}.substr(pos, split));
+        Assert::IsTrue(expected == h.Digest());
+      }
+    }
+  };
+
+
+
+  ////////////////////////   I S T R E A M   ////////////////////////
+
+  TEST_CLASS(TestIStream) {
+  public:
+    TEST_METHOD(InvalidInput)
+    {
+      Assert::ExpectException<EOperationFailed>([]{ CIStream stream("nonexisting.some_file"); });
+    }
+
+    TEST_METHOD(ValidInput)
+    {
+      CIStream actual(MAIN_SRC_DIR / "README.txt");
+      std::stringstream actualStr;
+      actualStr << actual;
+      bfs::ifstream expected(MAIN_SRC_DIR / "README.txt");
+      std::stringstream expectedStr;
+      expectedStr << expected.rdbuf();
+      Assert::AreEqual(expectedStr.str(), actualStr.str());
+    }
+
+    TEST_METHOD(GetLine)
+    {
+      CIStream stream(MAIN_SRC_DIR / "README.txt");
+      Assert::IsTrue(static_cast<bool>(stream));
+      std::string txt;
+      stream.GetLine(txt);
+      Assert::AreEqual(std::string( "================"), txt);
+      Assert::IsTrue(static_cast<bool>(stream));
+      while(stream)
+        stream.GetLine(txt);
+      Assert::AreEqual(std::string(""), txt);
+      Assert::IsFalse(static_cast<bool>(stream));
+    }
+
+    TEST_METHOD(GetLineView)
+    {
+      CIStream stream(MAIN_SRC_DIR / "README.txt");
+      Assert::AreEqual(static_cast<size_t>(bfs::file_size(MAIN_SRC_DIR / "README.txt")), stream.Data().size());
+      CIStream reference(MAIN_SRC_DIR / "README.txt");
+      boost::string_ref line;
+      std::string txt;
+      size_t lines = 0;
+      while(stream.GetLine(line)) {
+        reference.GetLine(txt);
+        Assert::AreEqual(txt, line.to_string());
+        Assert::IsTrue(line.empty() || line.back() != '\r');
+        Assert::IsTrue(line.data() >= stream.Data().data() && line.data() + line.size() <= stream.Data().data() + stream.Data().size());
+        lines++;
+      }
+      Assert::IsTrue(lines > 0);
+      Assert::IsTrue(line.empty());
+    }
+  };
+
+
+
+  ////////////////////////   O S T R E A M   ////////////////////////
+
+  TEST_CLASS(TestOStream) {
+    static std::string FileRead(const bfs::path &path)
+    {
+      bfs::ifstream file(path, std::ios_base::binary);
+      std::stringstream str;
+      str << file.rdbuf();
+      return str.str();
+    }
+
+  public:
+    TEST_METHOD(Formatting)
+    {
+      const bfs::path path = bfs::temp_directory_path() / bfs::unique_path();
+      {
+        COStream stream(path);
+        stream << "Task" << 1 << ' ' << 2.5 << std::endl;
+      }
+      Assert::AreEqual(std::string("Task1 2.5\n"), FileRead(path));
+      bfs::remove(path);
+    }
+
+    TEST_METHOD(MultipleChunks)
+    {
+      const bfs::path path = bfs::temp_directory_path() / bfs::unique_path();
+      std::string expected;
+      for(unsigned i=0; expected.size() < 3 * COStream::CHUNK_SIZE; i++)
+        expected += "Waypoint " + Convert(i) + "\n";
+      std::string block(COStream::CHUNK_SIZE + 7, 'x');
+      expected += block;
+      {
+        COStream stream(path);
+        size_t pos = 0;
+        for(unsigned i=0; pos < expected.size() - block.size(); i++) {
+          const std::string line = "Waypoint " + Convert(i) + "\n";
+          stream << line;
+          pos += line.size();
+        }
+        stream.Write(block.data(), block.size());
+      }
+      Assert::AreEqual(expected.size(), static_cast<size_t>(bfs::file_size(path)));
+      Assert::IsTrue(expected == FileRead(path));
+      bfs::remove(path);
+    }
+
+    TEST_METHOD(MultipleDestinations)
+    {
+      const COStream::CPathList paths = {
+        bfs::temp_directory_path() / bfs::unique_path(),
+        bfs::temp_directory_path() / bfs::unique_path(),
+        bfs::temp_directory_path() / bfs::unique_path()
+      };
+      const std::string expected(2 * COStream::CHUNK_SIZE + 123, 'c');
+      {
+        COStream stream(paths);
+        stream << expected;
+      }
+      for(auto &path : paths) {
+        Assert::IsTrue(expected == FileRead(path));
+        bfs::remove(path);
+      }
+    }
+
+    TEST_METHOD(Empty)
+    {
+      const bfs::path path = bfs::temp_directory_path() / bfs::unique_path();
+      {
+        COStream stream(path);
+      }
+      Assert::IsFalse(bfs::exists(path));
+    }
+
+    TEST_METHOD(Transaction)
+    {
+      const bfs::path dir = bfs::temp_directory_path() / bfs::unique_path();
+      bfs::create_directories(dir);
+      {
+        COStream stream(dir / "Default.tsk");
+        stream << "old";
+      }
+      {
+        COStream::CTransaction transaction;
+        Assert::IsTrue(COStream::CTransaction::Current() == &transaction);
+        {
+          COStream stream(COStream::CPathList{ dir / "Default.tsk", dir / "Condor.tsk" });
+          stream << "task";
+        }
+        {
+          COStream stream(dir / "Condor.dat");
+          stream << "line1\n";
+        }
+        {
+          COStream stream(dir / "Condor.dat");
+          stream << "line2\n";
+        }
+        Assert::AreEqual(size_t{3}, transaction.Size());
+        Assert::IsFalse(bfs::exists(dir / "Condor.dat"));
+        Assert::AreEqual(std::string("old"), FileRead(dir / "Default.tsk"));
+        transaction.Commit();
+        Assert::AreEqual(size_t{0}, transaction.Size());
+      }
+      Assert::IsNull(COStream::CTransaction::Current());
+      Assert::AreEqual(std::string("task"), FileRead(dir / "Default.tsk"));
+      Assert::AreEqual(std::string("task"), FileRead(dir / "Condor.tsk"));
+      Assert::AreEqual(std::string("line1\nline2\n"), FileRead(dir / "Condor.dat"));
+      Assert::AreEqual(3, static_cast<int>(std::distance(bfs::directory_iterator(dir), bfs::directory_iterator())));
+      bfs::remove_all(dir);
+    }
+
+    TEST_METHOD(TransactionRollback)
+    {
+      const bfs::path dir = bfs::temp_directory_path() / bfs::unique_path();
+      bfs::create_directories(dir);
+      {
+        COStream::CTransaction transaction;
+        COStream stream(dir / "Condor.tsk");
+        stream << "task";
+      }
+      Assert::IsFalse(bfs::exists(dir / "Condor.tsk"));
+      {
+        COStream::CTransaction transaction;
+        {
+          COStream stream(dir / "Condor.tsk");
+          stream << "task";
+        }
+        {
+          COStream stream(dir / "missing" / "Condor.dat");
+          stream << "line";
+        }
+        Assert::ExpectException<EOperationFailed>([&]{ transaction.Commit(); });
+      }
+      Assert::IsFalse(bfs::exists(dir / "Condor.tsk"));
+      Assert::IsTrue(bfs::is_empty(dir));
+      bfs::remove_all(dir);
+    }
+
+    TEST_METHOD(TransactionReplaceFailure)
+    {
+      /**
+       * @brief In-memory file system failing to replace one file.
+       */
+      class CVfsReplaceFail : public CVfsMemory {
+      public:
+        void Replace(const bfs::path &src, const bfs::path &dest) override
+        {
+          if(dest.filename() == "Default.tsk")
+            throw EOperationFailed{"ERROR: Couldn't replace '" + dest.string() + "'!!!"};
+          CVfsMemory::Replace(src, dest);
+        }
+
+        void Replace(const bfs::path &src, const bfs::path &dest, const bfs::path &backup) override
+        {
+          if(dest.filename() == "Default.tsk")
+            throw EOperationFailed{"ERROR: Couldn't replace '" + dest.string() + "'!!!"};
+          CVfsMemory::Replace(src, dest, backup);
+        }
+      };
+
+      const CVfsScoped<CVfsReplaceFail> vfs{"fail"};
+      const bfs::path dir = "fail://seat1";
+      vfs->Write(dir / "Condor.dat", { "old" });
+      vfs->Write(dir / "Default.tsk", { "old" });
+      {
+        COStream::CTransaction transaction;
+        {
+          COStream stream(COStream::CPathList{ dir / "Condor.dat", dir / "Condor.tsk", dir / "Default.tsk" });
+          stream << "new";
+        }
+        Assert::ExpectException<EOperationFailed>([&]{ transaction.Commit(); });
+      }
+      // files replaced before the failure are restored
+      Assert::AreEqual(std::string("old"), vfs->Read(dir / "Condor.dat"));
+      Assert::AreEqual(std::string("old"), vfs->Read(dir / "Default.tsk"));
+      Assert::IsFalse(vfs->Exists(dir / "Condor.tsk"));
+      Assert::AreEqual(size_t{2}, vfs->List(dir).size());
+    }
+
+    TEST_METHOD(TransactionThread)
+    {
+      const bfs::path path = bfs::temp_directory_path() / bfs::unique_path();
+      {
+        COStream::CTransaction transaction;
+        std::thread worker{[&]{
+          Assert::IsNull(COStream::CTransaction::Current());
+          COStream stream(path);
+          stream << "worker";
+        }};
+        worker.join();
+        Assert::AreEqual(size_t{0}, transaction.Size());
+      }
+      Assert::AreEqual(std::string("worker"), FileRead(path));
+      bfs::remove(path);
+    }
+
+    TEST_METHOD(UnchangedSkipped)
+    {
+      const bfs::path path = bfs::temp_directory_path() / bfs::unique_path();
+      auto &manifest = COutputManifest::Instance();
+      manifest.StatsReset();
+      {
+        COStream stream(path);
+        stream << "Condor2Nav";
+      }
+      const auto time = bfs::last_write_time(path) - 100;
+      bfs::last_write_time(path, time);
+      {
+        // file modified externally
+        COStream stream(path);
+        stream << "Condor2Nav";
+      }
+      Assert::AreEqual(2U, manifest.Stats().filesWritten);
+      Assert::AreEqual(0U, manifest.Stats().filesSkipped);
+      {
+        COStream stream(path);
+        stream << "Condor2Nav";
+      }
+      Assert::AreEqual(2U, manifest.Stats().filesWritten);
+      Assert::AreEqual(1U, manifest.Stats().filesSkipped);
+      Assert::IsTrue(uint64_t{10} == manifest.Stats().bytesSkipped);
+      {
+        COStream stream(path);
+        stream << "Condor2Nav!";
+      }
+      Assert::AreEqual(3U, manifest.Stats().filesWritten);
+      Assert::AreEqual(std::string("Condor2Nav!"), FileRead(path));
+      bfs::remove(path);
+      {
+        COStream stream(path);
+        stream << "Condor2Nav!";
+      }
+      Assert::AreEqual(4U, manifest.Stats().filesWritten);
+      Assert::IsTrue(bfs::exists(path));
+      bfs::remove(path);
+    }
+
+    TEST_METHOD(ManifestPersistence)
+    {
+      const bfs::path manifestPath = bfs::temp_directory_path() / bfs::unique_path() / "Outputs.manifest";
+      const bfs::path path = bfs::temp_directory_path() / bfs::unique_path();
+      {
+        COStream stream(path);
+        stream << "data";
+      }
+      const std::vector<boost::string_ref> buffers = { "data" };
+      const auto hash = COutputManifest::Hash(buffers);
+      {
+        COutputManifest manifest{manifestPath};
+        Assert::IsFalse(manifest.Unchanged(CVfs::Instance(path), path, 4, hash));
+        manifest.Written(CVfs::Instance(path), path, 4, hash);
+        manifest.Save();
+      }
+      {
+        COutputManifest manifest{manifestPath};
+        auto &vfs = CVfs::Instance(path);
+        Assert::IsTrue(manifest.Unchanged(vfs, path, 4, hash));
+        Assert::IsFalse(manifest.Unchanged(vfs, path, 4, hash + 1));
+        Assert::IsFalse(manifest.Unchanged(vfs, path, 4, hash));
+      }
+      bfs::remove_all(manifestPath.parent_path());
+      bfs::remove(path);
+    }
+  };
+
+
+
+  ////////////////////////   V F S   ////////////////////////
+
+  TEST_CLASS(TestVfs) {
+  public:
+    TEST_METHOD(Schemes)
+    {
+      Assert::AreEqual(std::string(CVfs::SCHEME_LOCAL), CVfs::Scheme("c:\\dir"));
+      Assert::AreEqual(std::string(CVfs::SCHEME_LOCAL), CVfs::Scheme("dir/file"));
+      Assert::AreEqual(std::string(CVfs::SCHEME_ACTIVE_SYNC), CVfs::Scheme("\\My Documents"));
+      Assert::AreEqual(std::string(CVfs::SCHEME_MEMORY), CVfs::Scheme("mem://seat1/Condor.tsk"));
+      Assert::AreEqual(std::string("ftp"), CVfs::Scheme("ftp://server/file"));
+    }
+
+    TEST_METHOD(MemoryFiles)
+    {
+      const bfs::path dir = "mem://" + bfs::unique_path().string();
+      Assert::IsFalse(FileExists(dir / "Condor2Nav"));
+      DirectoryCreate(dir / "Condor2Nav" / "Tasks");
+      Assert::IsTrue(FileExists(dir / "Condor2Nav"));
+      Assert::IsTrue(FileExists(dir / "Condor2Nav" / "Tasks"));
+
+      const std::string data(COStream::CHUNK_SIZE + 10, 'm');
+      {
+        COStream stream(dir / "Condor2Nav" / "Condor.dat");
+        stream << data;
+      }
+      Assert::IsTrue(FileExists(dir / "Condor2Nav" / "Condor.dat"));
+      Assert::IsFalse(bfs::exists(dir / "Condor2Nav" / "Condor.dat"));
+      CIStream stream(dir / "Condor2Nav" / "Condor.dat");
+      Assert::IsTrue(data == stream.Data());
+
+      auto &vfs = CVfs::Instance(dir);
+      CVfs::TStat stat;
+      Assert::IsTrue(vfs.Stat(dir / "Condor2Nav" / "Condor.dat", stat));
+      Assert::IsTrue(data.size() == stat.size);
+      Assert::IsFalse(stat.directory);
+      Assert::IsTrue(vfs.Stat(dir / "Condor2Nav", stat));
+      Assert::IsTrue(stat.directory);
+
+      auto entries = vfs.List(dir / "Condor2Nav");
+      std::sort(entries.begin(), entries.end());
+      Assert::AreEqual(size_t{2}, entries.size());
+      Assert::IsTrue(entries[0] == dir / "Condor2Nav" / "Condor.dat");
+      Assert::IsTrue(entries[1] == dir / "Condor2Nav" / "Tasks");
+
+      Assert::IsTrue(vfs.Remove(dir / "Condor2Nav" / "Condor.dat"));
+      Assert::IsFalse(vfs.Remove(dir / "Condor2Nav" / "Condor.dat"));
+      Assert::ExpectException<EOperationFailed>([&]{ CIStream stream(dir / "Condor2Nav" / "Condor.dat"); });
+    }
+
+    TEST_METHOD(LocalReplaceBackup)
+    {
+      const CTempDir temp;
+      const bfs::path &dir = temp.Path();
+      auto &vfs = CVfs::Instance(dir);
+      vfs.Write(dir / "Condor.tsk", { "old" });
+      vfs.Write(dir / "Condor.tsk.tmp", { "new" });
+      vfs.Replace(dir / "Condor.tsk.tmp", dir / "Condor.tsk", dir / "Condor.tsk.bak");
+      Assert::AreEqual(std::string("new"), vfs.Read(dir / "Condor.tsk"));
+      Assert::AreEqual(std::string("old"), vfs.Read(dir / "Condor.tsk.bak"));
+      Assert::IsFalse(vfs.Exists(dir / "Condor.tsk.tmp"));
+
+      // missing replacement keeps the file
+      Assert::ExpectException<EOperationFailed>([&]{ vfs.Replace(dir / "Condor.tsk.tmp", dir / "Condor.tsk", dir / "Condor.tsk.bak"); });
+      Assert::AreEqual(std::string("new"), vfs.Read(dir / "Condor.tsk"));
+    }
+
+    TEST_METHOD(SchemeUnregister)
+    {
+      {
+        const CVfsScoped<> vfs{"scoped"};
+        Assert::IsTrue(CVfs::Instance("scoped://seat1/Condor.tsk").Type() == TPathType::MEMORY);
+      }
+      Assert::ExpectException<EOperationFailed>([]{ CVfs::Instance("scoped://seat1/Condor.tsk"); });
+    }
+
+    TEST_METHOD(MemoryTranslationOutputs)
+    {
+      const CVfsScoped<> vfs{"test"};
+      const bfs::path dir = "test://seat1";
+      {
+        COStream::CTransaction transaction;
+        {
+          CFileParserINI profile(MAIN_SRC_DIR / "data" / "condor2nav.ini");
+          profile.Dump(dir / "Condor.prf");
+        }
+        {
+          COStream stream(COStream::CPathList{ dir / "Condor.tsk", dir / "Default.tsk" });
+          stream << "task";
+        }
+        transaction.Commit();
+      }
+      Assert::AreEqual(std::string("task"), vfs->Read(dir / "Default.tsk"));
+      CFileParserINI profile(dir / "Condor.prf");
+      CFileParserINI expected(MAIN_SRC_DIR / "data" / "condor2nav.ini");
+      Assert::AreEqual(expected.Value("Condor2Nav", "Target"), profile.Value("Condor2Nav", "Target"));
+      Assert::AreEqual(size_t{3}, vfs->List(dir).size());
+      vfs->Clear();
+      Assert::IsFalse(FileExists(dir / "Condor.tsk"));
+    }
+  };
+
+
+
+  ////////////////////////   A R C H I V E   ////////////////////////
+
+  TEST_CLASS(TestArchive) {
+    static uint32_t Get32(boost::string_ref data, size_t pos)
+    {
+      return static_cast<unsigned char>(data[pos]) | static_cast<unsigned char>(data[pos + 1]) << 8 |
+             static_cast<unsigned char>(data[pos + 2]) << 16 | static_cast<uint32_t>(static_cast<unsigned char>(data[pos + 3])) << 24;
+    }
+
+  public:
+    TEST_METHOD(Formats)
+    {
+      Assert::IsTrue(CArchive::TFormat::ZIP == CArchive::Format("outputs/Condor2Nav.ZIP"));
+      Assert::IsTrue(CArchive::TFormat::TAR == CArchive::Format("Condor2Nav.tar"));
+      Assert::ExpectException<EOperationFailed>([]{ CArchive::Format("Condor2Nav.rar"); });
+      Assert::IsTrue(0xCBF43926U == CArchive::Crc32({ "1234", "56789" }));
+    }
+
+    TEST_METHOD(ZipLocalTime)
+    {
+      const std::time_t time = 1234567890;
+      CArchive archive{CArchive::TFormat::ZIP, time};
+      archive.Add("Condor.tsk", { "task" });
+      std::string zip;
+      for(auto &buffer : archive.Buffers())
+        zip.append(buffer.data(), buffer.size());
+
+      // MS-DOS date and time of the first local header
+      std::tm tm;
+      Assert::AreEqual(0, static_cast<int>(localtime_s(&tm, &time)));
+      const uint32_t dosDateTime = Get32(zip, 10);
+      Assert::AreEqual(static_cast<uint32_t>((tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2)), dosDateTime & 0xFFFF);
+      Assert::AreEqual(static_cast<uint32_t>(((tm.tm_year - 80) << 9) | ((tm.tm_mon + 1) << 5) | tm.tm_mday), dosDateTime >> 16);
+    }
+
+    TEST_METHOD(TransactionZip)
+    {
+      const CVfsScoped<> vfs{"test"};
+      {
+        COStream::CTransaction transaction;
+        {
+          COStream stream(COStream::CPathList{ "test://seat1/Condor.tsk", "test://seat1/Default.tsk" });
+          stream << "task";
+        }
+        {
+          COStream stream("test://seat1/Polars/Condor.plr");
+          stream << "polar";
+        }
+        transaction.Commit("test://Condor2Nav.zip", "test://seat1");
+      }
+      Assert::IsFalse(FileExists("test://seat1/Condor.tsk"));
+      const std::string zip = vfs->Read("test://Condor2Nav.zip");
+
+      // end of central directory
+      const size_t eocd = zip.size() - 22;
+      Assert::IsTrue(0x06054B50U == Get32(zip, eocd));
+      Assert::AreEqual(3U, Get32(zip, eocd + 8) & 0xFFFF);
+      const uint32_t dirSize = Get32(zip, eocd + 12);
+      const uint32_t dirOffset = Get32(zip, eocd + 16);
+      Assert::IsTrue(dirOffset + dirSize == eocd);
+
+      // entries in the order of paths
+      std::vector<std::string> names;
+      for(size_t pos = dirOffset; pos < eocd; ) {
+        Assert::IsTrue(0x02014B50U == Get32(zip, pos));
+        const size_t nameSize = Get32(zip, pos + 28) & 0xFFFF;
+        const std::string name = zip.substr(pos + 46, nameSize);
+        names.push_back(name);
+
+        // local header
+        const size_t local = Get32(zip, pos + 42);
+        Assert::IsTrue(0x04034B50U == Get32(zip, local));
+        Assert::AreEqual(name, zip.substr(local + 30, nameSize));
+        const uint32_t size = Get32(zip, local + 18);
+        const std::string data = zip.substr(local + 30 + nameSize, size);
+        Assert::AreEqual(Get32(zip, pos + 16), CArchive::Crc32({ data }));
+        Assert::AreEqual(std::string(name == "Polars/Condor.plr" ? "polar" : "task"), data);
+        pos += 46 + nameSize;
+      }
+      const std::vector<std::string> expected = { "Condor.tsk", "Default.tsk", "Polars/Condor.plr" };
+      Assert::IsTrue(expected == names);
+    }
+
+    TEST_METHOD(Tar)
+    {
+      const std::string data(1000, 't');
+      CArchive archive{CArchive::TFormat::TAR, 1234567890};
+      archive.Add("Condor2Nav/Condor.dat", { data });
+      archive.Add(std::string(120, 'd') + "/Condor.txt", { "abc" });
+      std::string tar;
+      for(auto &buffer : archive.Buffers())
+        tar.append(buffer.data(), buffer.size());
+
+      Assert::AreEqual(size_t{512 + 1024 + 512 + 512 + 1024}, tar.size());
+      Assert::AreEqual(std::string("Condor2Nav/Condor.dat"), std::string(tar.c_str()));
+      Assert::AreEqual(std::string("ustar"), std::string(tar.c_str() + 257));
+      Assert::AreEqual(std::string("00000001750"), std::string(tar.c_str() + 124));
+      unsigned checksum = 0;
+      for(size_t i=0; i<512; i++)
+        checksum += i >= 148 && i < 156 ? ' ' : static_cast<unsigned char>(tar[i]);
+      Assert::AreEqual(checksum, static_cast<unsigned>(std::stoul(std::string(tar.c_str() + 148), nullptr, 8)));
+      Assert::IsTrue(data == tar.substr(512, data.size()));
+
+      // long name split into prefix and name
+      const size_t second = 512 + 1024;
+      Assert::AreEqual(std::string("Condor.txt"), std::string(tar.c_str() + second));
+      Assert::AreEqual(std::string(120, 'd'), std::string(tar.c_str() + second + 345));
+      Assert::AreEqual(std::string("abc"), tar.substr(second + 512, 3));
+    }
+  };
+
+
+
+  ////////////////////////   T R A N S F E R   ////////////////////////
+
+  class CTestLogger : public CCondor2Nav::CLogger {
+    void Trace(const std::string &str) const override { text += str; }
+  public:
+    mutable std::string text;
+    CTestLogger() : CLogger{TType::LOG_NORMAL} {}
+  };
+
+
+  TEST_CLASS(TestTransfer) {
+    /**
+     * @brief Transmissions in progress on all the links sharing it.
+     */
+    struct TActivity {
+      std::atomic<unsigned> active;         // the number of links transmitting now
+      std::atomic<bool> overlapped;         // true if two links transmitted at once
+      TActivity() : active{0}, overlapped{false} {}
+    };
+
+    /**
+     * @brief Stand-in transport link with a constant latency and bandwidth.
+     */
+    class CLink {
+      std::chrono::microseconds _latency;
+      unsigned _bandwidth;                  // bytes per second
+      TActivity *_activity;
+    public:
+      CLink(std::chrono::microseconds latency, unsigned bandwidth, TActivity *activity = nullptr) :
+        _latency(latency), _bandwidth{bandwidth}, _activity{activity} {}
+      void Transmit(size_t size) const
+      {
+        if(_activity && ++_activity->active > 1)
+          _activity->overlapped = true;
+        std::this_thread::sleep_for(_latency + std::chrono::microseconds{size * 1000000ULL / _bandwidth});
+        if(_activity)
+          --_activity->active;
+      }
+    };
+
+    class CLinkSource : public CTransfer::CSource {
+      const std::string &_data;
+      const CLink _link;
+      size_t _pos;
+      size_t _failAt;
+    public:
+      CLinkSource(const std::string &data, CLink link, size_t failAt = std::string::npos) :
+        _data(data), _link(link), _pos{0}, _failAt{failAt} {}
+      uint64_t Size() const override { return _data.size(); }
+      size_t Read(char *buffer, size_t size) override
+      {
+        if(_pos >= _failAt)
+          throw EOperationFailed{"ERROR: Link broken!!!"};
+        size = std::min(size, _data.size() - _pos);
+        _link.Transmit(size);
+        std::copy_n(_data.data() + _pos, size, buffer);
+        _pos += size;
+        return size;
+      }
+    };
+
+    class CLinkSink : public CTransfer::CSink {
+      const CLink _link;
+      size_t _failAt;
+    public:
+      std::string data;
+      unsigned writes;
+      explicit CLinkSink(CLink link, size_t failAt = std::string::npos) : _link(link), _failAt{failAt}, writes{0} {}
+      void Write(const char *buffer, size_t size) override
+      {
+        if(data.size() >= _failAt)
+          throw EOperationFailed{"ERROR: Link broken!!!"};
+        _link.Transmit(size);
+        data.append(buffer, size);
+        writes++;
+      }
+    };
+
+    static std::string Data(size_t size)
+    {
+      std::string data(size, 0);
+      for(size_t i=0; i<size; i++)
+        data[i] = static_cast<char>(i * 7 + i / 256);
+      return data;
+    }
+
+  public:
+    TEST_METHOD(Chunks)
+    {
+      const CLink fast{std::chrono::microseconds{0}, 1000000000};
+      CTransfer transfer{1024};
+      for(size_t size : { 0, 1, 1023, 1024, 3 * 1024 + 5 }) {
+        for(bool overlap : { true, false }) {
+          const std::string data = Data(size);
+          CLinkSource source{data, fast};
+          CLinkSink sink{fast};
+          uint64_t last = 0;
+          unsigned calls = 0;
+          const auto done = transfer.Run(source, sink, [&](uint64_t done, uint64_t total) {
+            Assert::IsTrue(done > last);
+            Assert::IsTrue(total == size);
+            last = done;
+            calls++;
+          }, overlap);
+          Assert::IsTrue(done == size);
+          Assert::IsTrue(data == sink.data);
+          Assert::AreEqual(static_cast<unsigned>((size + 1023) / 1024), sink.writes);
+          Assert::AreEqual(sink.writes, calls);
+          Assert::IsTrue(last == size);
+        }
+      }
+    }
+
+    TEST_METHOD(Overlap)
+    {
+      // ~20ms to read and ~20ms to write every chunk
+      const std::string data = Data(10 * 16 * 1024);
+      CTransfer transfer{16 * 1024};
+      for(bool overlap : { false, true }) {
+        TActivity activity;
+        const CLink disk{std::chrono::milliseconds{20}, 1000000000, &activity};
+        const CLink link{std::chrono::milliseconds{4}, 1000000, &activity};
+        CLinkSource source{data, disk};
+        CLinkSink sink{link};
+        transfer.Run(source, sink, CTransfer::FProgress(), overlap);
+        Assert::IsTrue(data == sink.data);
+        Assert::IsTrue(overlap == activity.overlapped);
+      }
+    }
+
+    TEST_METHOD(Errors)
+    {
+      const CLink fast{std::chrono::microseconds{0}, 1000000000};
+      const std::string data = Data(8 * 1024);
+      CTransfer transfer{1024};
+      for(bool overlap : { true, false }) {
+        Assert::ExpectException<EOperationFailed>([&]{
+          CLinkSource source{data, fast, 3 * 1024};
+          CLinkSink sink{fast};
+          transfer.Run(source, sink, CTransfer::FProgress(), overlap);
+        });
+        Assert::ExpectException<EOperationFailed>([&]{
+          CLinkSource source{data, fast};
+          CLinkSink sink{fast, 5 * 1024};
+          transfer.Run(source, sink, CTransfer::FProgress(), overlap);
+        });
+      }
+
+      // buffers are still usable
+      CLinkSource source{data, fast};
+      CLinkSink sink{fast};
+      transfer.Run(source, sink);
+      Assert::IsTrue(data == sink.data);
+    }
+
+    TEST_METHOD(ProgressLog)
+    {
+      const CLink fast{std::chrono::microseconds{0}, 1000000000};
+      const std::string data = Data(8 * 1024);
+      CTransfer transfer{1024};
+      CTestLogger log;
+      CLinkSource source{data, fast};
+      CLinkSink sink{fast};
+      transfer.Run(source, sink, CTransfer::ProgressLog(log, "Map.LKM", 25));
+      Assert::AreEqual(std::string("Map.LKM: 25% (2048 / 8192 bytes)\n"
+                                   "Map.LKM: 50% (4096 / 8192 bytes)\n"
+                                   "Map.LKM: 75% (6144 / 8192 bytes)\n"
+                                   "Map.LKM: 100% (8192 / 8192 bytes)\n"), log.text);
+    }
+
+    TEST_METHOD(FileToFile)
+    {
+      const bfs::path srcPath = "transferSrc.tmp";
+      const bfs::path destPath = "transferDest.tmp";
+      const std::string data = Data(100 * 1024 + 17);
+      {
+        bfs::ofstream stream{srcPath, std::ios_base::out | std::ios_base::binary};
+        stream.write(data.data(), data.size());
+      }
+      {
+        CTransfer transfer;
+        CTransfer::CFileSource source{srcPath};
+        CTransfer::CFileSink sink{destPath};
+        Assert::IsTrue(source.Size() == data.size());
+        Assert::IsTrue(transfer.Run(source, sink) == data.size());
+      }
+      bfs::ifstream stream{destPath, std::ios_base::in | std::ios_base::binary};
+      const std::string result{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+      stream.close();
+      Assert::IsTrue(data == result);
+      bfs::remove(srcPath);
+      bfs::remove(destPath);
+      Assert::ExpectException<EOperationFailed>([&]{ CTransfer::CFileSource source{srcPath}; });
+    }
+  };
+
+
+
+  ////////////////////////   D I R   S Y N C   ////////////////////////
+
+  TEST_CLASS(TestDirSync) {
+    const bfs::path SRC_DIR = "dirSyncSrc";
+
+    void FileWrite(const std::string &name, const std::string &data)
+    {
+      bfs::ofstream stream{SRC_DIR / name, std::ios_base::out | std::ios_base::binary};
+      stream.write(data.data(), data.size());
+    }
+
+    void SrcDirCreate()
+    {
+      bfs::remove_all(SRC_DIR);
+      bfs::remove(CDirSync::SourceManifestPath(SRC_DIR));
+      bfs::create_directories(SRC_DIR);
+    }
+
+  public:
+    TEST_METHOD(Delta)
+    {
+      SrcDirCreate();
+      const CVfsScoped<> vfs{"test"};
+      const bfs::path destDir = "test://LK8000/_Maps/condor2nav";
+      FileWrite("Alps.LKM", std::string(100000, 'm'));
+      FileWrite("Alps_250.DEM", std::string(300000, 'd'));
+      FileWrite("Small.LKM", "small");
+
+      CTestLogger log;
+      CDirSync sync{log};
+      auto stats = sync.Run(SRC_DIR, destDir);
+      Assert::AreEqual(3U, stats.filesCopied);
+      Assert::IsTrue(stats.bytesCopied == 400005);
+      Assert::AreEqual(0U, stats.filesSkipped);
+      Assert::IsTrue(std::string(300000, 'd') == vfs->Read(destDir / "Alps_250.DEM"));
+      Assert::IsFalse(bfs::exists(SRC_DIR / CDirSync::MANIFEST_NAME));
+      Assert::IsTrue(bfs::exists(CDirSync::SourceManifestPath(SRC_DIR)));
+      Assert::IsTrue(vfs->Exists(destDir / CDirSync::MANIFEST_NAME));
+
+      // nothing changed
+      stats = sync.Run(SRC_DIR, destDir);
+      Assert::AreEqual(0U, stats.filesCopied);
+      Assert::AreEqual(3U, stats.filesSkipped);
+      Assert::IsTrue(stats.bytesSaved == 400005);
+
+      // changed source, new source and target files modified or removed outside
+      FileWrite("Small.LKM", "changed");
+      FileWrite("New.LKM", "new");
+      vfs->Write(destDir / "Alps.LKM", { "broken" });
+      vfs->Remove(destDir / "Alps_250.DEM");
+      stats = sync.Run(SRC_DIR, destDir);
+      Assert::AreEqual(4U, stats.filesCopied);
+      Assert::AreEqual(0U, stats.filesSkipped);
+      Assert::AreEqual(std::string("changed"), vfs->Read(destDir / "Small.LKM"));
+      Assert::AreEqual(std::string("new"), vfs->Read(destDir / "New.LKM"));
+      Assert::IsTrue(std::string(100000, 'm') == vfs->Read(destDir / "Alps.LKM"));
+
+      stats = sync.Run(SRC_DIR, destDir);
+      Assert::AreEqual(0U, stats.filesCopied);
+      Assert::AreEqual(4U, stats.filesSkipped);
+      bfs::remove_all(SRC_DIR);
+    }
+
+    TEST_METHOD(RollingChecksumCollision)
+    {
+      SrcDirCreate();
+      const CVfsScoped<> vfs{"test"};
+      const bfs::path destDir = "test://LK8000/Waypoints";
+      FileWrite("Alps.cup", "bbbb");
+      CTestLogger log;
+      auto stats = CDirSync{log}.Run(SRC_DIR, destDir);
+      Assert::AreEqual(1U, stats.filesCopied);
+
+      // the same size and rsync weak checksum
+      auto weak = [](boost::string_ref data) -> uint32_t {
+        uint32_t a = 0, b = 0;
+        for(auto c : data) {
+          a += static_cast<unsigned char>(c);
+          b += a;
+        }
+        return (a & 0xFFFF) | (b << 16);
+      };
+      Assert::AreEqual(weak("bbbb"), weak("caac"));
+      const auto time = bfs::last_write_time(SRC_DIR / "Alps.cup");
+      FileWrite("Alps.cup", "caac");
+      bfs::last_write_time(SRC_DIR / "Alps.cup", time + 10);
+      stats = CDirSync{log}.Run(SRC_DIR, destDir);
+      Assert::AreEqual(1U, stats.filesCopied);
+      Assert::AreEqual(std::string("caac"), vfs->Read(destDir / "Alps.cup"));
+      bfs::remove_all(SRC_DIR);
+    }
+
+    TEST_METHOD(LocalParallel)
+    {
+      SrcDirCreate();
+      const bfs::path destDir = "dirSyncDest";
+      bfs::remove_all(destDir);
+      bfs::create_directories(destDir);
+      for(int i=0; i<20; i++)
+        FileWrite("Map" + Convert(i) + ".DEM", std::string(10000 + i, static_cast<char>('a' + i)));
+
+      CTestLogger log;
+      auto stats = CDirSync{log}.Run(SRC_DIR, destDir);
+      Assert::AreEqual(20U, stats.filesCopied);
+      for(int i=0; i<20; i++) {
+        bfs::ifstream stream{destDir / ("Map" + Convert(i) + ".DEM"), std::ios_base::in | std::ios_base::binary};
+        const std::string data{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+        Assert::IsTrue(std::string(10000 + i, static_cast<char>('a' + i)) == data);
+      }
+
+      stats = CDirSync{log}.Run(SRC_DIR, destDir);
+      Assert::AreEqual(0U, stats.filesCopied);
+      Assert::AreEqual(20U, stats.filesSkipped);
+      bfs::remove_all(destDir);
+      bfs::remove_all(SRC_DIR);
+    }
+
+    TEST_METHOD(MissingTarget)
+    {
+      SrcDirCreate();
+      FileWrite("Alps.LKM", "map");
+      CTestLogger log;
+      Assert::ExpectException<EOperationFailed>([&]{ CDirSync{log}.Run(SRC_DIR, "dirSyncMissing/_Maps"); });
+      bfs::remove_all(SRC_DIR);
+    }
+  };
+
+
+
+  ////////////////////////   D O W N L O A D E R   ////////////////////////
+
+  /**
+   * @brief Stand-in HTTP/1.1 server listening on a local port.
+   *
+   * Every connection is served by a separate thread and kept alive unless
+   * the client asks to close it. Resources may respond with a delay, with
+   * a number of server errors before the real response, with chunked body
+   * and may drop the connection in the middle of the body once.
+   */
+  class CHttpServer {
+  public:
+    struct TResource {
+      std::string body;
+      unsigned failures;                    // the number of 503 responses before 200
+      unsigned delay;                       // response delay in milliseconds
+      bool chunked;                         // chunked transfer encoding
+      size_t dropAt;                        // the number of body bytes sent before the connection is dropped
+      std::string etag;                     // entity tag (validators are not sent if empty)
+    };
+
+  private:
+    boost::asio::io_service _io;
+    boost::asio::ip::tcp::acceptor _acceptor;
+    std::thread _thread;
+    std::vector<std::thread> _connections;
+    mutable std::mutex _mutex;
+    std::atomic<bool> _stop;
+    std::map<std::string, TResource> _resources;
+    std::map<std::string, unsigned> _requests;
+    std::map<std::string, std::vector<uint64_t>> _ranges;
+    std::map<std::string, unsigned> _notModified;
+    unsigned _accepted;
+    unsigned _open;
+    unsigned _maxConnections;
+
+    std::string Response(const std::string &url, uint64_t offset, const std::string &ifNoneMatch, const std::string &ifRange, unsigned &delay, size_t &dropAt)
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      _requests[url]++;
+      if(offset)
+        _ranges[url].push_back(offset);
+      auto it = _resources.find(url);
+      if(it == _resources.end())
+        return "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+      auto &resource = it->second;
+      if(resource.failures) {
+        resource.failures--;
+        return "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+      }
+      if(!ifRange.empty() && ifRange != resource.etag)
+        offset = 0;                         // modified - send the whole resource
+
+      if(!resource.etag.empty() && ifNoneMatch == resource.etag) {
+        _notModified[url]++;
+        return "HTTP/1.1 304 Not Modified\r\nETag: " + resource.etag + "\r\n\r\n";
+      }
+
+      const std::string body = resource.body.substr(static_cast<size_t>(offset));
+      std::string response = offset ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n";
+      if(!resource.etag.empty())
+        response += "ETag: " + resource.etag + "\r\nLast-Modified: Sat, 01 Sep 2012 10:00:00 GMT\r\n";
+      if(offset)
+        response += "Content-Range: bytes " + Convert(offset) + "-" + Convert(resource.body.size() - 1) + "/" + Convert(resource.body.size()) + "\r\n";
+      if(resource.chunked) {
+        response += "Transfer-Encoding: chunked\r\n\r\n";
+        dropAt = resource.dropAt != std::string::npos ? response.size() + resource.dropAt : std::string::npos;
+        for(size_t pos=0; pos<body.size(); pos += 1000) {
+          std::ostringstream size;
+          size << std::hex << std::min<size_t>(1000, body.size() - pos);
+          response += size.str() + "\r\n" + body.substr(pos, 1000) + "\r\n";
+        }
+        response += "0\r\n\r\n";
+      }
+      else {
+        response += "Content-Length: " + Convert(body.size()) + "\r\n\r\n";
+        dropAt = resource.dropAt != std::string::npos ? response.size() + resource.dropAt : std::string::npos;
+        response += body;
+      }
+      resource.dropAt = std::string::npos;
+      delay = resource.delay;
+      return response;
+    }
+
+    void Serve(std::shared_ptr<boost::asio::ip::tcp::socket> socket)
+    {
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _accepted++;
+        _maxConnections = std::max(_maxConnections, ++_open);
+      }
+      try {
+        boost::asio::streambuf buffer;
+        bool keepAlive = true;
+        while(keepAlive && !_stop) {
+          boost::asio::read_until(*socket, buffer, "\r\n\r\n");
+          std::istream stream{&buffer};
+          std::string method, url, version, header;
+          stream >> method >> url >> version;
+          std::getline(stream, header);
+          keepAlive = version == "HTTP/1.1";
+          uint64_t offset = 0;
+          std::string ifNoneMatch, ifRange;
+          while(std::getline(stream, header) && header != "\r") {
+            if(header.compare(0, 13, "Range: bytes=") == 0)
+              offset = Convert<uint64_t>(header.substr(13, header.find('-') - 13));
+            else if(header.compare(0, 15, "If-None-Match: ") == 0)
+              ifNoneMatch = header.substr(15, header.size() - 16);
+            else if(header.compare(0, 10, "If-Range: ") == 0)
+              ifRange = header.substr(10, header.size() - 11);
+            else if(header.compare(0, 17, "Connection: close") == 0)
+              keepAlive = false;
+          }
+
+          unsigned delay = 0;
+          size_t dropAt = std::string::npos;
+          const std::string response = Response(url, offset, ifNoneMatch, ifRange, delay, dropAt);
+          for(unsigned i=0; i<delay / 10 && !_stop; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+          boost::asio::write(*socket, boost::asio::buffer(response.data(), std::min(dropAt, response.size())));
+          if(dropAt != std::string::npos)
+            break;
+        }
+      }
+      catch(const std::exception &) {
+      }
+      boost::system::error_code ignored;
+      socket->close(ignored);
+      std::lock_guard<std::mutex> lock{_mutex};
+      _open--;
+    }
+
+    template<typename T>
+    T Value(const std::map<std::string, T> &values, const std::string &url) const
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      auto it = values.find(url);
+      return it != values.end() ? it->second : T{};
+    }
+
+  public:
+    CHttpServer() :
+      _acceptor{_io, boost::asio::ip::tcp::endpoint{boost::asio::ip::address_v4::loopback(), 0}}, _stop{false},
+      _accepted{0}, _open{0}, _maxConnections{0}
+    {
+    }
+
+    ~CHttpServer()
+    {
+      _stop = true;
+      if(_thread.joinable()) {
+        // wake up the acceptor
+        boost::asio::ip::tcp::socket socket{_io};
+        boost::system::error_code ignored;
+        socket.connect(_acceptor.local_endpoint(), ignored);
+        _thread.join();
+      }
+      for(auto &connection : _connections)
+        connection.join();
+    }
+
+    std::string Server() const { return "127.0.0.1:" + Convert(_acceptor.local_endpoint().port()); }
+
+    void Resource(const std::string &url, const std::string &body, unsigned failures = 0, unsigned delay = 0, bool chunked = false, size_t dropAt = std::string::npos)
+    {
+      const TResource resource = { body, failures, delay, chunked, dropAt, "" };
+      std::lock_guard<std::mutex> lock{_mutex};
+      _resources[url] = resource;
+    }
+
+    void Modify(const std::string &url, const std::string &body, const std::string &etag)
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      auto &resource = _resources.at(url);
+      resource.body = body;
+      resource.etag = etag;
+    }
+
+    unsigned Requests(const std::string &url) const               { return Value(_requests, url); }
+    std::vector<uint64_t> Ranges(const std::string &url) const    { return Value(_ranges, url); }
+    unsigned NotModified(const std::string &url) const            { return Value(_notModified, url); }
+
+    unsigned Accepted() const
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      return _accepted;
+    }
+
+    unsigned MaxConnections() const
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      return _maxConnections;
+    }
+
+    void Start()
+    {
+      _thread = std::thread{[this]{
+        while(true) {
+          auto socket = std::make_shared<boost::asio::ip::tcp::socket>(_io);
+          _acceptor.accept(*socket);
+          if(_stop)
+            break;
+          _connections.emplace_back([this, socket]{ Serve(socket); });
+        }
+      }};
+    }
+  };
+
+
+  TEST_CLASS(TestDownloader) {
+    std::string FileRead(const bfs::path &path)
+    {
+      bfs::ifstream stream{path, std::ios_base::in | std::ios_base::binary};
+      return std::string{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+    }
+
+  public:
+    TEST_METHOD(Concurrency)
+    {
+      const CTempDir temp;
+      const bfs::path &dir = temp.Path();
+      CHttpServer server;
+      for(int i=0; i<12; i++)
+        server.Resource("/maps/Map" + Convert(i) + ".DEM", std::string(100000 + i, static_cast<char>('a' + i)), 0, 100);
+      server.Start();
+
+      const CDownloader::TConfig config = { 8, 3, 0, 10 };
+      CDownloader downloader{config};
+      for(int i=0; i<12; i++)
+        Assert::AreEqual(static_cast<size_t>(i), downloader.Add(server.Server(), "/maps/Map" + Convert(i) + ".DEM", dir / ("Map" + Convert(i) + ".DEM")));
+      unsigned done = 0;
+      auto errors = downloader.Run([]{ return false; }, [&](size_t, std::exception_ptr) { done++; });
+
+      Assert::AreEqual(12U, done);
+      for(int i=0; i<12; i++) {
+        Assert::IsTrue(errors[i] == nullptr);
+        Assert::IsTrue(std::string(100000 + i, static_cast<char>('a' + i)) == FileRead(dir / ("Map" + Convert(i) + ".DEM")));
+      }
+      // 3 parallel downloads and every file requested once
+      Assert::AreEqual(3U, server.MaxConnections());
+      for(int i=0; i<12; i++)
+        Assert::AreEqual(1U, server.Requests("/maps/Map" + Convert(i) + ".DEM"));
+    }
+
+    TEST_METHOD(Retry)
+    {
+      const CTempDir temp;
+      const bfs::path &dir = temp.Path();
+      CHttpServer server;
+      server.Resource("/flaky.txt", "flaky", 2);
+      server.Resource("/broken.txt", "broken", 5);
+      server.Start();
+
+      const CDownloader::TConfig config = { 8, 4, 2, 10 };
+      CDownloader downloader{config};
+      downloader.Add(server.Server(), "/flaky.txt", dir / "flaky.txt");
+      downloader.Add(server.Server(), "/broken.txt", dir / "broken.txt");
+      downloader.Add(server.Server(), "/missing.txt", dir / "missing.txt");
+      auto errors = downloader.Run([]{ return false; });
+
+      Assert::IsTrue(errors[0] == nullptr);
+      Assert::IsTrue("flaky" == FileRead(dir / "flaky.txt"));
+      Assert::AreEqual(3U, server.Requests("/flaky.txt"));
+
+      Assert::IsTrue(errors[1] != nullptr);
+      Assert::ExpectException<EOperationFailed>([&]{ std::rethrow_exception(errors[1]); });
+      Assert::AreEqual(3U, server.Requests("/broken.txt"));
+      Assert::IsFalse(bfs::exists(dir / "broken.txt"));
+
+      // client errors are not retried
+      Assert::IsTrue(errors[2] != nullptr);
+      Assert::AreEqual(1U, server.Requests("/missing.txt"));
+      Assert::IsFalse(bfs::exists(dir / "missing.txt"));
+      Assert::IsFalse(bfs::exists(dir / ("missing.txt" + std::string{CDownloader::PART_EXTENSION})));
+    }
+
+    TEST_METHOD(Abort)
+    {
+      const CTempDir temp;
+      const bfs::path &dir = temp.Path();
+      CHttpServer server;
+      for(int i=0; i<4; i++)
+        server.Resource("/slow" + Convert(i) + ".txt", "slow", 0, 5000);
+      server.Start();
+
+      const CDownloader::TConfig config = { 2, 2, 2, 10 };
+      CDownloader downloader{config};
+      for(int i=0; i<4; i++)
+        downloader.Add(server.Server(), "/slow" + Convert(i) + ".txt", dir / ("slow" + Convert(i) + ".txt"));
+      const auto start = std::chrono::steady_clock::now();
+      auto errors = downloader.Run([&]{ return std::chrono::steady_clock::now() - start > std::chrono::milliseconds{200}; });
+      Assert::IsTrue(std::chrono::steady_clock::now() - start < std::chrono::milliseconds{2000});
+
+      for(int i=0; i<4; i++) {
+        Assert::IsTrue(errors[i] != nullptr);
+        Assert::IsFalse(bfs::exists(dir / ("slow" + Convert(i) + ".txt")));
+      }
+      // not started downloads are not retried
+      Assert::IsTrue(server.Requests("/slow2.txt") == 0);
+    }
+
+    TEST_METHOD(KeepAlive)
+    {
+      const CTempDir temp;
+      const bfs::path &dir = temp.Path();
+      CHttpServer server;
+      for(int i=0; i<10; i++)
+        server.Resource("/Map" + Convert(i) + ".LKM", std::string(1000 * i, static_cast<char>('a' + i)));
+      server.Start();
+
+      const CDownloader::TConfig config = { 2, 1, 0, 10 };
+      CDownloader downloader{config};
+      for(int i=0; i<10; i++)
+        downloader.Add(server.Server(), "/Map" + Convert(i) + ".LKM", dir / ("Map" + Convert(i) + ".LKM"));
+      auto errors = downloader.Run([]{ return false; });
+
+      for(int i=0; i<10; i++) {
+        Assert::IsTrue(errors[i] == nullptr);
+        Assert::IsTrue(std::string(1000 * i, static_cast<char>('a' + i)) == FileRead(dir / ("Map" + Convert(i) + ".LKM")));
+      }
+      Assert::AreEqual(1U, server.Accepted());
+    }
+
+    TEST_METHOD(Chunked)
+    {
+      const CTempDir temp;
+      const bfs::path &dir = temp.Path();
+      std::string data;
+      for(int i=0; i<250001; i++)
+        data += static_cast<char>('a' + i % 26);
+      CHttpServer server;
+      server.Resource("/Alps.DEM", data, 0, 0, true);
+      server.Resource("/LKMTemplates.txt", "Alps.TXT\r\nPyrenees.TXT\r\n", 0, 0, true);
+      server.Start();
+
+      CDownloader downloader;
+      downloader.Add(server.Server(), "/Alps.DEM", dir / "Alps.DEM");
+      Assert::IsTrue(downloader.Run([]{ return false; }).front() == nullptr);
+      Assert::IsTrue(data == FileRead(dir / "Alps.DEM"));
+
+      CIStream stream{server.Server(), "/LKMTemplates.txt"};
+      std::string line;
+      stream.GetLine(line);
+      Assert::AreEqual(std::string{"Alps.TXT"}, line);
+      stream.GetLine(line);
+      Assert::AreEqual(std::string{"Pyrenees.TXT"}, line);
+    }
+
+    TEST_METHOD(Resume)
+    {
+      const CTempDir temp;
+      const bfs::path &dir = temp.Path();
+      const std::string data(300000, 'd');
+      CHttpServer server;
+      server.Resource("/Alps_250.DEM", data, 0, 0, false, 100000);
+      server.Modify("/Alps_250.DEM", data, "\"a1\"");
+      server.Resource("/Alps.LKM", "");
+      server.Modify("/Alps.LKM", "0123456789", "\"l1\"");
+      server.Resource("/Pyrenees.LKM", "");
+      server.Modify("/Pyrenees.LKM", "abcdefghij", "\"p2\"");
+      server.Resource("/Pyrenees_250.DEM", "");
+      server.Modify("/Pyrenees_250.DEM", "ABCDEFGHIJ", "\"d1\"");
+      server.Start();
+
+      // interrupted in the previous run
+      auto partCreate = [&](const std::string &fileName, const std::string &validator) {
+        const bfs::path part = dir / (fileName + CDownloader::PART_EXTENSION);
+        bfs::ofstream stream{part, std::ios_base::out | std::ios_base::binary};
+        stream << "01234";
+        if(!validator.empty()) {
+          bfs::ofstream validatorStream{part.string() + CDownloader::VALIDATOR_EXTENSION, std::ios_base::out | std::ios_base::binary};
+          validatorStream << validator << "\n";
+        }
+      };
+      partCreate("Alps.LKM", "\"l1\"");
+      partCreate("Pyrenees.LKM", "\"p1\"");
+      partCreate("Pyrenees_250.DEM", "");
+
+      const CDownloader::TConfig config = { 8, 4, 1, 10 };
+      CDownloader downloader{config};
+      downloader.Add(server.Server(), "/Alps_250.DEM", dir / "Alps_250.DEM");
+      downloader.Add(server.Server(), "/Alps.LKM", dir / "Alps.LKM");
+      downloader.Add(server.Server(), "/Pyrenees.LKM", dir / "Pyrenees.LKM");
+      downloader.Add(server.Server(), "/Pyrenees_250.DEM", dir / "Pyrenees_250.DEM");
+      auto errors = downloader.Run([]{ return false; });
+
+      Assert::IsTrue(errors[0] == nullptr);
+      Assert::IsTrue(data == FileRead(dir / "Alps_250.DEM"));
+      Assert::AreEqual(2U, server.Requests("/Alps_250.DEM"));
+      Assert::AreEqual(1U, static_cast<unsigned>(server.Ranges("/Alps_250.DEM").size()));
+      Assert::IsTrue(server.Ranges("/Alps_250.DEM").front() == 100000);
+
+      Assert::IsTrue(errors[1] == nullptr);
+      Assert::AreEqual(std::string{"0123456789"}, FileRead(dir / "Alps.LKM"));
+      Assert::IsTrue(server.Ranges("/Alps.LKM").front() == 5);
+      Assert::IsFalse(bfs::exists(dir / ("Alps.LKM" + std::string{CDownloader::PART_EXTENSION})));
+      Assert::IsFalse(bfs::exists(dir / ("Alps.LKM" + std::string{CDownloader::PART_EXTENSION} + CDownloader::VALIDATOR_EXTENSION)));
+
+      // modified on the server since the part was downloaded
+      Assert::IsTrue(errors[2] == nullptr);
+      Assert::AreEqual(std::string{"abcdefghij"}, FileRead(dir / "Pyrenees.LKM"));
+      Assert::AreEqual(1U, server.Requests("/Pyrenees.LKM"));
+
+      // part without a validator is not resumed
+      Assert::IsTrue(errors[3] == nullptr);
+      Assert::AreEqual(std::string{"ABCDEFGHIJ"}, FileRead(dir / "Pyrenees_250.DEM"));
+      Assert::IsTrue(server.Ranges("/Pyrenees_250.DEM").empty());
+    }
+
+    TEST_METHOD(Cache)
+    {
+      const CTempDir temp;
+      const bfs::path dir = temp.Path() / "downloads";
+      const bfs::path cacheDir = temp.Path() / "httpCache";
+      CHttpServer server;
+      server.Resource("/LKMTemplates.txt", "");
+      server.Modify("/LKMTemplates.txt", "Alps.TXT\r\n", "\"v1\"");
+      server.Resource("/Alps.LKM", "");
+      server.Modify("/Alps.LKM", std::string(50000, 'm'), "\"m1\"");
+      server.Start();
+
+      {
+        CHttpCache cache{cacheDir};
+        CIStream first{server.Server(), "/LKMTemplates.txt", 30, &cache};
+        Assert::IsTrue(first.Data() == "Alps.TXT\r\n");
+        CIStream second{server.Server(), "/LKMTemplates.txt", 30, &cache};
+        Assert::IsTrue(second.Data() == "Alps.TXT\r\n");
+        Assert::AreEqual(1U, server.NotModified("/LKMTemplates.txt"));
+
+        CDownloader downloader{CDownloader::DEFAULT_CONFIG, &cache};
+        downloader.Add(server.Server(), "/Alps.LKM", dir / "Alps.LKM");
+        Assert::IsTrue(downloader.Run([]{ return false; }).front() == nullptr);
+        Assert::AreEqual(0U, server.NotModified("/Alps.LKM"));
+      }
+
+      // validators are read from the index
+      CHttpCache cache{cacheDir};
+      Assert::IsTrue(bfs::exists(cacheDir / CHttpCache::INDEX_FILE_NAME));
+      CIStream third{server.Server(), "/LKMTemplates.txt", 30, &cache};
+      Assert::IsTrue(third.Data() == "Alps.TXT\r\n");
+      Assert::AreEqual(2U, server.NotModified("/LKMTemplates.txt"));
+
+      CDownloader downloader{CDownloader::DEFAULT_CONFIG, &cache};
+      downloader.Add(server.Server(), "/Alps.LKM", dir / "Alps.LKM");
+      Assert::IsTrue(downloader.Run([]{ return false; }).front() == nullptr);
+      Assert::AreEqual(1U, server.NotModified("/Alps.LKM"));
+      Assert::IsTrue(std::string(50000, 'm') == FileRead(dir / "Alps.LKM"));
+
+      // removed file is downloaded unconditionally
+      bfs::remove(dir / "Alps.LKM");
+      downloader.Add(server.Server(), "/Alps.LKM", dir / "Alps.LKM");
+      Assert::IsTrue(downloader.Run([]{ return false; }).front() == nullptr);
+      Assert::AreEqual(1U, server.NotModified("/Alps.LKM"));
+      Assert::AreEqual(3U, server.Requests("/Alps.LKM"));
+      Assert::IsTrue(std::string(50000, 'm') == FileRead(dir / "Alps.LKM"));
+
+      // modified resource
+      server.Modify("/LKMTemplates.txt", "Alps.TXT\r\nPyrenees.TXT\r\n", "\"v2\"");
+      CIStream fourth{server.Server(), "/LKMTemplates.txt", 30, &cache};
+      Assert::IsTrue(fourth.Data() == "Alps.TXT\r\nPyrenees.TXT\r\n");
+      Assert::AreEqual(2U, server.NotModified("/LKMTemplates.txt"));
+    }
+
+    TEST_METHOD(CacheBodyKey)
+    {
+      const CTempDir temp;
+      {
+        CHttpCache cache{temp.Path()};
+        cache.BodyStore("server/Alps.TXT", "\"a1\"", "", "Alps");
+        std::string body;
+        Assert::IsTrue(cache.BodyRead("server/Alps.TXT", body));
+        Assert::AreEqual(std::string{"Alps"}, body);
+        cache.Dump();
+      }
+      Assert::IsTrue(bfs::exists(temp.Path() / CHttpCache::INDEX_FILE_NAME));
+      Assert::IsFalse(bfs::exists(temp.Path() / (std::string{CHttpCache::INDEX_FILE_NAME} + ".tmp")));
+
+      // the body file was overwritten by a resource with the same hash
+      CHttpCache cache{temp.Path()};
+      const CHttpCache::TEntry *entry = cache.Find("server/Alps.TXT");
+      Assert::IsTrue(entry != nullptr);
+      {
+        bfs::ofstream stream{entry->body, std::ios_base::out | std::ios_base::binary};
+        stream << "server/Pyrenees.TXT\nPyrenees";
+      }
+      std::string body;
+      Assert::IsFalse(cache.BodyRead("server/Alps.TXT", body));
+      Assert::IsTrue(body.empty());
+    }
+  };
+
+
+
+  ////////////////////////   F I L E   P A R S E R    I N I   ////////////////////////
+
+  TEST_CLASS(TestFileParserINI) {
+  public:
+    TEST_METHOD(InvalidINIFile)
+    {
+      Assert::ExpectException<EOperationFailed>([]{ CFileParserINI parser("nonexisting.some_file"); });
+    }
+
+    TEST_METHOD(NotAnINIFile)
+    {
+      Assert::ExpectException<EOperationFailed>([]{ CFileParserINI parser(MAIN_SRC_DIR / "data/GliderData.csv"); });
+    }
+
+    TEST_METHOD(ValidINIFile)
+    {
+      CFileParserINI parser(MAIN_SRC_DIR / "data/condor2nav.ini");
+      Assert::AreEqual((MAIN_SRC_DIR / "data/condor2nav.ini").string(), parser.Path().string());
+      Assert::AreEqual(std::string("LK8000"), parser.Value("Condor2Nav", "Target"));
+      Assert::AreEqual(std::string("1"), parser.Value("LK8000", "DefaultTaskOverwrite"));
+      Assert::AreEqual(std::string("1"), parser.Value("LK8000", "CheckForMapUpdates"));
+    }
+
+    TEST_METHOD(InvalidINIEntry)
+    {
+      CFileParserINI parser(MAIN_SRC_DIR / "data/condor2nav.ini");
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("Condor2Nav", "DefaultTaskOverwrite"); });
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("", "DefaultTaskOverwrite"); });
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("Condor2Nav", "NonExisting"); });
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("NonExisting", "DefaultTaskOverwrite"); });
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("NonExisting", ""); });
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("", ""); });
+    }
+
+    TEST_METHOD(ValidINIValueOverwrite)
+    {
+      CFileParserINI parser(MAIN_SRC_DIR / "data/condor2nav.ini");
+      parser.Value("Condor2Nav", "Target", "UnitTest");
+      Assert::AreEqual(std::string("UnitTest"), parser.Value("Condor2Nav", "Target"));
+      parser.Value("LK8000", "DefaultTaskOverwrite", "99");
+      Assert::AreEqual(std::string("99"), parser.Value("LK8000", "DefaultTaskOverwrite"));
+      parser.Value("Condor2Nav", "NonExisting", "Test");
+      Assert::AreEqual(std::string("Test"), parser.Value("Condor2Nav", "NonExisting"));
+      parser.Value("", "NonExisting", "Test");
+      Assert::AreEqual(std::string("Test"), parser.Value("", "NonExisting"));
+    }
+
+    TEST_METHOD(InvalidINIValueOverwrite)
+    {
+      CFileParserINI parser(MAIN_SRC_DIR / "data/condor2nav.ini");
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("NonExisting", "DefaultTaskOverwrite", "Fail"); });
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("NonExisting", "", "Fail"); });
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("", "", "Fail"); });
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Value("", {}, "Fail"); });
+    }
+
+    TEST_METHOD(INIDump)
+    {
+      const bfs::path dumpPath = bfs::temp_directory_path() / bfs::unique_path();
+      CFileParserINI parser(MAIN_SRC_DIR / "data/condor2nav.ini");
+      parser.Value("LK8000", "DefaultTaskOverwrite", "99");
+      parser.Dump(dumpPath);
+      {
+        CFileParserINI dumped(dumpPath);
+        Assert::AreEqual(std::string("LK8000"), dumped.Value("Condor2Nav", "Target"));
+        Assert::AreEqual(std::string("99"), dumped.Value("LK8000", "DefaultTaskOverwrite"));
+      }
+      bfs::remove(dumpPath);
+    }
+
+    TEST_METHOD(INIDuplicatedChapter)
+    {
+      const bfs::path path = bfs::temp_directory_path() / bfs::unique_path();
+      bfs::ofstream{path} << "[Chapter]\nKey=1\n\n[Other]\nKey=2\n\n[Chapter]\nKey=3\nNext=4\n";
+      {
+        CFileParserINI parser(path);
+        Assert::AreEqual(std::string("1"), parser.Value("Chapter", "Key"));
+        Assert::ExpectException<EOperationFailed>([&]{ parser.Value("Chapter", "Next"); });
+        parser.Dump();
+      }
+      {
+        const char *expected[] = { "[Chapter]", "Key=1", "", "[Other]", "Key=2", "", "[Chapter]", "Key=3", "Next=4" };
+        CIStream stream{path};
+        std::string line;
+        for(auto text : expected) {
+          Assert::IsTrue(static_cast<bool>(stream.GetLine(line)));
+          Assert::AreEqual(std::string{text}, line);
+        }
+        Assert::IsFalse(static_cast<bool>(stream.GetLine(line)));
+      }
+      bfs::remove(path);
+    }
+  };
+
+
+
+  ////////////////////////   F I L E   P A R S E R    C S V   ////////////////////////
+
+  TEST_CLASS(TestFileParserCSV) {
+  public:
+    TEST_METHOD(InvalidCSVFile)
+    {
+      Assert::ExpectException<EOperationFailed>([]{ CFileParserCSV parser("nonexisting.some_file"); });
+    }
+
+    TEST_METHOD(NotACSVFile)
+    {
+      Assert::ExpectException<EOperationFailed>([]{ CFileParserCSV parser(MAIN_SRC_DIR / "data/condor2nav.ini"); });
+    }
+
+    TEST_METHOD(ValidCSVFile)
+    {
+      CFileParserCSV parser(MAIN_SRC_DIR / "data/GliderData.csv");
+      Assert::AreEqual((MAIN_SRC_DIR / "data/GliderData.csv").string(), parser.Path().string());
+      Assert::AreEqual(24U, parser.Rows().size());
+      Assert::AreEqual(14U, parser.Rows()[0].size());
+      Assert::AreEqual(std::string("285"), parser.Row("ASW28")[1]);
+      Assert::AreEqual(std::string("285"), parser.Row("asw28", 0, true)[1]);
+      Assert::AreEqual(std::string("ASW22"), parser.Row("280", 1)[0]);
+    }
+
+    TEST_METHOD(InvalidCSVFileEntry)
+    {
+      CFileParserCSV parser(MAIN_SRC_DIR / "data/GliderData.csv");
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Row("asw28")[1]; });
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Row("123", 1)[0]; });
+    }
+
+    TEST_METHOD(CSVCursor)
+    {
+      CFileParserCSV parser(MAIN_SRC_DIR / "data/GliderData.csv");
+      CFileParserCSV::CCursor cursor(MAIN_SRC_DIR / "data/GliderData.csv");
+      size_t rows = 0;
+      while(cursor.Next()) {
+        const auto &expected = parser.Rows()[rows++];
+        Assert::AreEqual(expected.size(), cursor.Fields().size());
+        for(size_t i=0; i<expected.size(); i++)
+          Assert::AreEqual(expected[i], cursor.Fields()[i].to_string());
+      }
+      Assert::AreEqual(parser.Rows().size(), rows);
+      Assert::IsFalse(cursor.Next());
+    }
+
+    TEST_METHOD(CSVRowFind)
+    {
+      const bfs::path path = MAIN_SRC_DIR / "data/GliderData.csv";
+      Assert::AreEqual(std::string("285"), CFileParserCSV::RowFind(path, "ASW28")[1]);
+      Assert::AreEqual(std::string("285"), CFileParserCSV::RowFind(path, "asw28", 0, true)[1]);
+      Assert::AreEqual(std::string("ASW22"), CFileParserCSV::RowFind(path, "280", 1)[0]);
+      Assert::ExpectException<EOperationFailed>([&]{ CFileParserCSV::RowFind(path, "asw28"); });
+      Assert::ExpectException<EOperationFailed>([&]{ CFileParserCSV::RowFind(path, "285", 99); });
+      Assert::ExpectException<EOperationFailed>([]{ CFileParserCSV::RowFind(MAIN_SRC_DIR / "README.txt", "================"); });
+    }
+
+    TEST_METHOD(CSVRowModification)
+    {
+      CFileParserCSV parser(MAIN_SRC_DIR / "data/GliderData.csv");
+      auto &row = parser.Row("ASW28");
+      row[0] = "UnitTest";
+      Assert::AreEqual(std::string("285"), parser.Row("unittest", 0, true)[1]);
+      Assert::AreEqual(std::string("285"), parser.Row("UnitTest")[1]);
+      Assert::ExpectException<EOperationFailed>([&]{ parser.Row("ASW28"); });
+
+      // first matching row is returned
+      parser.Row("UnitTest")[1] = "280";
+      Assert::AreEqual(std::string("ASW22"), parser.Row("280", 1)[0]);
+      parser.Row("ASW22")[1] = "281";
+      Assert::AreEqual(std::string("UnitTest"), parser.Row("280", 1)[0]);
+
+      parser.Rows().front()[0] = "First";
+      Assert::AreEqual(&parser.Rows().front(), &parser.Row("first", 0, true));
+    }
+  };
+
+
+
+  ////////////////////////   C S V   T O K E N I Z E R   ////////////////////////
+
+  TEST_CLASS(TestCSVTokenizer) {
+
+    static std::vector<TCSVTokenizer> Tokenizers()
+    {
+      std::vector<TCSVTokenizer> tokenizers{TCSVTokenizer::SCALAR};
+      if(CSVTokenizerBest() != TCSVTokenizer::SCALAR)
+        tokenizers.push_back(TCSVTokenizer::SSE2);
+      if(CSVTokenizerBest() == TCSVTokenizer::AVX2)
+        tokenizers.push_back(TCSVTokenizer::AVX2);
+      return tokenizers;
+    }
+
+    static void Compare(boost::string_ref line)
+    {
+      CFieldViews expected, actual;
+      CSVTokenize(line, expected, TCSVTokenizer::SCALAR);
+      for(auto t : Tokenizers()) {
+        CSVTokenize(line, actual, t);
+        Assert::AreEqual(expected.size(), actual.size());
+        for(size_t i=0; i<expected.size(); i++)
+          Assert::IsTrue(expected[i].data() == actual[i].data() && expected[i].size() == actual[i].size());
+      }
+    }
+
+  public:
+    TEST_METHOD(Fields)
+    {
+      for(auto t : Tokenizers()) {
+        CFieldViews fields;
+        CSVTokenize(" a , \"b,c\",,d ", fields, t);
+        Assert::AreEqual(size_t{4}, fields.size());
+        Assert::AreEqual(std::string("a"), fields[0].to_string());
+        Assert::AreEqual(std::string("b,c"), fields[1].to_string());
+        Assert::AreEqual(std::string(""), fields[2].to_string());
+        Assert::AreEqual(std::string("d"), fields[3].to_string());
+
+        CSVTokenize("a,b,\"c,d", fields, t);
+        Assert::AreEqual(size_t{2}, fields.size());
+
+        // quoted field crossing the 64 bytes block boundary
+        const std::string longField(100, 'x');
+        CSVTokenize(std::string(60, 'y') + ",\"" + longField + ",\"," + longField, fields, t);
+        Assert::AreEqual(size_t{3}, fields.size());
+        Assert::AreEqual(longField + ",", fields[1].to_string());
+        Assert::AreEqual(longField, fields[2].to_string());
+      }
+    }
+
+    TEST_METHOD(GliderFlaps)
+    {
+      CFileParserCSV parser(MAIN_SRC_DIR / "data/GliderData.csv");
+      Assert::AreEqual(std::string("568,5,0,L/6/5,108,4,128,3,160,2,195,1"), parser.Row("ASG29")[13]);
+      Assert::AreEqual(std::string("500,5,0,5,72,4,92,3,103,2,129,1"), parser.Row("ASW22")[13]);
+      Assert::AreEqual(std::string(""), parser.Row("ASW28")[13]);
+
+      CIStream stream(MAIN_SRC_DIR / "data/GliderData.csv");
+      boost::string_ref line;
+      while(stream.GetLine(line))
+        Compare(line);
+    }
+
+    TEST_METHOD(WaypointFiles)
+    {
+      for(bfs::directory_iterator it(MAIN_SRC_DIR / "data/LK8000/Waypoints"), end; it != end; ++it) {
+        CIStream stream(it->path());
+        boost::string_ref line;
+        while(stream.GetLine(line))
+          Compare(line);
+      }
+    }
+  };
+
+
+
+  ////////////////////////   M A P   I N D E X   ////////////////////////
+
+  TEST_CLASS(TestMapIndex) {
+    static size_t FindLinear(const std::vector<CMapIndex::TBox> &boxes, const CMapIndex::TBox &area)
+    {
+      for(size_t i=0; i<boxes.size(); i++)
+        if(boxes[i].Contains(area))
+          return i;
+      return CMapIndex::NOT_FOUND;
+    }
+
+    static CMapIndex::TBox Box(double lonMin, double lonMax, double latMin, double latMax)
+    {
+      const CMapIndex::TBox box = { lonMin, lonMax, latMin, latMax };
+      return box;
+    }
+
+  public:
+    TEST_METHOD(Empty)
+    {
+      const CMapIndex index{std::vector<CMapIndex::TBox>{}};
+      Assert::AreEqual(static_cast<size_t>(0), index.Size());
+      Assert::IsTrue(index.Find(Box(6, 7, 45, 46)) == CMapIndex::NOT_FOUND);
+    }
+
+    TEST_METHOD(Priority)
+    {
+      std::vector<CMapIndex::TBox> boxes;
+      boxes.push_back(Box(5, 9, 44, 47));                // Alps 250m
+      boxes.push_back(Box(5, 9, 44, 47));                // the same area 250m (worse name)
+      boxes.push_back(Box(-10, 30, 35, 60));             // Europe 500m
+      boxes.push_back(Box(-1, 3, 42, 44));               // Pyrenees 1000m
+      const CMapIndex index{boxes};
+
+      Assert::IsTrue(index.Find(Box(6, 7, 45, 46)) == 0);
+      Assert::IsTrue(index.Find(Box(5, 9, 44, 47)) == 0);
+      Assert::IsTrue(index.Find(Box(4, 7, 45, 46)) == 2);
+      Assert::IsTrue(index.Find(Box(0, 2, 42.5, 43.5)) == 2);
+      Assert::IsTrue(index.Find(Box(-20, 2, 42.5, 43.5)) == CMapIndex::NOT_FOUND);
+    }
+
+    TEST_METHOD(MatchesLinearScan)
+    {
+      std::mt19937 random{2012};
+      std::uniform_real_distribution<double> lon{-180, 180}, lat{-80, 80}, size{0.1, 20};
+      std::vector<CMapIndex::TBox> boxes;
+      for(unsigned i=0; i<5000; i++) {
+        const double lonMin = lon(random), latMin = lat(random);
+        boxes.push_back(Box(lonMin, lonMin + size(random), latMin, latMin + size(random)));
+      }
+      const CMapIndex index{boxes};
+      Assert::AreEqual(boxes.size(), index.Size());
+
+      unsigned found = 0;
+      for(unsigned i=0; i<2000; i++) {
+        const double lonMin = lon(random), latMin = lat(random);
+        const auto area = Box(lonMin, lonMin + size(random) / 10, latMin, latMin + size(random) / 10);
+        const size_t expected = FindLinear(boxes, area);
+        Assert::IsTrue(expected == index.Find(area));
+        if(expected != CMapIndex::NOT_FOUND)
+          found++;
+      }
+      Assert::IsTrue(found > 100);
+    }
+  };
+
+
+
+  ////////////////////////   P R O J E C T I O N   G R I D   ////////////////////////
+
+  TEST_CLASS(TestProjectionGrid) {
+    /**
+     * @brief NaviCon.dll stand-in with a spherical projection of the landscape.
+     */
+    struct TNaviConStandIn {
+      static double Lat(float x, float y) { return 45.0 + Rad2Deg(y / 6371000.0); }
+      static double Lon(float x, float y) { return 7.0 - Rad2Deg(x / (6371000.0 * cos(Deg2Rad(Lat(x, y))))); }
+    };
+
+    static CProjectionGrid::TStamp Stamp()
+    {
+      CProjectionGrid::TStamp stamp = { 123456, 789 };
+      return stamp;
+    }
+
+    static std::unique_ptr<CProjectionGrid> Grid()
+    {
+      return std::make_unique<CProjectionGrid>(Stamp(), 200000.0f, 150000.0f, 2000.0f, TNaviConStandIn::Lat, TNaviConStandIn::Lon);
+    }
+
+    static void Points(std::vector<float> &x, std::vector<float> &y)
+    {
+      for(unsigned i=0; i<1000; i++) {
+        x.push_back(static_cast<float>((i * 7919) % 200000));
+        y.push_back(static_cast<float>((i * 104729) % 150000));
+      }
+    }
+
+  public:
+    TEST_METHOD(Accuracy)
+    {
+      const auto grid = Grid();
+      Assert::AreEqual(101u, grid->Cols());
+      Assert::AreEqual(76u, grid->Rows());
+
+      std::vector<float> x, y;
+      Points(x, y);
+      std::vector<double> lat(x.size()), lon(x.size());
+      grid->LatLon(x.data(), y.data(), x.size(), lat.data(), lon.data());
+      for(size_t i=0; i<x.size(); i++) {
+        // 1e-6 degree is about 0.1m
+        Assert::AreEqual(TNaviConStandIn::Lat(x[i], y[i]), lat[i], 1e-6);
+        Assert::AreEqual(TNaviConStandIn::Lon(x[i], y[i]), lon[i], 1e-6);
+      }
+
+      // nodes are exact
+      const float nodeX = 10000, nodeY = 6000;
+      double nodeLat, nodeLon;
+      grid->LatLon(&nodeX, &nodeY, 1, &nodeLat, &nodeLon);
+      Assert::AreEqual(TNaviConStandIn::Lat(nodeX, nodeY), nodeLat, 1e-12);
+      Assert::AreEqual(TNaviConStandIn::Lon(nodeX, nodeY), nodeLon, 1e-12);
+    }
+
+    TEST_METHOD(InterpolationsMatch)
+    {
+      if(CProjectionGrid::InterpolationBest() == CProjectionGrid::TInterpolation::SCALAR)
+        return;
+
+      const auto grid = Grid();
+      std::vector<float> x, y;
+      Points(x, y);
+      // points outside of the landscape are extrapolated
+      x.push_back(-500.0f);
+      y.push_back(151000.0f);
+      std::vector<double> lat1(x.size()), lon1(x.size()), lat2(x.size()), lon2(x.size());
+      grid->LatLon(x.data(), y.data(), x.size(), lat1.data(), lon1.data(), CProjectionGrid::TInterpolation::SCALAR);
+      grid->LatLon(x.data(), y.data(), x.size(), lat2.data(), lon2.data(), CProjectionGrid::TInterpolation::SSE2);
+      for(size_t i=0; i<x.size(); i++) {
+        Assert::AreEqual(lat1[i], lat2[i]);
+        Assert::AreEqual(lon1[i], lon2[i]);
+      }
+      Assert::AreEqual(TNaviConStandIn::Lat(x.back(), y.back()), lat1.back(), 1e-6);
+      Assert::AreEqual(TNaviConStandIn::Lon(x.back(), y.back()), lon1.back(), 1e-6);
+    }
+
+    TEST_METHOD(DumpLoad)
+    {
+      const bfs::path gridPath = bfs::temp_directory_path() / bfs::unique_path();
+      const auto grid = Grid();
+      grid->Dump(gridPath);
+      {
+        const CProjectionGrid loaded{gridPath};
+        Assert::IsTrue(loaded.Stamp() == Stamp());
+        Assert::AreEqual(grid->Cols(), loaded.Cols());
+        Assert::AreEqual(grid->Rows(), loaded.Rows());
+
+        std::vector<float> x, y;
+        Points(x, y);
+        std::vector<double> lat1(x.size()), lon1(x.size()), lat2(x.size()), lon2(x.size());
+        grid->LatLon(x.data(), y.data(), x.size(), lat1.data(), lon1.data());
+        loaded.LatLon(x.data(), y.data(), x.size(), lat2.data(), lon2.data());
+        Assert::IsTrue(lat1 == lat2);
+        Assert::IsTrue(lon1 == lon2);
+      }
+      bfs::remove(gridPath);
+    }
+
+    TEST_METHOD(InvalidFile)
+    {
+      Assert::ExpectException<EOperationFailed>([]{ CProjectionGrid grid(MAIN_SRC_DIR / "data/condor2nav.ini"); });
+    }
+  };
+
+
+
+  ////////////////////////   N A V I C O N   W O R K E R S   ////////////////////////
+
+  TEST_CLASS(TestNaviConWorkers) {
+    /**
+     * @brief NaviCon.dll stand-in library (has to be in the library search path).
+     */
+    static const char *DLL_PATH;
+
+    /**
+     * @brief Workers served by the threads of the current process.
+     */
+    class CThreadWorkers {
+      std::vector<std::thread> _threads;
+      std::unique_ptr<CNaviConWorkers> _workers;
+
+    public:
+      explicit CThreadWorkers(unsigned num)
+      {
+        std::vector<std::unique_ptr<CNaviConWorkers::CWorker>> workers;
+        for(unsigned i=0; i<num; i++) {
+          HANDLE requestRead, requestWrite, replyRead, replyWrite;
+          Assert::IsTrue(CreatePipe(&requestRead, &requestWrite, nullptr, 0) != FALSE);
+          Assert::IsTrue(CreatePipe(&replyRead, &replyWrite, nullptr, 0) != FALSE);
+          _threads.emplace_back([=]{
+            CHandleRes request{requestRead}, reply{replyWrite};
+            CNaviConWorkers::Serve(request.get(), reply.get());
+          });
+          workers.push_back(std::make_unique<CNaviConWorkers::CWorker>(requestWrite, replyRead));
+        }
+        _workers = std::make_unique<CNaviConWorkers>(std::move(workers));
+      }
+
+      ~CThreadWorkers()
+      {
+        // closing pipes stops the workers
+        _workers.reset();
+        for(auto &t : _threads)
+          t.join();
+      }
+
+      CNaviConWorkers &Workers() { return *_workers; }
+    };
+
+    static bfs::path Trn(double lat, double lon)
+    {
+      const bfs::path trnPath = bfs::temp_directory_path() / bfs::unique_path();
+      bfs::ofstream trn(trnPath);
+      trn << lat << " " << lon << std::endl;
+      return trnPath;
+    }
+
+    static void Check(CNaviConWorkers &workers, const bfs::path &trnPath, double originLat, double originLon)
+    {
+      const float x[] = { 0.0f, 1000.0f, 150000.0f, 75000.5f };
+      const float y[] = { 0.0f, 2000.0f, 50000.0f, 199999.0f };
+      const size_t num = sizeof(x) / sizeof(*x);
+      double lat[num], lon[num];
+      workers.LatLon(DLL_PATH, trnPath, x, y, num, lat, lon);
+      for(size_t i=0; i<num; i++) {
+        Assert::AreEqual(originLat + y[i] / 111120.0, lat[i], 1e-4);
+        Assert::AreEqual(originLon + x[i] / (111120.0 * cos(originLat * 3.14159265358979323846 / 180)), lon[i], 1e-4);
+      }
+    }
+
+  public:
+    TEST_METHOD(LandscapesSwitch)
+    {
+      const auto trn1 = Trn(45.5, 14.0), trn2 = Trn(-33.0, 151.0), trn3 = Trn(60.0, -20.0);
+      {
+        // more landscapes than workers
+        CThreadWorkers workers{2};
+        for(unsigned i=0; i<3; i++) {
+          Check(workers.Workers(), trn1, 45.5, 14.0);
+          Check(workers.Workers(), trn2, -33.0, 151.0);
+          Check(workers.Workers(), trn3, 60.0, -20.0);
+        }
+      }
+      bfs::remove(trn1);
+      bfs::remove(trn2);
+      bfs::remove(trn3);
+    }
+
+    TEST_METHOD(Parallel)
+    {
+      const auto trn1 = Trn(45.5, 14.0), trn2 = Trn(-33.0, 151.0);
+      {
+        CThreadWorkers workers{2};
+        auto convert = [&](const bfs::path &trnPath, double lat, double lon){
+          for(unsigned i=0; i<100; i++)
+            Check(workers.Workers(), trnPath, lat, lon);
+        };
+        std::thread t1{[&]{ convert(trn1, 45.5, 14.0); }};
+        std::thread t2{[&]{ convert(trn2, -33.0, 151.0); }};
+        t1.join();
+        t2.join();
+      }
+      bfs::remove(trn1);
+      bfs::remove(trn2);
+    }
+
+    TEST_METHOD(WorkerError)
+    {
+      const auto trn = Trn(45.5, 14.0);
+      {
+        CThreadWorkers workers{1};
+        const float x = 0, y = 0;
+        double lat, lon;
+        Assert::ExpectException<EOperationFailed>([&]{ workers.Workers().LatLon("NotExisting.dll", trn, &x, &y, 1, &lat, &lon); });
+
+        // worker still usable
+        Check(workers.Workers(), trn, 45.5, 14.0);
+      }
+      bfs::remove(trn);
+    }
+  };
+
+  const char *TestNaviConWorkers::DLL_PATH = "NaviConStandIn.dll";
+
+
+
+  ////////////////////////   C O O R D   C A C H E   ////////////////////////
+
+  TEST_CLASS(TestCoordCache) {
+  public:
+    TEST_METHOD(FindInsert)
+    {
+      const bfs::path cachePath = bfs::temp_directory_path() / bfs::unique_path();
+      {
+        CCoordCache cache{cachePath, "AA3", 1000};
+        double lat, lon;
+        Assert::IsFalse(cache.Find(10.5f, 20.5f, lat, lon));
+        cache.Insert(10.5f, 20.5f, 45.25, 7.5);
+        Assert::IsTrue(cache.Find(10.5f, 20.5f, lat, lon));
+        Assert::AreEqual(45.25, lat);
+        Assert::AreEqual(7.5, lon);
+
+        // overwrite
+        cache.Insert(10.5f, 20.5f, 46.0, 8.0);
+        Assert::IsTrue(cache.Find(10.5f, 20.5f, lat, lon));
+        Assert::AreEqual(46.0, lat);
+      }
+      {
+        // persistent between runs
+        CCoordCache cache{cachePath, "AA3", 1000};
+        double lat, lon;
+        Assert::IsTrue(cache.Find(10.5f, 20.5f, lat, lon));
+        Assert::AreEqual(8.0, lon);
+      }
+      {
+        // other landscape or updated terrain
+        CCoordCache cache1{cachePath, "Slovenia3", 1000};
+        CCoordCache cache2{cachePath, "AA3", 1001};
+        double lat, lon;
+        Assert::IsFalse(cache1.Find(10.5f, 20.5f, lat, lon));
+        Assert::IsFalse(cache2.Find(10.5f, 20.5f, lat, lon));
+      }
+      {
+        // different layout recreates the file
+        CCoordCache cache{cachePath, "AA3", 1000, 16};
+        double lat, lon;
+        Assert::IsFalse(cache.Find(10.5f, 20.5f, lat, lon));
+      }
+      bfs::remove(cachePath);
+    }
+
+    TEST_METHOD(LRUEviction)
+    {
+      const bfs::path cachePath = bfs::temp_directory_path() / bfs::unique_path();
+      {
+        // one set only
+        CCoordCache cache{cachePath, "AA3", 1000, 1};
+        for(unsigned i=0; i<CCoordCache::WAYS; i++)
+          cache.Insert(static_cast<float>(i), 0.0f, i, i);
+        double lat, lon;
+        Assert::IsTrue(cache.Find(0.0f, 0.0f, lat, lon));
+        cache.Insert(100.0f, 0.0f, 100, 100);
+
+        // point '1' was the least recently used one
+        Assert::IsFalse(cache.Find(1.0f, 0.0f, lat, lon));
+        Assert::IsTrue(cache.Find(0.0f, 0.0f, lat, lon));
+        Assert::IsTrue(cache.Find(100.0f, 0.0f, lat, lon));
+        for(unsigned i=2; i<CCoordCache::WAYS; i++)
+          Assert::IsTrue(cache.Find(static_cast<float>(i), 0.0f, lat, lon));
+      }
+      bfs::remove(cachePath);
+    }
+
+    TEST_METHOD(SharedFile)
+    {
+      // every cache instance maps the file on its own as other processes do
+      const bfs::path cachePath = bfs::temp_directory_path() / bfs::unique_path();
+      const unsigned threadsNum = 4, pointsNum = 2000;
+      {
+        std::vector<std::thread> threads;
+        for(unsigned t=0; t<threadsNum; t++)
+          threads.emplace_back([&, t]{
+            CCoordCache cache{cachePath, "AA3", 1000, 1};
+            for(unsigned i=0; i<pointsNum; i++)
+              cache.Insert(static_cast<float>(t), static_cast<float>(i), t + i, t + i);
+          });
+        for(auto &t : threads)
+          t.join();
+      }
+      {
+        // whole entries are always written
+        CCoordCache cache{cachePath, "AA3", 1000, 1};
+        unsigned found = 0;
+        for(unsigned t=0; t<threadsNum; t++) {
+          for(unsigned i=0; i<pointsNum; i++) {
+            double lat, lon;
+            if(cache.Find(static_cast<float>(t), static_cast<float>(i), lat, lon)) {
+              Assert::AreEqual(static_cast<double>(t + i), lat);
+              Assert::AreEqual(static_cast<double>(t + i), lon);
+              found++;
+            }
+          }
+        }
+        Assert::IsTrue(found == CCoordCache::WAYS);
+      }
+      bfs::remove(cachePath);
+    }
+
+    TEST_METHOD(InvalidSets)
+    {
+      Assert::ExpectException<EOperationFailed>([]{ CCoordCache cache(bfs::temp_directory_path() / bfs::unique_path(), "AA3", 1000, 3); });
+    }
+  };
+
+
+
+  ////////////////////////   C O N D O R   ////////////////////////
+
+  TEST_CLASS(TestCondor) {
+    /**
+     * @brief Creates Condor directory with NaviCon.dll stand-in and one landscape.
+     */
+    static bfs::path CondorDir(const std::string &landscape, double lat, double lon)
+    {
+      const bfs::path condorPath = bfs::temp_directory_path() / bfs::unique_path();
+      bfs::create_directories(condorPath / "Landscapes" / landscape);
+
+      // NaviCon.dll stand-in is found in the library search path
+      CLibraryRes lib{::LoadLibrary("NaviConStandIn.dll")};
+      char dllPath[MAX_PATH];
+      Assert::IsTrue(lib && ::GetModuleFileName(lib.get(), dllPath, MAX_PATH) > 0);
+      bfs::copy_file(dllPath, condorPath / "NaviCon.dll");
+
+      bfs::ofstream trn(condorPath / "Landscapes" / landscape / (landscape + ".trn"));
+      trn << lat << " " << lon << std::endl;
+      return condorPath;
+    }
+
+  public:
+    TEST_METHOD(InstallPath)
+    {
+      Assert::AreEqual("C:\\Program Files (x86)\\Condor", condor::InstallPath().string().c_str());
+    }
+
+    TEST_METHOD(CoordConverterPool)
+    {
+      // no grid, cache or NaviCon.dll is used for not existing Condor directory
+      const bfs::path condorPath = bfs::temp_directory_path() / bfs::unique_path();
+      auto &pool = CCondor::CCoordConverterPool::Instance();
+      pool.Clear();
+      pool.MemoryLimit(CCondor::CCoordConverterPool::MEMORY_LIMIT_DEFAULT);
+
+      const auto aa3 = pool.Converter(condorPath, "AA3");
+      Assert::IsTrue(aa3 == pool.Converter(condorPath, "AA3"));
+      const auto slovenia = pool.Converter(condorPath, "Slovenia3");
+      Assert::IsTrue(aa3 != slovenia);
+      Assert::AreEqual(size_t(2), pool.Size());
+
+      // least recently used converter is dropped but stays alive for its users
+      pool.MemoryLimit(slovenia->MemoryUsage());
+      Assert::AreEqual(size_t(1), pool.Size());
+      Assert::IsTrue(slovenia == pool.Converter(condorPath, "Slovenia3"));
+      Assert::IsTrue(aa3 != pool.Converter(condorPath, "AA3"));
+      Assert::AreEqual(size_t(1), pool.Size());
+
+      pool.MemoryLimit(CCondor::CCoordConverterPool::MEMORY_LIMIT_DEFAULT);
+      pool.Clear();
+      Assert::AreEqual(size_t(0), pool.Size());
+    }
+
+    TEST_METHOD(CoordConverterLatLon)
+    {
+      const auto condorPath = CondorDir("UnitTest", 45.5, 14.0);
+      {
+        const CCondor::CCoordConverter converter{condorPath, "UnitTest", false};
+        const float x[] = { 0.0f, 1000.0f, 150000.0f, 75000.5f, 1000.0f };
+        const float y[] = { 0.0f, 2000.0f, 50000.0f, 199999.0f, 2000.0f };
+        const size_t num = sizeof(x) / sizeof(*x);
+        double lat[num], lon[num];
+        converter.LatLon(x, y, num, lat, lon);
+        for(size_t i=0; i<num; i++) {
+          Assert::AreEqual(converter.Latitude(x[i], y[i]).value, lat[i]);
+          Assert::AreEqual(converter.Longitude(x[i], y[i]).value, lon[i]);
+          Assert::AreEqual(45.5 + y[i] / 111120.0, lat[i], 1e-4);
+        }
+        converter.LatLon(x, y, 0, lat, lon);
+      }
+      bfs::remove_all(condorPath);
+    }
+
+    TEST_METHOD(CoordConverterRecreated)
+    {
+      const auto condorPath = CondorDir("UnitTest", 45.5, 14.0);
+      for(int i=0; i<2; i++) {
+        // NaviCon.dll stays initialized after the last converter is destroyed
+        const CCondor::CCoordConverter converter{condorPath, "UnitTest", false};
+        Assert::AreEqual(45.5 + 2000.0 / 111120.0, converter.Latitude(1000.0f, 2000.0f).value, 1e-4);
+      }
+      bfs::remove_all(condorPath);
+    }
+
+    TEST_METHOD(TaskProbe)
+    {
+      const bfs::path fplPath = bfs::temp_directory_path() / bfs::unique_path();
+      {
+        bfs::ofstream fpl(fplPath);
+        fpl << "[Version]" << std::endl << "Condor version=1200" << std::endl;
+        fpl << "[Task]" << std::endl << "Landscape = Slovenia3" << std::endl << "AAT=Speed" << std::endl << "DesignatedTime=150" << std::endl;
+        // the rest of the file is not read
+        fpl << "[Plane]" << std::endl << "corrupted line" << std::endl;
+      }
+      {
+        const auto header = CCondor::TaskProbe(fplPath);
+        Assert::AreEqual(1200u, header.version);
+        Assert::AreEqual(std::string("Slovenia3"), header.landscape);
+        Assert::IsTrue(header.aatType == condor::TAATType::SPEED);
+        Assert::AreEqual(150u, header.aatTime);
+      }
+      {
+        bfs::ofstream fpl(fplPath);
+        fpl << "[Version]" << std::endl << "Condor version=1000" << std::endl;
+        fpl << "[Task]" << std::endl << "Landscape=AA3" << std::endl;
+      }
+      Assert::ExpectException<EOperationFailed>([&]{ CCondor::TaskProbe(fplPath); });
+      {
+        bfs::ofstream fpl(fplPath);
+        fpl << "[Version]" << std::endl << "Condor version=1200" << std::endl;
+        fpl << "[Task]" << std::endl << "AAT=Distance" << std::endl;
+      }
+      Assert::ExpectException<EOperationFailed>([&]{ CCondor::TaskProbe(fplPath); });
+
+      // chapter names are parsed like with CFileParserINI and the first chapter wins
+      {
+        bfs::ofstream fpl(fplPath);
+        fpl << "[ Version ] ; comment" << std::endl << "Condor version=1200" << std::endl;
+        fpl << "  [Task]" << std::endl << "Landscape=AA3" << std::endl;
+        fpl << "[Task]" << std::endl << "Landscape=Slovenia3" << std::endl;
+      }
+      {
+        const auto header = CCondor::TaskProbe(fplPath);
+        CFileParserINI parser(fplPath);
+        Assert::AreEqual(std::string("AA3"), header.landscape);
+        Assert::AreEqual(parser.Value("Task", "Landscape"), header.landscape);
+      }
+
+      // duplicated key
+      {
+        bfs::ofstream fpl(fplPath);
+        fpl << "[Version]" << std::endl << "Condor version=1200" << std::endl;
+        fpl << "[Task]" << std::endl << "Landscape=AA3" << std::endl << "Landscape=Slovenia3" << std::endl;
+      }
+      Assert::ExpectException<EOperationFailed>([&]{ CFileParserINI parser(fplPath); });
+      Assert::ExpectException<EOperationFailed>([&]{ CCondor::TaskProbe(fplPath); });
+      bfs::remove(fplPath);
+    }
+
+    TEST_METHOD(TaskModel)
+    {
+      const bfs::path fplPath = bfs::temp_directory_path() / bfs::unique_path();
+      {
+        bfs::ofstream fpl(fplPath);
+        fpl << "[Version]" << std::endl << "Condor version=1200" << std::endl;
+        fpl << "[Task]" << std::endl << "Landscape=AA3" << std::endl << "AAT=Speed" << std::endl << "DesignatedTime=120" << std::endl;
+        fpl << "Count=3" << std::endl;
+        for(unsigned i=0; i<3; i++) {
+          fpl << "TPName" << i << "=TP " << i << std::endl;
+          fpl << "TPPosX" << i << "=" << i * 1000 + 0.5 << std::endl;
+          fpl << "TPPosY" << i << "=" << i * 2000 << std::endl;
+          fpl << "TPPosZ" << i << "=" << 300 + i << std::endl;
+          fpl << "TPRadius" << i << "=" << 500 * (i + 1) << std::endl;
+          fpl << "TPAngle" << i << "=" << (i ? 90 : 360) << std::endl;
+          fpl << "TPAltitude" << i << "=0" << std::endl;
+          fpl << "TPWidth" << i << "=" << (i == 2 ? 700 : 0) << std::endl;
+          fpl << "TPHeight" << i << "=1500" << std::endl;
+          fpl << "TPSectorType" << i << "=0" << std::endl;
+        }
+        fpl << "PZCount=1" << std::endl << "PZTop0=2500.5" << std::endl << "PZBase0=0" << std::endl;
+        for(unsigned j=0; j<4; j++)
+          fpl << "PZPos" << j << "X0=" << j * 10 << std::endl << "PZPos" << j << "Y0=" << j * 20 << std::endl;
+        fpl << "[Plane]" << std::endl << "Name=ASW28" << std::endl << "Class=Standard" << std::endl << "Water=120" << std::endl;
+        fpl << "[Weather]" << std::endl << "WindDir=270.4" << std::endl << "WindSpeed=5.5" << std::endl;
+      }
+      {
+        const condor::TTask task{CFileParserINI{fplPath}};
+        Assert::AreEqual(1200u, task.version);
+        Assert::AreEqual(std::string("AA3"), task.landscape);
+        Assert::IsTrue(task.aatType == condor::TAATType::SPEED);
+        Assert::AreEqual(120u, task.aatTime);
+        Assert::IsTrue(task.aatTimeValid);
+
+        const auto &tps = task.turnpoints;
+        Assert::AreEqual(size_t(3), tps.Size());
+        Assert::AreEqual(std::string("TP 2"), tps.name[2]);
+        Assert::AreEqual(1000.5f, tps.x[1], 0.0f);
+        Assert::AreEqual(4000.0f, tps.y[2], 0.0f);
+        Assert::AreEqual(301.0, tps.z[1], 0.0);
+        Assert::AreEqual(700u, tps.width[2]);
+        Assert::AreEqual(1500u, tps.radius[2]);
+        Assert::AreEqual(360u, tps.angle[0]);
+        Assert::AreEqual(90u, tps.angle[1]);
+        Assert::AreEqual(1500u, tps.height[1]);
+        Assert::AreEqual(static_cast<unsigned>(condor::SECTOR_CLASSIC), tps.sectorType[1]);
+
+        const auto &pzs = task.penaltyZones;
+        Assert::AreEqual(size_t(1), pzs.Size());
+        Assert::AreEqual(std::string("2500.5"), pzs.top[0]);
+        Assert::AreEqual(0u, pzs.base[0]);
+        Assert::AreEqual(30.0f, pzs.x[3][0], 0.0f);
+        Assert::AreEqual(40.0f, pzs.y[2][0], 0.0f);
+
+        Assert::AreEqual(std::string("ASW28"), task.plane.name);
+        Assert::AreEqual(std::string("Standard"), task.plane.className);
+        Assert::AreEqual(120u, task.plane.water);
+        Assert::AreEqual(270.4f, task.weather.windDir, 0.001f);
+        Assert::AreEqual(5.5f, task.weather.windSpeed, 0.001f);
+      }
+      {
+        // landscape is not needed until coordinates are converted
+        const CCondor condor{bfs::temp_directory_path() / bfs::unique_path(), fplPath};
+        Assert::AreEqual(std::string("AA3"), condor.Task().landscape);
+      }
+      bfs::remove(fplPath);
+    }
+
+    TEST_METHOD(TaskPartsIndependent)
+    {
+      const bfs::path fplPath = bfs::temp_directory_path() / bfs::unique_path();
+      {
+        bfs::ofstream fpl(fplPath);
+        fpl << "[Version]" << std::endl << "Condor version=1200" << std::endl;
+        fpl << "[Task]" << std::endl << "Landscape=AA3" << std::endl << "AAT=Speed" << std::endl << "DesignatedTime=0" << std::endl;
+        fpl << "Count=0" << std::endl << "PZCount=0" << std::endl;
+        fpl << "[Plane]" << std::endl << "Name=ASW28" << std::endl << "Class=Standard" << std::endl;
+      }
+      {
+        const condor::TTask task{CFileParserINI{fplPath}};
+        Assert::IsTrue(task.aatTimeValid);
+        Assert::AreEqual(0u, task.aatTime);
+        Assert::IsTrue(CCondor::TaskProbe(fplPath).aatTimeValid);
+
+        // missing data is reported only when used
+        task.turnpoints.Check();
+        task.penaltyZones.Check();
+        Assert::ExpectException<EOperationFailed>([&]{ task.plane.Check(); });
+        Assert::ExpectException<EOperationFailed>([&]{ task.weather.Check(); });
+        Assert::AreEqual(std::string(), task.plane.name);
+      }
+      bfs::remove(fplPath);
+    }
+
+    //TEST_METHOD(FPLPath)
+    //{
+    //  Assert::AreEqual("C:\\Program Files (x86)\\Condor", CCondor::InstallPath().string().c_str());
+    //}
+
+    //TEST_METHOD(TaskParser)
+    //{
+    //  Assert::AreEqual("C:\\Program Files (x86)\\Condor", CCondor::InstallPath().string().c_str());
+    //}
+
+    //TEST_METHOD(CoordConverter)
+    //{
+    //  Assert::AreEqual("C:\\Program Files (x86)\\Condor", CCondor::InstallPath().string().c_str());
+    //}
+
+  };
+
+}
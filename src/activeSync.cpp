@@ -1,276 +1,789 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
- * @file activeSync.cpp
- *
- * @brief Implements the ActiveSync wrapper class. 
- */
-
-#include "activeSync.h"
-#include <memory>
-#include <algorithm>
-#include <rapi.h>
-#include <boost/filesystem.hpp>
-
-namespace {
-
-  // rapi.dll interface
-  using FCeRapiInitEx = HRESULT(WINAPI*)(RAPIINIT *pRapiInit);
-  using FCeRapiUninit = HRESULT(WINAPI*)();
-  using FCeGetLastError = DWORD(WINAPI*)();
-
-  using FCeCreateFile = HANDLE(WINAPI*)(LPCWSTR lpFileName,
-                                        DWORD dwDesiredAccess,
-                                        DWORD dwShareMode,
-                                        LPSECURITY_ATTRIBUTES lpSecurityAttributes,
-                                        DWORD dwCreationDisposition,
-                                        DWORD dwFlagsAndAttributes,
-                                        HANDLE hTemplateFile);
-  using FCeGetFileSize = DWORD(WINAPI*)(HANDLE hFile,
-                                        LPDWORD lpFileSizeHigh);
-  using FCeReadFile = BOOL(WINAPI*)(HANDLE hFile,
-                                    LPVOID lpBuffer,
-                                    DWORD nNumberOfBytesToRead,
-                                    LPDWORD lpNumberOfBytesRead,
-                                    LPOVERLAPPED lpOverlapped);
-  using FCeWriteFile = BOOL(WINAPI*)(HANDLE hFile,
-                                     LPCVOID lpBuffer,
-                                     DWORD nNumberOfBytesToWrite,
-                                     LPDWORD lpNumberOfBytesWritten,
-                                     LPOVERLAPPED lpOverlapped);
-  using FCeCloseHandle = BOOL(WINAPI*)(HANDLE hObject);
-  using FCeCreateDirectory = BOOL(WINAPI*)(LPCWSTR lpPathName,
-                                           LPSECURITY_ATTRIBUTES lpSecurityAttributes);
-
-  template<typename SYMBOL_TYPE>
-  inline void Symbol(const HMODULE &module, const std::string &name, SYMBOL_TYPE &out)
-  {
-    auto sym = reinterpret_cast<SYMBOL_TYPE>(GetProcAddress(module, name.c_str()));
-    if(!sym)
-      throw condor2nav::EOperationFailed{"ERROR: Couldn't map " + name + "() from 'rapi.dll'!!!"};
-    out = sym;
-  }
-
-}
-
-
-namespace condor2nav {
-
-  /**
-   * @brief rapi.dll interface.
-   */
-  struct CActiveSync::TDLLIface {
-    FCeRapiInitEx      ceRapiInitEx;
-    FCeRapiUninit      ceRapiUninit;
-    FCeGetLastError    ceGetLastError;
-    FCeCreateFile      ceCreateFile;
-    FCeGetFileSize     ceGetFileSize;
-    FCeReadFile        ceReadFile;
-    FCeWriteFile       ceWriteFile;
-    FCeCloseHandle     ceCloseHandle;
-    FCeCreateDirectory ceCreateDirectory;
-  };
-
-  class CActiveSync::CRapiHandleDeleter {
-    const TDLLIface &_iface;
-  public:
-    using pointer = HANDLE;
-    CRapiHandleDeleter(const TDLLIface &iface) : _iface{iface} {}
-    CRapiHandleDeleter &operator =(const CRapiHandleDeleter &) = delete;
-    void operator ()(pointer handle) const { _iface.ceCloseHandle(handle); }
-  };
-
-  void CActiveSync::CRapiDeleter::operator()(pointer status) const { _iface.ceRapiUninit(); }
-
-}
-
-
-
-/**
- * @brief Returns singleton instance.
- *
- * Method returns singleton instance.
- *
- * @return Singleton instance.
- */
-condor2nav::CActiveSync &condor2nav::CActiveSync::Instance()
-{
-  static CActiveSync instance;
-  return instance;
-}
-
-
-/**
- * @brief Class constructor.
- *
- * condor2nav::CActiveSync class constructor.
- */
-condor2nav::CActiveSync::CActiveSync() :
-  _lib{::LoadLibrary("rapi.dll")}, _iface{std::make_unique<TDLLIface>()}, _rapi{false, CRapiDeleter(*_iface)}
-{
-  if(!_lib.get())
-    throw EOperationFailed{"ERROR: Couldn't open 'rapi.dll' library!!! Please check that ActiveSync is installed correctly."};
-  Symbol(_lib.get(), "CeRapiInitEx",      _iface->ceRapiInitEx);
-  Symbol(_lib.get(), "CeRapiUninit",      _iface->ceRapiUninit);
-  Symbol(_lib.get(), "CeGetLastError",    _iface->ceGetLastError);
-  Symbol(_lib.get(), "CeCreateFile",      _iface->ceCreateFile);
-  Symbol(_lib.get(), "CeGetFileSize",     _iface->ceGetFileSize);
-  Symbol(_lib.get(), "CeReadFile",        _iface->ceReadFile);
-  Symbol(_lib.get(), "CeWriteFile",       _iface->ceWriteFile);
-  Symbol(_lib.get(), "CeCloseHandle",     _iface->ceCloseHandle);
-  Symbol(_lib.get(), "CeCreateDirectory", _iface->ceCreateDirectory);
-
-  // init RAPI
-  RAPIINIT initData{};
-  initData.cbSize = sizeof(initData);
-
-  _rapi.reset(!FAILED(_iface->ceRapiInitEx(&initData)));
-  if(!_rapi.get())
-    throw EOperationFailed{"Cannot initialize ActiveSync connection!!!"};
-
-  HRESULT hr;
-  auto status = WaitForSingleObject(initData.heRapiInit, TIMEOUT);
-  if(status == WAIT_OBJECT_0) {
-    // heRapiInit signaled:
-    // set return error code to return value of RAPI Init function
-    hr = initData.hrRapiInit;  
-  }
-  else {
-    if(status == WAIT_TIMEOUT) {
-      // timed out: device is probably not connected
-      // or not responding
-      hr = HRESULT_FROM_WIN32(ERROR_TIMEOUT);
-    }
-    else {
-      // WaitForSingleObject failed
-      hr = HRESULT_FROM_WIN32(GetLastError());
-    }
-
-    throw EOperationFailed{"ERROR: Cannot initialize ActiveSync interface!!!"};
-  }
-}
-
-
-/**
- * @brief Reads whole file to a string.
- *
- * Method reads whole file to a string.
- *
- * @param src Target file path. 
- * 
- * @return String with file content. 
- */
-std::string condor2nav::CActiveSync::Read(const bfs::path &src) const
-{
-  std::unique_ptr<HANDLE, CRapiHandleDeleter> hSrc{_iface->ceCreateFile(src.wstring().c_str(),
-                                                                        GENERIC_READ,
-                                                                        FILE_SHARE_READ,
-                                                                        nullptr,
-                                                                        OPEN_EXISTING,
-                                                                        FILE_ATTRIBUTE_NORMAL,
-                                                                        nullptr),
-                                                   CRapiHandleDeleter{*_iface}};
-  if(hSrc.get() == INVALID_HANDLE_VALUE)
-    throw EOperationFailed{"ERROR: Unable to open ActiveSync file '" + src.string() + "'!!!"};
-
-  auto numBytes = _iface->ceGetFileSize(hSrc.get(), nullptr);
-  std::vector<char> buffer;
-  buffer.resize(numBytes);
-
-  if(!_iface->ceReadFile(hSrc.get(), buffer.data(), numBytes, &numBytes, nullptr))
-    throw EOperationFailed{"ERROR: Reading ActiveSync file '" + src.string() + "'!!!"};
-
-  // remove all returns from a file
-  buffer.erase(std::remove_if(begin(buffer), end(buffer), [](char c){ return c == '\r'; }), end(buffer));
-
-  return buffer.data();
-}
-
-
-/**
- * @brief Writes buffer to a file on the target device.
- *
- * Method writes buffer to a file on the target device.
- *
- * @param dest Target file path. 
- * @param buffer Buffer with file content. 
- */
-void condor2nav::CActiveSync::Write(const bfs::path &dest, const std::string &buffer) const
-{
-  std::unique_ptr<HANDLE, CRapiHandleDeleter> hDest{_iface->ceCreateFile(dest.wstring().c_str(),
-                                                                         GENERIC_WRITE,
-                                                                         FILE_SHARE_READ,
-                                                                         nullptr,
-                                                                         CREATE_ALWAYS,
-                                                                         FILE_ATTRIBUTE_NORMAL,
-                                                                         nullptr),
-                                                    CRapiHandleDeleter{*_iface}};
-  if(hDest.get() == INVALID_HANDLE_VALUE)
-    throw EOperationFailed{"ERROR: Unable to open ActiveSync file '" + dest.string() + "'!!!"};
-
-  DWORD numBytes;
-  if(!_iface->ceWriteFile(hDest.get(), buffer.c_str(), buffer.size(), &numBytes, nullptr))
-    throw EOperationFailed{"ERROR: Writing ActiveSync file '" + dest.string() + "'!!!"};
-}
-
-
-/**
- * @brief Creates directory on the target device.
- *
- * Method creates directory on the target device.
- *
- * @param path Target directory path. 
- */
-void condor2nav::CActiveSync::DirectoryCreate(const bfs::path &path) const
-{
-  if(!_iface->ceCreateDirectory(path.wstring().c_str(), nullptr) && _iface->ceGetLastError() != ERROR_ALREADY_EXISTS)
-    throw EOperationFailed{"ERROR: Creating ActiveSync directory '" + path.string() + "'!!!"};
-}
-
-
-/**
- * @brief Checks if a file exists on the target device.
- *
- * Method checks if a file exists on the target device.
- *
- * @param path Target file path.
- *
- * @return @p true if file exists.
- */
-bool condor2nav::CActiveSync::FileExists(const bfs::path &path) const
-{
-  std::unique_ptr<HANDLE, CRapiHandleDeleter> hDest{_iface->ceCreateFile(path.wstring().c_str(),
-                                                                         GENERIC_READ,
-                                                                         FILE_SHARE_READ,
-                                                                         nullptr,
-                                                                         OPEN_EXISTING,
-                                                                         FILE_ATTRIBUTE_NORMAL,
-                                                                         nullptr),
-                                                    CRapiHandleDeleter{*_iface}};
-  if(hDest.get() == INVALID_HANDLE_VALUE) {
-    if(_iface->ceGetLastError() == ERROR_FILE_NOT_FOUND)
-      return false;
-    throw EOperationFailed{"ERROR: Unable to check if file '" + path.string() + "' exists!!!"};
-  }
-  else
-    return true;
-}
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file activeSync.cpp
+ *
+ * @brief Implements the ActiveSync wrapper class. 
+ */
+
+#include "activeSync.h"
+#include "transfer.h"
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cwctype>
+#include <iterator>
+#include <rapi.h>
+#include <boost/filesystem.hpp>
+
+namespace {
+
+  // rapi.dll interface
+  using FCeRapiInitEx = HRESULT(WINAPI*)(RAPIINIT *pRapiInit);
+  using FCeRapiUninit = HRESULT(WINAPI*)();
+  using FCeGetLastError = DWORD(WINAPI*)();
+
+  using FCeCreateFile = HANDLE(WINAPI*)(LPCWSTR lpFileName,
+                                        DWORD dwDesiredAccess,
+                                        DWORD dwShareMode,
+                                        LPSECURITY_ATTRIBUTES lpSecurityAttributes,
+                                        DWORD dwCreationDisposition,
+                                        DWORD dwFlagsAndAttributes,
+                                        HANDLE hTemplateFile);
+  using FCeGetFileSize = DWORD(WINAPI*)(HANDLE hFile,
+                                        LPDWORD lpFileSizeHigh);
+  using FCeReadFile = BOOL(WINAPI*)(HANDLE hFile,
+                                    LPVOID lpBuffer,
+                                    DWORD nNumberOfBytesToRead,
+                                    LPDWORD lpNumberOfBytesRead,
+                                    LPOVERLAPPED lpOverlapped);
+  using FCeWriteFile = BOOL(WINAPI*)(HANDLE hFile,
+                                     LPCVOID lpBuffer,
+                                     DWORD nNumberOfBytesToWrite,
+                                     LPDWORD lpNumberOfBytesWritten,
+                                     LPOVERLAPPED lpOverlapped);
+  using FCeCloseHandle = BOOL(WINAPI*)(HANDLE hObject);
+  using FCeCreateDirectory = BOOL(WINAPI*)(LPCWSTR lpPathName,
+                                           LPSECURITY_ATTRIBUTES lpSecurityAttributes);
+  using FCeDeleteFile = BOOL(WINAPI*)(LPCWSTR lpFileName);
+  using FCeFindFirstFile = HANDLE(WINAPI*)(LPCWSTR lpFileName,
+                                          LPCE_FIND_DATA lpFindFileData);
+  using FCeFindNextFile = BOOL(WINAPI*)(HANDLE hFindFile,
+                                        LPCE_FIND_DATA lpFindFileData);
+  using FCeFindClose = BOOL(WINAPI*)(HANDLE hFindFile);
+
+  const condor2nav::CActiveSync *instance = nullptr;   ///< @brief Connected instance (nullptr if not connected yet).
+  std::atomic<unsigned> batchLevel{0};                 ///< @brief The number of existing batches.
+
+  template<typename SYMBOL_TYPE>
+  inline void Symbol(const HMODULE &module, const std::string &name, SYMBOL_TYPE &out)
+  {
+    auto sym = reinterpret_cast<SYMBOL_TYPE>(GetProcAddress(module, name.c_str()));
+    if(!sym)
+      throw condor2nav::EOperationFailed{"ERROR: Couldn't map " + name + "() from 'rapi.dll'!!!"};
+    out = sym;
+  }
+
+  /**
+   * @brief Data sink appending to a string.
+   *
+   * All returns are removed from the data.
+   */
+  class CStringSink : public condor2nav::CTransfer::CSink {
+    std::string &_str;
+  public:
+    explicit CStringSink(std::string &str) : _str(str) {}
+    void Write(const char *data, size_t size) override { std::remove_copy(data, data + size, std::back_inserter(_str), '\r'); }
+  };
+
+  /**
+   * @brief Returns the key of the path in the session cache.
+   *
+   * Device file system is case insensitive.
+   *
+   * @param path Target path.
+   *
+   * @return Upper case path.
+   */
+  std::wstring Key(const bfs::path &path)
+  {
+    auto key = path.wstring();
+    std::transform(begin(key), end(key), begin(key), [](wchar_t c){ return static_cast<wchar_t>(std::towupper(c)); });
+    return key;
+  }
+
+}
+
+
+namespace condor2nav {
+
+  /**
+   * @brief rapi.dll interface.
+   */
+  struct CActiveSync::TDLLIface {
+    FCeRapiInitEx      ceRapiInitEx;
+    FCeRapiUninit      ceRapiUninit;
+    FCeGetLastError    ceGetLastError;
+    FCeCreateFile      ceCreateFile;
+    FCeGetFileSize     ceGetFileSize;
+    FCeReadFile        ceReadFile;
+    FCeWriteFile       ceWriteFile;
+    FCeCloseHandle     ceCloseHandle;
+    FCeCreateDirectory ceCreateDirectory;
+    FCeDeleteFile      ceDeleteFile;
+    FCeFindFirstFile   ceFindFirstFile;
+    FCeFindNextFile    ceFindNextFile;
+    FCeFindClose       ceFindClose;
+  };
+
+  class CActiveSync::CRapiHandleDeleter {
+    const TDLLIface &_iface;
+  public:
+    using pointer = HANDLE;
+    CRapiHandleDeleter(const TDLLIface &iface) : _iface{iface} {}
+    CRapiHandleDeleter &operator =(const CRapiHandleDeleter &) = delete;
+    void operator ()(pointer handle) const { _iface.ceCloseHandle(handle); }
+  };
+
+  /**
+   * @brief Measures RAPI calls done in a scope.
+   */
+  class CActiveSync::CRoundTrip : CNonCopyable {
+    TStats &_stats;                                   ///< @brief Statistics to update.
+    const std::chrono::steady_clock::time_point _start; ///< @brief Scope start time.
+  public:
+    CRoundTrip(TStats &stats, unsigned calls = 1) : _stats(stats), _start{std::chrono::steady_clock::now()} { _stats.roundTrips += calls; }
+    ~CRoundTrip() { _stats.time += std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count(); }
+    void Add() { _stats.roundTrips++; }
+  };
+
+  /**
+   * @brief ActiveSync file data source.
+   */
+  class CActiveSync::CRemoteSource : public CTransfer::CSource {
+    const CActiveSync &_activeSync;                   ///< @brief ActiveSync connection.
+    const std::string _path;                          ///< @brief File path.
+    std::unique_ptr<HANDLE, CRapiHandleDeleter> _file;///< @brief File handle.
+    uint64_t _size;                                   ///< @brief File size.
+  public:
+    CRemoteSource(const CActiveSync &activeSync, const bfs::path &path);
+    uint64_t Size() const override { return _size; }
+    size_t Read(char *buffer, size_t size) override;
+  };
+
+  /**
+   * @brief ActiveSync file data sink.
+   */
+  class CActiveSync::CRemoteSink : public CTransfer::CSink {
+    const CActiveSync &_activeSync;                   ///< @brief ActiveSync connection.
+    const std::string _path;                          ///< @brief File path.
+    std::unique_ptr<HANDLE, CRapiHandleDeleter> _file;///< @brief File handle.
+  public:
+    CRemoteSink(const CActiveSync &activeSync, const bfs::path &path);
+    void Write(const char *data, size_t size) override;
+  };
+
+  void CActiveSync::CRapiDeleter::operator()(pointer status) const { _iface.ceRapiUninit(); }
+
+}
+
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CActiveSync::CBatch class constructor. Starts queuing directories
+ * creation and file writes. The first batch clears the session cache as the
+ * device could have been modified since the previous batch.
+ */
+condor2nav::CActiveSync::CBatch::CBatch()
+{
+  if(++batchLevel == 1 && instance)
+    instance->Drop();
+}
+
+
+/**
+ * @brief Class destructor.
+ *
+ * condor2nav::CActiveSync::CBatch class destructor. Operations not flushed
+ * are dropped and the session cache is cleared when the last batch is destroyed.
+ */
+condor2nav::CActiveSync::CBatch::~CBatch()
+{
+  if(--batchLevel == 0 && instance)
+    instance->Drop();
+}
+
+
+/**
+ * @brief Executes all queued operations.
+ *
+ * @exception EOperationFailed Thrown when an operation fails.
+ */
+void condor2nav::CActiveSync::CBatch::Flush()
+{
+  if(instance)
+    instance->Flush();
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CActiveSync::CRemoteSource class constructor. Opens the file
+ * on the target device.
+ *
+ * @param activeSync ActiveSync connection.
+ * @param path       Target file path.
+ *
+ * @exception EOperationFailed Thrown when the file cannot be opened.
+ */
+condor2nav::CActiveSync::CRemoteSource::CRemoteSource(const CActiveSync &activeSync, const bfs::path &path) :
+  _activeSync(activeSync), _path{path.string()}, _file{INVALID_HANDLE_VALUE, CRapiHandleDeleter{*activeSync._iface}}, _size{0}
+{
+  auto &iface = *_activeSync._iface;
+
+  // create, get size and close
+  CRoundTrip trip{_activeSync._stats, 3};
+  _file.reset(iface.ceCreateFile(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+  if(_file.get() == INVALID_HANDLE_VALUE) {
+    _file.release();
+    throw EOperationFailed{"ERROR: Unable to open ActiveSync file '" + _path + "'!!!"};
+  }
+
+  DWORD sizeHigh = 0;
+  const DWORD sizeLow = iface.ceGetFileSize(_file.get(), &sizeHigh);
+  if(sizeLow == INVALID_FILE_SIZE && iface.ceGetLastError() != NO_ERROR)
+    throw EOperationFailed{"ERROR: Unable to get the size of ActiveSync file '" + _path + "'!!!"};
+  _size = (static_cast<uint64_t>(sizeHigh) << 32) | sizeLow;
+}
+
+
+/**
+ * @brief Reads next data chunk from the file on the target device.
+ *
+ * @param buffer The buffer to fill.
+ * @param size   The size of the buffer.
+ *
+ * @return The number of bytes read (0 at the end of file).
+ *
+ * @exception EOperationFailed Thrown when the file cannot be read.
+ */
+size_t condor2nav::CActiveSync::CRemoteSource::Read(char *buffer, size_t size)
+{
+  CRoundTrip trip{_activeSync._stats};
+  DWORD numBytes;
+  if(!_activeSync._iface->ceReadFile(_file.get(), buffer, static_cast<DWORD>(size), &numBytes, nullptr))
+    throw EOperationFailed{"ERROR: Reading ActiveSync file '" + _path + "'!!!"};
+  return numBytes;
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CActiveSync::CRemoteSink class constructor. Creates the file
+ * on the target device.
+ *
+ * @param activeSync ActiveSync connection.
+ * @param path       Target file path.
+ *
+ * @exception EOperationFailed Thrown when the file cannot be created.
+ */
+condor2nav::CActiveSync::CRemoteSink::CRemoteSink(const CActiveSync &activeSync, const bfs::path &path) :
+  _activeSync(activeSync), _path{path.string()}, _file{INVALID_HANDLE_VALUE, CRapiHandleDeleter{*activeSync._iface}}
+{
+  // create and close
+  CRoundTrip trip{_activeSync._stats, 2};
+  _file.reset(_activeSync._iface->ceCreateFile(path.wstring().c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+  if(_file.get() == INVALID_HANDLE_VALUE) {
+    _file.release();
+    throw EOperationFailed{"ERROR: Unable to open ActiveSync file '" + _path + "'!!!"};
+  }
+}
+
+
+/**
+ * @brief Writes next data chunk to the file on the target device.
+ *
+ * @param data The data to write.
+ * @param size The size of the data.
+ *
+ * @exception EOperationFailed Thrown when the file cannot be written.
+ */
+void condor2nav::CActiveSync::CRemoteSink::Write(const char *data, size_t size)
+{
+  CRoundTrip trip{_activeSync._stats};
+  DWORD numBytes;
+  if(!_activeSync._iface->ceWriteFile(_file.get(), data, static_cast<DWORD>(size), &numBytes, nullptr) || numBytes != size)
+    throw EOperationFailed{"ERROR: Writing ActiveSync file '" + _path + "'!!!"};
+}
+
+
+/**
+ * @brief Returns singleton instance.
+ *
+ * Method returns singleton instance.
+ *
+ * @return Singleton instance.
+ */
+condor2nav::CActiveSync &condor2nav::CActiveSync::Instance()
+{
+  static CActiveSync instance;
+  return instance;
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CActiveSync class constructor.
+ */
+condor2nav::CActiveSync::CActiveSync() :
+  _lib{::LoadLibrary("rapi.dll")}, _iface{std::make_unique<TDLLIface>()}, _rapi{false, CRapiDeleter(*_iface)}, _stats(),
+  _transfer{std::make_unique<CTransfer>()}
+{
+  if(!_lib.get())
+    throw EOperationFailed{"ERROR: Couldn't open 'rapi.dll' library!!! Please check that ActiveSync is installed correctly."};
+  Symbol(_lib.get(), "CeRapiInitEx",      _iface->ceRapiInitEx);
+  Symbol(_lib.get(), "CeRapiUninit",      _iface->ceRapiUninit);
+  Symbol(_lib.get(), "CeGetLastError",    _iface->ceGetLastError);
+  Symbol(_lib.get(), "CeCreateFile",      _iface->ceCreateFile);
+  Symbol(_lib.get(), "CeGetFileSize",     _iface->ceGetFileSize);
+  Symbol(_lib.get(), "CeReadFile",        _iface->ceReadFile);
+  Symbol(_lib.get(), "CeWriteFile",       _iface->ceWriteFile);
+  Symbol(_lib.get(), "CeCloseHandle",     _iface->ceCloseHandle);
+  Symbol(_lib.get(), "CeCreateDirectory", _iface->ceCreateDirectory);
+  Symbol(_lib.get(), "CeDeleteFile",      _iface->ceDeleteFile);
+  Symbol(_lib.get(), "CeFindFirstFile",   _iface->ceFindFirstFile);
+  Symbol(_lib.get(), "CeFindNextFile",    _iface->ceFindNextFile);
+  Symbol(_lib.get(), "CeFindClose",       _iface->ceFindClose);
+
+  // init RAPI
+  RAPIINIT initData{};
+  initData.cbSize = sizeof(initData);
+
+  _rapi.reset(!FAILED(_iface->ceRapiInitEx(&initData)));
+  if(!_rapi.get())
+    throw EOperationFailed{"Cannot initialize ActiveSync connection!!!"};
+
+  HRESULT hr;
+  auto status = WaitForSingleObject(initData.heRapiInit, TIMEOUT);
+  if(status == WAIT_OBJECT_0) {
+    // heRapiInit signaled:
+    // set return error code to return value of RAPI Init function
+    hr = initData.hrRapiInit;  
+  }
+  else {
+    if(status == WAIT_TIMEOUT) {
+      // timed out: device is probably not connected
+      // or not responding
+      hr = HRESULT_FROM_WIN32(ERROR_TIMEOUT);
+    }
+    else {
+      // WaitForSingleObject failed
+      hr = HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    throw EOperationFailed{"ERROR: Cannot initialize ActiveSync interface!!!"};
+  }
+
+  instance = this;
+}
+
+
+/**
+ * @brief Checks if ActiveSync connection was established.
+ *
+ * @return @p true if condor2nav::CActiveSync::Instance() was successfully created.
+ */
+bool condor2nav::CActiveSync::Connected()
+{
+  return instance != nullptr;
+}
+
+
+/**
+ * @brief Returns RAPI usage statistics.
+ *
+ * @return Statistics collected since the last condor2nav::CActiveSync::StatsReset() call.
+ */
+condor2nav::CActiveSync::TStats condor2nav::CActiveSync::Stats() const
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  return _stats;
+}
+
+
+/**
+ * @brief Resets RAPI usage statistics.
+ */
+void condor2nav::CActiveSync::StatsReset()
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  _stats = TStats();
+}
+
+
+/**
+ * @brief Executes all queued operations.
+ *
+ * Operations are executed in the order they were queued. A file write is
+ * skipped if the same file is written again later in the queue. Session
+ * cache is cleared if any operation fails.
+ *
+ * @exception EOperationFailed Thrown when an operation fails.
+ */
+void condor2nav::CActiveSync::Flush() const
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  std::vector<TOperation> queue;
+  queue.swap(_queue);
+  try {
+    for(auto it = queue.cbegin(); it != queue.cend(); ++it) {
+      if(it->write) {
+        const auto &key = it->key;
+        if(std::any_of(std::next(it), queue.cend(), [&](const TOperation &op){ return op.write && op.key == key; })) {
+          // create, write and close
+          _stats.roundTripsSaved += 3;
+          continue;
+        }
+        WriteRemote(it->path, std::vector<boost::string_ref>{boost::string_ref{it->data}});
+      }
+      else {
+        DirectoryCreateRemote(it->path);
+      }
+    }
+  }
+  catch(...) {
+    _dirs.clear();
+    _files.clear();
+    throw;
+  }
+}
+
+
+/**
+ * @brief Drops all queued operations and clears the session cache.
+ *
+ * Session cache is cleared as it may contain the effects of dropped operations
+ * and the device could be modified outside of the session.
+ */
+void condor2nav::CActiveSync::Drop() const
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  _queue.clear();
+  _dirs.clear();
+  _files.clear();
+}
+
+
+/**
+ * @brief Reads whole file to a string.
+ *
+ * Method reads the file in chunks and removes all returns from it.
+ *
+ * @param src Target file path. 
+ * 
+ * @return String with file content. 
+ */
+std::string condor2nav::CActiveSync::Read(const bfs::path &src) const
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  Flush();
+
+  CRemoteSource source{*this, src};
+  std::string str;
+  str.reserve(static_cast<size_t>(source.Size()));
+  CStringSink sink{str};
+  _transfer->Run(source, sink, CTransfer::FProgress(), false);
+  return str;
+}
+
+
+/**
+ * @brief Writes buffers to a file on the target device immediately.
+ *
+ * Buffers bigger than condor2nav::CTransfer chunk size are split to chunks.
+ *
+ * @param dest Target file path. 
+ * @param buffers Buffers with file content. 
+ */
+void condor2nav::CActiveSync::WriteRemote(const bfs::path &dest, const std::vector<boost::string_ref> &buffers) const
+{
+  CRemoteSink sink{*this, dest};
+  const size_t chunkSize = _transfer->ChunkSize();
+  for(auto &buffer : buffers)
+    for(size_t offset = 0; offset < buffer.size(); offset += chunkSize)
+      sink.Write(buffer.data() + offset, std::min(chunkSize, buffer.size() - offset));
+}
+
+
+/**
+ * @brief Copies a local file to the target device.
+ *
+ * Local file is read in chunks while the previous chunk is being written to
+ * the target device.
+ *
+ * @param src      Local file path.
+ * @param dest     Target file path.
+ * @param progress Progress callback.
+ *
+ * @return The number of bytes copied.
+ *
+ * @exception EOperationFailed Thrown when a file cannot be read or written.
+ */
+uint64_t condor2nav::CActiveSync::Upload(const bfs::path &src, const bfs::path &dest, const FProgress &progress /* = FProgress() */) const
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  Flush();
+
+  CTransfer::CFileSource source{src};
+  const auto key = Key(dest);
+  _files.erase(key);
+  CRemoteSink sink{*this, dest};
+  _files[key] = true;
+  return _transfer->Run(source, sink, progress);
+}
+
+
+/**
+ * @brief Copies a file from the target device to a local file.
+ *
+ * @param src      Target file path.
+ * @param dest     Local file path.
+ * @param progress Progress callback.
+ *
+ * @return The number of bytes copied.
+ *
+ * @exception EOperationFailed Thrown when a file cannot be read or written.
+ */
+uint64_t condor2nav::CActiveSync::Download(const bfs::path &src, const bfs::path &dest, const FProgress &progress /* = FProgress() */) const
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  Flush();
+
+  CRemoteSource source{*this, src};
+  CTransfer::CFileSink sink{dest};
+  return _transfer->Run(source, sink, progress, false);
+}
+
+
+/**
+ * @brief Writes buffers to a file on the target device.
+ *
+ * Method writes buffers to a file on the target device. The data is copied
+ * and the write is queued if condor2nav::CActiveSync::CBatch exists.
+ *
+ * @param dest Target file path. 
+ * @param buffers Buffers with file content. 
+ */
+void condor2nav::CActiveSync::Write(const bfs::path &dest, const std::vector<boost::string_ref> &buffers) const
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  auto key = Key(dest);
+  if(batchLevel) {
+    _queue.push_back(TOperation{true, dest.wstring(), key, std::string{}});
+    auto &data = _queue.back().data;
+    size_t size = 0;
+    for(auto &buffer : buffers)
+      size += buffer.size();
+    data.reserve(size);
+    for(auto &buffer : buffers)
+      data.append(buffer.data(), buffer.size());
+  }
+  else {
+    WriteRemote(dest, buffers);
+  }
+  _files[key] = true;
+}
+
+
+/**
+ * @brief Removes a file from the target device.
+ *
+ * Method removes a file from the target device.
+ *
+ * @param path Target file path.
+ *
+ * @return @p false if file did not exist.
+ */
+bool condor2nav::CActiveSync::Remove(const bfs::path &path) const
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  Flush();
+
+  const auto key = Key(path);
+  CRoundTrip trip{_stats};
+  if(!_iface->ceDeleteFile(path.wstring().c_str())) {
+    if(_iface->ceGetLastError() == ERROR_FILE_NOT_FOUND) {
+      _files[key] = false;
+      return false;
+    }
+    throw EOperationFailed{"ERROR: Removing ActiveSync file '" + path.string() + "'!!!"};
+  }
+  _files[key] = false;
+  return true;
+}
+
+
+/**
+ * @brief Creates directory on the target device immediately.
+ *
+ * @param path Target directory path. 
+ */
+void condor2nav::CActiveSync::DirectoryCreateRemote(const bfs::path &path) const
+{
+  CRoundTrip trip{_stats};
+  if(!_iface->ceCreateDirectory(path.wstring().c_str(), nullptr) && _iface->ceGetLastError() != ERROR_ALREADY_EXISTS)
+    throw EOperationFailed{"ERROR: Creating ActiveSync directory '" + path.string() + "'!!!"};
+}
+
+
+/**
+ * @brief Creates directory on the target device.
+ *
+ * Method creates directory together with all its parent directories except
+ * the top level ones (i.e. storage cards). Directories created or already
+ * created during the session are not created again. Creation is queued if
+ * condor2nav::CActiveSync::CBatch exists.
+ *
+ * @param path Target directory path. 
+ */
+void condor2nav::CActiveSync::DirectoryCreate(const bfs::path &path) const
+{
+  const auto parent = path.parent_path();
+  if(parent.empty() || parent == "\\")
+    return;
+
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  auto key = Key(path);
+  if(_dirs.count(key)) {
+    _stats.roundTripsSaved++;
+    return;
+  }
+  DirectoryCreate(parent);
+  if(batchLevel)
+    _queue.push_back(TOperation{false, path.wstring(), key, std::string{}});
+  else
+    DirectoryCreateRemote(path);
+  _dirs.insert(key);
+}
+
+
+/**
+ * @brief Checks if a file exists on the target device.
+ *
+ * Method checks if a file exists on the target device.
+ *
+ * @param path Target file path.
+ *
+ * @return @p true if file exists.
+ */
+bool condor2nav::CActiveSync::FileExists(const bfs::path &path) const
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  const auto key = Key(path);
+  const auto it = _files.find(key);
+  if(it != _files.end()) {
+    _stats.roundTripsSaved++;
+    return it->second;
+  }
+
+  // create and close
+  CRoundTrip trip{_stats, 2};
+  std::unique_ptr<HANDLE, CRapiHandleDeleter> hDest{_iface->ceCreateFile(path.wstring().c_str(),
+                                                                         GENERIC_READ,
+                                                                         FILE_SHARE_READ,
+                                                                         nullptr,
+                                                                         OPEN_EXISTING,
+                                                                         FILE_ATTRIBUTE_NORMAL,
+                                                                         nullptr),
+                                                    CRapiHandleDeleter{*_iface}};
+  if(hDest.get() == INVALID_HANDLE_VALUE) {
+    if(_iface->ceGetLastError() == ERROR_FILE_NOT_FOUND) {
+      _files[key] = false;
+      return false;
+    }
+    throw EOperationFailed{"ERROR: Unable to check if file '" + path.string() + "' exists!!!"};
+  }
+  _files[key] = true;
+  return true;
+}
+
+
+/**
+ * @brief Returns file information.
+ *
+ * Method obtains information about a file on the target device.
+ *
+ * @param path             Target file path.
+ * @param [out] attributes File attributes.
+ * @param [out] size       File size.
+ * @param [out] time       File last write time.
+ *
+ * @return @p false if file does not exist.
+ */
+bool condor2nav::CActiveSync::Stat(const bfs::path &path, DWORD &attributes, uint64_t &size, FILETIME &time) const
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  const auto it = _files.find(Key(path));
+  if(it != _files.end() && !it->second) {
+    _stats.roundTripsSaved++;
+    return false;
+  }
+  Flush();
+
+  // find and close
+  CRoundTrip trip{_stats, 2};
+  CE_FIND_DATA data;
+  HANDLE find = _iface->ceFindFirstFile(path.wstring().c_str(), &data);
+  if(find == INVALID_HANDLE_VALUE) {
+    const auto error = _iface->ceGetLastError();
+    if(error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND || error == ERROR_NO_MORE_FILES)
+      return false;
+    throw EOperationFailed{"ERROR: Unable to obtain information about '" + path.string() + "'!!!"};
+  }
+  _iface->ceFindClose(find);
+
+  attributes = data.dwFileAttributes;
+  size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+  time = data.ftLastWriteTime;
+  return true;
+}
+
+
+/**
+ * @brief Lists directory content.
+ *
+ * Method returns all the entries of a directory on the target device.
+ *
+ * @param path Target directory path.
+ *
+ * @return Paths of directory entries.
+ */
+std::vector<bfs::path> condor2nav::CActiveSync::List(const bfs::path &path) const
+{
+  std::lock_guard<std::recursive_mutex> lock{_mutex};
+  Flush();
+
+  // find and close
+  CRoundTrip trip{_stats, 2};
+  std::vector<bfs::path> entries;
+  CE_FIND_DATA data;
+  HANDLE find = _iface->ceFindFirstFile((path / "*").wstring().c_str(), &data);
+  if(find == INVALID_HANDLE_VALUE) {
+    if(_iface->ceGetLastError() == ERROR_NO_MORE_FILES)
+      return entries;
+    throw EOperationFailed{"ERROR: Unable to list ActiveSync directory '" + path.string() + "'!!!"};
+  }
+  do {
+    const std::wstring name{data.cFileName};
+    if(name != L"." && name != L"..")
+      entries.emplace_back(path / name);
+    trip.Add();
+  } while(_iface->ceFindNextFile(find, &data));
+  _iface->ceFindClose(find);
+  return entries;
+}
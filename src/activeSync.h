@@ -1,78 +1,160 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
- * @file activeSync.h
- *
- * @brief Declares the ActiveSync wrapper class. 
- */
-
-#ifndef __ACTIVESYNC_H__
-#define __ACTIVESYNC_H__
-
-#include "nonCopyable.h"
-#include "tools.h"
-#include "boostfwd.h"
-#include <functional>
-
-
-namespace condor2nav {
-
-  /**
-   * @brief ActiveSync interface wrapper
-   *
-   * condor2nav::CActiveSync class is a wrapper around ActiveSync interface.
-   * It uses RAPI interface to communicate with remote device.
-   *
-   * @note Singleton design pattern
-   */
-  class CActiveSync : CNonCopyable {
-    struct TDLLIface;
-    class CRapiHandleDeleter;
-
-    class CRapiDeleter {
-      const TDLLIface &_iface;
-    public:
-      using pointer = bool;
-      CRapiDeleter(const TDLLIface &iface) : _iface{iface} {}
-      CRapiDeleter &operator =(const CRapiDeleter &) = delete;
-      void operator ()(pointer status) const;
-    };
-    using CRapiRes = std::unique_ptr<bool, CRapiDeleter>;
-
-    static const unsigned TIMEOUT = 5000;             ///< @brief Timeout in ms for ActiveSync initialization. 
-
-    CLibraryRes _lib;                                 ///< @brief DLL instance. 
-    std::unique_ptr<TDLLIface> _iface;	              ///< @brief DLL interface.
-    CRapiRes _rapi;                                   ///< @brief RAPI RAII wrapper. 
-
-    CActiveSync();
-  public:
-    static CActiveSync &Instance();
-    std::string Read(const bfs::path &src) const;
-    void Write(const bfs::path &dest, const std::string &buffer) const;
-    void DirectoryCreate(const bfs::path &path) const;
-    bool FileExists(const bfs::path &path) const;
-  };
-
-}
-
-#endif /* __ACTIVESYNC_H__ */
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file activeSync.h
+ *
+ * @brief Declares the ActiveSync wrapper class. 
+ */
+
+#ifndef __ACTIVESYNC_H__
+#define __ACTIVESYNC_H__
+
+#include "nonCopyable.h"
+#include "tools.h"
+#include "boostfwd.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace condor2nav {
+
+  class CTransfer;
+
+  /**
+   * @brief ActiveSync interface wrapper
+   *
+   * condor2nav::CActiveSync class is a wrapper around ActiveSync interface.
+   * It uses RAPI interface to communicate with remote device. Every RAPI call
+   * is a round trip to the device so the class remembers the directories and
+   * files known to exist during the session (one translation batch). While
+   * condor2nav::CActiveSync::CBatch exists directories creation and file writes
+   * are queued and executed in order when the batch is flushed. Files are read
+   * and written in chunks of a constant size with condor2nav::CTransfer.
+   *
+   * @note Singleton design pattern
+   */
+  class CActiveSync : CNonCopyable {
+  public:
+    /**
+     * @brief Progress callback (the same as condor2nav::CTransfer::FProgress).
+     *
+     * @param done  The number of bytes already transferred.
+     * @param total The number of bytes to transfer.
+     */
+    using FProgress = std::function<void(uint64_t done, uint64_t total)>;
+
+    /**
+     * @brief RAPI usage statistics.
+     */
+    struct TStats {
+      unsigned roundTrips;                            ///< @brief The number of RAPI calls done.
+      unsigned roundTripsSaved;                       ///< @brief The number of RAPI calls avoided by the session cache and batching.
+      double time;                                    ///< @brief Time spent in RAPI calls in seconds.
+    };
+
+    /**
+     * @brief Batch of ActiveSync operations.
+     *
+     * While the batch exists directories creation and file writes are only
+     * queued. condor2nav::CActiveSync::CBatch::Flush() executes them in order.
+     * Operations not flushed are dropped when the batch is destroyed. The session
+     * cache is cleared when the outermost batch is created and destroyed so every
+     * translation starts with a fresh view of the device.
+     */
+    class CBatch : CNonCopyable {
+    public:
+      CBatch();
+      ~CBatch();
+      void Flush();
+    };
+
+  private:
+    struct TDLLIface;
+    class CRapiHandleDeleter;
+    class CRoundTrip;
+    class CRemoteSource;
+    class CRemoteSink;
+
+    class CRapiDeleter {
+      const TDLLIface &_iface;
+    public:
+      using pointer = bool;
+      CRapiDeleter(const TDLLIface &iface) : _iface{iface} {}
+      CRapiDeleter &operator =(const CRapiDeleter &) = delete;
+      void operator ()(pointer status) const;
+    };
+    using CRapiRes = std::unique_ptr<bool, CRapiDeleter>;
+
+    /**
+     * @brief Queued operation.
+     */
+    struct TOperation {
+      bool write;                                     ///< @brief File write if true, directory creation otherwise.
+      std::wstring path;                              ///< @brief Target path.
+      std::wstring key;                               ///< @brief Target path in upper case.
+      std::string data;                               ///< @brief Data to write.
+    };
+
+    static const unsigned TIMEOUT = 5000;             ///< @brief Timeout in ms for ActiveSync initialization. 
+
+    CLibraryRes _lib;                                 ///< @brief DLL instance. 
+    std::unique_ptr<TDLLIface> _iface;	              ///< @brief DLL interface.
+    CRapiRes _rapi;                                   ///< @brief RAPI RAII wrapper. 
+
+    mutable std::recursive_mutex _mutex;              ///< @brief Session state access synchronization.
+    mutable std::set<std::wstring> _dirs;             ///< @brief Directories known to exist (upper case).
+    mutable std::map<std::wstring, bool> _files;      ///< @brief Files known to exist or not (upper case).
+    mutable std::vector<TOperation> _queue;           ///< @brief Operations queued in a batch.
+    mutable TStats _stats;                            ///< @brief RAPI usage statistics.
+    std::unique_ptr<CTransfer> _transfer;             ///< @brief Reusable transfer buffers.
+
+    CActiveSync();
+    void WriteRemote(const bfs::path &dest, const std::vector<boost::string_ref> &buffers) const;
+    void DirectoryCreateRemote(const bfs::path &path) const;
+    void Flush() const;
+    void Drop() const;
+
+  public:
+    static CActiveSync &Instance();
+    static bool Connected();
+    std::string Read(const bfs::path &src) const;
+    void Write(const bfs::path &dest, const std::vector<boost::string_ref> &buffers) const;
+    uint64_t Upload(const bfs::path &src, const bfs::path &dest, const FProgress &progress = FProgress()) const;
+    uint64_t Download(const bfs::path &src, const bfs::path &dest, const FProgress &progress = FProgress()) const;
+    bool Remove(const bfs::path &path) const;
+    void DirectoryCreate(const bfs::path &path) const;
+    bool FileExists(const bfs::path &path) const;
+    bool Stat(const bfs::path &path, DWORD &attributes, uint64_t &size, FILETIME &time) const;
+    std::vector<bfs::path> List(const bfs::path &path) const;
+    TStats Stats() const;
+    void StatsReset();
+  };
+
+}
+
+#endif /* __ACTIVESYNC_H__ */
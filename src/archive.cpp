@@ -0,0 +1,331 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file archive.cpp
+ *
+ * @brief Implements the condor2nav::CArchive class.
+ */
+
+#include "archive.h"
+#include "hashTable.h"
+#include "tools.h"
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+
+namespace {
+
+  const size_t TAR_BLOCK = 512;                      ///< @brief TAR block size.
+
+  /**
+   * @brief Appends little endian integer to the header.
+   */
+  void Put16(std::string &header, unsigned value)
+  {
+    header += static_cast<char>(value & 0xFF);
+    header += static_cast<char>((value >> 8) & 0xFF);
+  }
+
+  void Put32(std::string &header, uint32_t value)
+  {
+    Put16(header, value & 0xFFFF);
+    Put16(header, value >> 16);
+  }
+
+  /**
+   * @brief CRC-32 lookup table.
+   *
+   * Built during static initialization so it is ready before any thread uses it.
+   */
+  const std::array<uint32_t, 256> CRC_TABLE = []() -> std::array<uint32_t, 256> {
+    std::array<uint32_t, 256> table;
+    for(uint32_t i=0; i<256; i++) {
+      uint32_t c = i;
+      for(unsigned k=0; k<8; k++)
+        c = c & 1 ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+      table[i] = c;
+    }
+    return table;
+  }();
+
+  /**
+   * @brief Converts time to MS-DOS date and time used in ZIP headers.
+   *
+   * MS-DOS times are local times.
+   */
+  void DosTime(std::time_t time, unsigned &dosDate, unsigned &dosTime)
+  {
+    std::tm tm;
+    if(localtime_s(&tm, &time) || tm.tm_year < 80) {
+      dosDate = (1 << 5) | 1;
+      dosTime = 0;
+      return;
+    }
+    dosDate = ((tm.tm_year - 80) << 9) | ((tm.tm_mon + 1) << 5) | tm.tm_mday;
+    dosTime = (tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2);
+  }
+
+  /**
+   * @brief Writes octal number to the TAR header field.
+   */
+  void PutOctal(char *field, size_t size, uint64_t value)
+  {
+    std::sprintf(field, "%0*llo", static_cast<int>(size - 1), static_cast<unsigned long long>(value));
+  }
+
+}
+
+
+/**
+ * @brief Returns the archive format for the file name.
+ *
+ * @param path The path of the archive.
+ *
+ * @return ZIP for '.zip' files and TAR for '.tar' ones.
+ *
+ * @exception EOperationFailed Thrown for not supported extension.
+ */
+condor2nav::CArchive::TFormat condor2nav::CArchive::Format(const bfs::path &path)
+{
+  auto ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(), [](char c){ return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+  if(ext == ".zip")
+    return TFormat::ZIP;
+  if(ext == ".tar")
+    return TFormat::TAR;
+  throw EOperationFailed{"ERROR: Unsupported archive type '" + path.string() + "' (only .zip and .tar are supported)!!!"};
+}
+
+
+/**
+ * @brief Calculates CRC-32 of the data.
+ *
+ * @param buffers The data.
+ *
+ * @return CRC-32 (IEEE 802.3) checksum.
+ */
+uint32_t condor2nav::CArchive::Crc32(const std::vector<boost::string_ref> &buffers)
+{
+  uint32_t crc = 0xFFFFFFFFU;
+  for(auto &buffer : buffers)
+    for(auto c : buffer)
+      crc = CRC_TABLE[(crc ^ static_cast<unsigned char>(c)) & 0xFF] ^ (crc >> 8);
+  return crc ^ 0xFFFFFFFFU;
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CArchive class constructor.
+ *
+ * @param format Archive format.
+ * @param time   Modification time stored for all the entries.
+ */
+condor2nav::CArchive::CArchive(TFormat format, std::time_t time) :
+  _format{format}, _time{time}
+{
+}
+
+
+/**
+ * @brief Adds an entry to the archive.
+ *
+ * @param name    Entry name (with '/' separators).
+ * @param buffers Entry data (has to be valid until the archive is written).
+ */
+void condor2nav::CArchive::Add(std::string name, std::vector<boost::string_ref> buffers)
+{
+  uint64_t size = 0;
+  for(auto &buffer : buffers)
+    size += buffer.size();
+  TEntry entry;
+  entry.name = std::move(name);
+  entry.buffers = std::move(buffers);
+  entry.size = size;
+  _entries.push_back(entry);
+}
+
+
+/**
+ * @brief Returns the hash of the archive content.
+ *
+ * Hash covers entries names and data but not the modification time so it may
+ * be used to detect if the archive content changed.
+ *
+ * @return XXH64 hash.
+ */
+uint64_t condor2nav::CArchive::ContentHash() const
+{
+  CHashXXH64 hash;
+  for(auto &entry : _entries) {
+    hash.Update(boost::string_ref{entry.name.c_str(), entry.name.size() + 1});
+    for(auto &buffer : entry.buffers)
+      hash.Update(buffer);
+  }
+  return hash.Digest();
+}
+
+
+/**
+ * @brief Lays out ZIP archive.
+ *
+ * @param [out] buffers Archive buffers.
+ */
+void condor2nav::CArchive::ZipLayout(std::vector<boost::string_ref> &buffers)
+{
+  unsigned dosDate, dosTime;
+  DosTime(_time, dosDate, dosTime);
+
+  std::string directory;
+  uint64_t offset = 0;
+  for(auto &entry : _entries) {
+    if(entry.size > 0xFFFFFFFEU || offset > 0xFFFFFFFEU || entry.name.size() > 0xFFFF)
+      throw EOperationFailed{"ERROR: Archive entry '" + entry.name + "' is too big!!!"};
+    const uint32_t crc = Crc32(entry.buffers);
+    const auto size = static_cast<uint32_t>(entry.size);
+    const auto nameSize = static_cast<unsigned>(entry.name.size());
+
+    _headers.emplace_back();
+    std::string &local = _headers.back();
+    Put32(local, 0x04034B50);                         // local file header signature
+    Put16(local, 10);                                 // version needed to extract
+    Put16(local, 0);                                  // flags
+    Put16(local, 0);                                  // compression method (stored)
+    Put16(local, dosTime);
+    Put16(local, dosDate);
+    Put32(local, crc);
+    Put32(local, size);                               // compressed size
+    Put32(local, size);                               // uncompressed size
+    Put16(local, nameSize);
+    Put16(local, 0);                                  // extra field length
+    local += entry.name;
+
+    Put32(directory, 0x02014B50);                     // central directory header signature
+    Put16(directory, 20);                             // version made by
+    Put16(directory, 10);                             // version needed to extract
+    Put16(directory, 0);                              // flags
+    Put16(directory, 0);                              // compression method (stored)
+    Put16(directory, dosTime);
+    Put16(directory, dosDate);
+    Put32(directory, crc);
+    Put32(directory, size);                           // compressed size
+    Put32(directory, size);                           // uncompressed size
+    Put16(directory, nameSize);
+    Put16(directory, 0);                              // extra field length
+    Put16(directory, 0);                              // comment length
+    Put16(directory, 0);                              // disk number start
+    Put16(directory, 0);                              // internal attributes
+    Put32(directory, 0);                              // external attributes
+    Put32(directory, static_cast<uint32_t>(offset));  // local header offset
+    directory += entry.name;
+
+    buffers.push_back(local);
+    buffers.insert(buffers.end(), entry.buffers.begin(), entry.buffers.end());
+    offset += local.size() + entry.size;
+  }
+
+  if(_entries.size() > 0xFFFF || offset > 0xFFFFFFFEU)
+    throw EOperationFailed{"ERROR: Archive is too big!!!"};
+  const auto entries = static_cast<unsigned>(_entries.size());
+  Put32(directory, 0x06054B50);                       // end of central directory signature
+  Put16(directory, 0);                                // number of this disk
+  Put16(directory, 0);                                // disk with the central directory
+  Put16(directory, entries);                          // entries on this disk
+  Put16(directory, entries);                          // total entries
+  Put32(directory, static_cast<uint32_t>(directory.size() - 12));   // central directory size
+  Put32(directory, static_cast<uint32_t>(offset));    // central directory offset
+  Put16(directory, 0);                                // comment length
+  _headers.push_back(std::move(directory));
+  buffers.push_back(_headers.back());
+}
+
+
+/**
+ * @brief Lays out TAR archive.
+ *
+ * @param [out] buffers Archive buffers.
+ */
+void condor2nav::CArchive::TarLayout(std::vector<boost::string_ref> &buffers)
+{
+  static const char zeros[2 * TAR_BLOCK] = { 0 };
+  for(auto &entry : _entries) {
+    std::string name = entry.name;
+    std::string prefix;
+    if(name.size() > 100) {
+      // split long names into ustar prefix and name
+      const auto pos = name.rfind('/', 155);
+      if(pos == std::string::npos || name.size() - pos - 1 > 100)
+        throw EOperationFailed{"ERROR: Archive entry name '" + entry.name + "' is too long!!!"};
+      prefix = name.substr(0, pos);
+      name = name.substr(pos + 1);
+    }
+
+    _headers.emplace_back(TAR_BLOCK, '\0');
+    std::string &header = _headers.back();
+    char *h = &header[0];
+    memcpy(h, name.data(), name.size());
+    PutOctal(h + 100, 8, 0644);                       // mode
+    PutOctal(h + 108, 8, 0);                          // uid
+    PutOctal(h + 116, 8, 0);                          // gid
+    PutOctal(h + 124, 12, entry.size);                // size
+    PutOctal(h + 136, 12, static_cast<uint64_t>(_time));   // mtime
+    h[156] = '0';                                     // regular file
+    memcpy(h + 257, "ustar", 6);
+    memcpy(h + 263, "00", 2);
+    memcpy(h + 345, prefix.data(), prefix.size());
+
+    memset(h + 148, ' ', 8);
+    unsigned checksum = 0;
+    for(auto c : header)
+      checksum += static_cast<unsigned char>(c);
+    PutOctal(h + 148, 7, checksum);
+
+    buffers.push_back(header);
+    buffers.insert(buffers.end(), entry.buffers.begin(), entry.buffers.end());
+    const size_t padding = static_cast<size_t>((TAR_BLOCK - entry.size % TAR_BLOCK) % TAR_BLOCK);
+    if(padding)
+      buffers.emplace_back(zeros, padding);
+  }
+  buffers.emplace_back(zeros, sizeof(zeros));
+}
+
+
+/**
+ * @brief Returns the whole archive.
+ *
+ * @return Archive buffers to be written in order.
+ */
+std::vector<boost::string_ref> condor2nav::CArchive::Buffers()
+{
+  std::vector<boost::string_ref> buffers;
+  _headers.clear();
+  if(_format == TFormat::ZIP)
+    ZipLayout(buffers);
+  else
+    TarLayout(buffers);
+  return buffers;
+}
@@ -0,0 +1,91 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file archive.h
+ *
+ * @brief Declares the condor2nav::CArchive class.
+ */
+
+#ifndef __ARCHIVE_H__
+#define __ARCHIVE_H__
+
+#include "nonCopyable.h"
+#include "boostfwd.h"
+#include <boost/utility/string_ref.hpp>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace condor2nav {
+
+  /**
+   * @brief Uncompressed archive builder.
+   *
+   * condor2nav::CArchive lays out many files in one ZIP (stored entries) or
+   * TAR (ustar) archive. Content of all the entries is known up front so all
+   * the headers and the ZIP central directory are precomputed and the archive
+   * is returned as a list of buffers that may be written sequentially with
+   * one write. Entries data is not copied.
+   */
+  class CArchive : CNonCopyable {
+  public:
+    /**
+     * @brief Archive formats.
+     */
+    enum class TFormat {
+      ZIP,                                            ///< @brief ZIP archive with stored (not compressed) entries.
+      TAR                                             ///< @brief POSIX ustar archive.
+    };
+
+  private:
+    /**
+     * @brief Archive entry.
+     */
+    struct TEntry {
+      std::string name;                               ///< @brief Entry name.
+      std::vector<boost::string_ref> buffers;         ///< @brief Entry data.
+      uint64_t size;                                  ///< @brief Entry data size.
+    };
+
+    const TFormat _format;                            ///< @brief Archive format.
+    const std::time_t _time;                          ///< @brief Modification time of all the entries.
+    std::vector<TEntry> _entries;                     ///< @brief Archive entries.
+    std::deque<std::string> _headers;                 ///< @brief Headers referenced by the archive buffers.
+
+    void ZipLayout(std::vector<boost::string_ref> &buffers);
+    void TarLayout(std::vector<boost::string_ref> &buffers);
+
+  public:
+    static TFormat Format(const bfs::path &path);
+    static uint32_t Crc32(const std::vector<boost::string_ref> &buffers);
+
+    CArchive(TFormat format, std::time_t time);
+    void Add(std::string name, std::vector<boost::string_ref> buffers);
+    uint64_t ContentHash() const;
+    std::vector<boost::string_ref> Buffers();
+  };
+
+}
+
+#endif /* __ARCHIVE_H__ */
@@ -1,41 +1,41 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
- * @file boostfwd.h
- *
- * @brief Boost forward declarations.
- */
-
-#ifndef __BOOSTFWD_H__
-#define __BOOSTFWD_H__
-
-namespace boost {
-  namespace filesystem {
-
-    class path;
-
-  }
-}
-
-namespace bfs = boost::filesystem;
-
-#endif /* __BOOSTFWD_H__ */
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file boostfwd.h
+ *
+ * @brief Boost forward declarations.
+ */
+
+#ifndef __BOOSTFWD_H__
+#define __BOOSTFWD_H__
+
+namespace boost {
+  namespace filesystem {
+
+    class path;
+
+  }
+}
+
+namespace bfs = boost::filesystem;
+
+#endif /* __BOOSTFWD_H__ */
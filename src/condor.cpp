@@ -1,247 +1,911 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
- * @file condor.cpp
- *
- * @brief Implements the condor2nav::CCondor class. 
- */
-
-#include "condor.h"
-#include "traitsNoCase.h"
-#include "tools.h"
-#include <iomanip>
-#include <algorithm>
-#include <cmath>
-
-namespace {
-
-  const bfs::path FLIGHT_PLANS_PATH = "FlightPlans\\User";
-  const bfs::path RACE_RESULTS_PATH = "RaceResults";
-
-  // NaviCon.dll interface
-  using FNaviConInit = int(WINAPI*)(const char *trnFile);
-  using FXYToLon = float(WINAPI*)(float X, float Y);
-  using FXYToLat = float(WINAPI*)(float X, float Y);
-  using FGetMaxX = float(WINAPI*)();
-  using FGetMaxY = float(WINAPI*)();
-
-
-  template<typename SYMBOL_TYPE>
-  inline void Symbol(const HMODULE &module, const std::string &name, SYMBOL_TYPE &out)
-  {
-    SYMBOL_TYPE sym = reinterpret_cast<SYMBOL_TYPE>(GetProcAddress(module, name.c_str()));
-    if(!sym)
-      throw condor2nav::EOperationFailed{"ERROR: Couldn't map " + name + "() from 'NaviCon.dll'!!!"};
-    out = sym;
-  }
-
-}
-
-namespace condor2nav {
-
-  /**
-  * @brief NaviCon.dll interface.
-  */
-  struct CCondor::CCoordConverter::TDLLIface {
-    FNaviConInit naviConInit;
-    FGetMaxX     getMaxX;
-    FGetMaxY     getMaxY;
-    FXYToLon     xyToLon;
-    FXYToLat     xyToLat;
-  };
-
-}
-
-/* ******************** C O N D O R   -   C O O R D   C O N V E R T E R ********************* */
-
-/**
- * @brief Class constructor
- *
- * condor2nav::CCondor::CCoordConverter class constructor that connects to 
- * NaviCon.dll library interface and initializes it with current terrain file.
- *
- * @param condorPath The path to Condor directory
- * @param trnName The name of the terrain used in task
- */
-condor2nav::CCondor::CCoordConverter::CCoordConverter(const bfs::path &condorPath, const std::string &trnName) :
-  _iface{std::make_unique<TDLLIface>()}, _lib{::LoadLibrary((condorPath / "NaviCon.dll").string().c_str())}
-{
-  if(!_lib.get())
-    throw EOperationFailed{"ERROR: Couldn't open 'NaviCon.dll' from Condor directory '" + condorPath.string() + "'!!!"};
-  
-  Symbol(_lib.get(), "NaviConInit", _iface->naviConInit);
-  Symbol(_lib.get(), "GetMaxX",     _iface->getMaxX);
-  Symbol(_lib.get(), "GetMaxY",     _iface->getMaxY);
-  Symbol(_lib.get(), "XYToLon",     _iface->xyToLon);
-  Symbol(_lib.get(), "XYToLat",     _iface->xyToLat);
-
-  // init coordinates
-  auto trnPath = condorPath / "Landscapes" / trnName / (trnName + ".trn");
-  _iface->naviConInit(trnPath.string().c_str());
-}
-
-
-/**
-* @brief Class constructor
-*
-* NOTE: Destructor definition is needed here to make sure that TDLLIface is defined.
-*/
-condor2nav::CCondor::CCoordConverter::~CCoordConverter()
-{
-}
-
-
-/**
- * @brief Converts Condor coordinates to longitude.
- *
- * Method converts Condor coordinates to a double longitude value.
- * 
- * @param x The x coordinate.
- * @param y The y coordinate. 
- *
- * @return Converted double longitude value.
- */
-condor2nav::TLongitude condor2nav::CCondor::CCoordConverter::Longitude(const std::string &x, const std::string &y) const
-{
-  auto xVal = Convert<float>(x);
-  auto yVal = Convert<float>(y);
-  auto lon = _iface->xyToLon(xVal, yVal);
-  auto deg = static_cast<int>(lon);
-  auto min = static_cast<int>(floor((lon - deg) * 60.0 * 1000 + 0.5)) / static_cast<double>(1000.0);
-  return TLongitude{deg + min / 60};
-}
-
-
-/**
- * @brief Converts Condor coordinates to double latitude value.
- *
- * Method converts Condor coordinates to latitude.
- * 
- * @param x The x coordinate.
- * @param y The y coordinate. 
- *
- * @return Converted double latitude value.
- */
-condor2nav::TLatitude condor2nav::CCondor::CCoordConverter::Latitude(const std::string &x, const std::string &y) const
-{
-  auto xVal = Convert<float>(x);
-  auto yVal = Convert<float>(y);
-  auto lat = _iface->xyToLat(xVal, yVal);
-  auto deg = static_cast<int>(lat);
-  auto min = static_cast<int>(floor((lat - deg) * 60.0 * 1000 + 0.5)) / static_cast<double>(1000.0);
-  return TLatitude{deg + min / 60};
-}
-
-
-
-
-/* ************************************* C O N D O R **************************************** */
-
-
-/**
- * @brief Class constructor. 
- *
- * condor2nav::CCondor class constructor.
- * 
- * @param condorPath Full pathname of the Condor directory. 
- * @param fplPath    Condor FPL file to convert path
- *
- * @exception std Thrown when not supported Condor version.
- */
-condor2nav::CCondor::CCondor(const bfs::path &condorPath, const bfs::path &fplPath):
-_taskParser{fplPath},
-_coordConverter{condorPath, _taskParser.Value("Task", "Landscape")}
-{
-  if(Convert<unsigned>(_taskParser.Value("Version", "Condor version")) < CONDOR_VERSION_SUPPORTED)
-    throw EOperationFailed{"Condor vesion '" + _taskParser.Value("Version", "Condor version") + "' not supported!!!"};
-}
-
-
-
-/**
-* @brief Returns a path to Condor: The Competition Soaring Simulator
-*
-* Method returns a path to Condor: The Competition Soaring Simulator.
-*
-* @return Path to Condor: The Competition Soaring Simulator
-*/
-bfs::path condor2nav::condor::InstallPath()
-{
-  HKEY hTestKey;
-  if((RegOpenKeyEx(HKEY_CURRENT_USER, "Software\\Condor", 0, KEY_READ, &hTestKey)) == ERROR_SUCCESS) {
-    DWORD bufferSize = 0;
-    RegQueryValueEx(hTestKey, "InstallDir", nullptr, nullptr, nullptr, &bufferSize);
-    auto buffer = std::make_unique<char[]>(bufferSize);
-    RegQueryValueEx(hTestKey, "InstallDir", nullptr, nullptr, reinterpret_cast<BYTE *>(buffer.get()), &bufferSize);
-    bfs::path condorPath{buffer.get()};
-    RegCloseKey(hTestKey);
-    return condorPath;
-  }
-  else
-    throw EOperationFailed{"ERROR: Condor installation not found!!!"};
-}
-
-
-/**
-* @brief Returns FPL file path.
-*
-* Method returns FPL file path.
-*
-* @param configParser     The INI file configuration parser.
-* @param fplType          Type of the FPL file.
-* @param condorPath       Full pathname of the Condor: The Competition Soaring Simulator.
-*
-* @exception std::runtime_error Thrown when FPL file cannot be found.
-*
-* @return Full pathname of the FPL file.
-*/
-bfs::path condor2nav::condor::FPLPath(const CFileParserINI &configParser,
-                                       CCondor2Nav::TFPLType fplType,
-                                       const bfs::path &condorPath)
-{
-  bfs::path fplPath;
-  if(fplType == CCondor2Nav::TFPLType::DEFAULT) {
-    auto fplPathUser = bfs::path{configParser.Value("Condor", "FlightPlansPath")};
-    if(fplPathUser.empty())
-      fplPath = condorPath / FLIGHT_PLANS_PATH / (configParser.Value("Condor", "DefaultTaskName") + ".fpl");
-    else
-      fplPath = fplPathUser / (configParser.Value("Condor", "DefaultTaskName") + ".fpl");
-  }
-  else if(fplType == CCondor2Nav::TFPLType::RESULT) {
-    auto resultsPath = bfs::path{configParser.Value("Condor", "RaceResultsPath")};
-    if(resultsPath.empty())
-      resultsPath = condorPath / RACE_RESULTS_PATH;
-
-    // find the latest race result
-    std::vector<bfs::path> results;
-    std::copy_if(bfs::directory_iterator(resultsPath), bfs::directory_iterator(), std::back_inserter(results),
-                 [](const bfs::path &f){ return CStringNoCase{f.extension().string().c_str()} == ".fpl"; });
-    auto result = std::max_element(cbegin(results), cend(results),
-                                   [](const bfs::path &f1, const bfs::path &f2)
-    { return bfs::last_write_time(f1) < bfs::last_write_time(f2); });
-    if(result != results.end())
-      fplPath = result->string();
-    else
-      throw EOperationFailed{"ERROR: Cannot find last result FPL file in '" + fplPath.string() + "'(" + Convert(GetLastError()) + ")!!!"};
-  }
-  return fplPath;
-}
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file condor.cpp
+ *
+ * @brief Implements the condor2nav::CCondor class. 
+ */
+
+#include "condor.h"
+#include "projectionGrid.h"
+#include "coordCache.h"
+#include "naviConWorkers.h"
+#include "istream.h"
+#include "traitsNoCase.h"
+#include "tools.h"
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <set>
+
+namespace {
+
+  const bfs::path FLIGHT_PLANS_PATH = "FlightPlans\\User";
+  const bfs::path RACE_RESULTS_PATH = "RaceResults";
+
+  // NaviCon.dll interface
+  using FNaviConInit = int(WINAPI*)(const char *trnFile);
+  using FXYToLon = float(WINAPI*)(float X, float Y);
+  using FXYToLat = float(WINAPI*)(float X, float Y);
+  using FGetMaxX = float(WINAPI*)();
+  using FGetMaxY = float(WINAPI*)();
+
+  /**
+   * @brief NaviCon.dll loaded into the process.
+   *
+   * The library has a global state so it is loaded only once per process and
+   * shared by all the converters. It is reloaded only when NaviCon.dll from
+   * another Condor directory is needed.
+   */
+  struct TNaviCon {
+    bfs::path dllPath;           ///< @brief The path of the loaded library (empty if not loaded).
+    condor2nav::CLibraryRes lib; ///< @brief DLL instance.
+    FNaviConInit naviConInit;
+    FGetMaxX     getMaxX;
+    FGetMaxY     getMaxY;
+    FXYToLon     xyToLon;
+    FXYToLat     xyToLat;
+    std::string trn;             ///< @brief The terrain file the library is currently initialized with.
+  };
+
+  std::mutex naviConMutex;       ///< @brief Serializes NaviCon.dll usage.
+  TNaviCon naviCon;              ///< @brief NaviCon.dll state (guarded by naviConMutex).
+
+
+  template<typename SYMBOL_TYPE>
+  inline void Symbol(const HMODULE &module, const std::string &name, SYMBOL_TYPE &out)
+  {
+    SYMBOL_TYPE sym = reinterpret_cast<SYMBOL_TYPE>(GetProcAddress(module, name.c_str()));
+    if(!sym)
+      throw condor2nav::EOperationFailed{"ERROR: Couldn't map " + name + "() from 'NaviCon.dll'!!!"};
+    out = sym;
+  }
+
+
+  /**
+   * @brief Returns the path to the landscape terrain file.
+   *
+   * @param condorPath The path to Condor directory
+   * @param trnName    The name of the terrain
+   *
+   * @return The path to the terrain file.
+   */
+  bfs::path TrnPath(const bfs::path &condorPath, const std::string &trnName)
+  {
+    return condorPath / "Landscapes" / trnName / (trnName + ".trn");
+  }
+
+
+  /**
+   * @brief Parses a part of the task.
+   *
+   * Parsing error is stored in the part and reported only when the part is used.
+   *
+   * @param part  The part of the task to fill.
+   * @param parse Parsing function.
+   */
+  template<typename PART, typename PARSE>
+  void PartParse(PART &part, PARSE parse)
+  {
+    try {
+      parse();
+    }
+    catch(const condor2nav::EOperationFailed &ex) {
+      part = PART{};
+      part.error = ex.what();
+    }
+  }
+
+
+  /**
+   * @brief Prepares NaviCon.dll for the terrain
+   *
+   * Function loads the library from Condor directory if it is not loaded yet
+   * and initializes it with the terrain file unless it is already initialized
+   * with it.
+   *
+   * NOTE: naviConMutex has to be locked by the caller.
+   *
+   * @param condorPath The path to Condor directory
+   * @param trnPath    The path to the terrain file
+   *
+   * @return NaviCon.dll ready to use.
+   */
+  const TNaviCon &NaviConSelect(const bfs::path &condorPath, const bfs::path &trnPath)
+  {
+    const auto dllPath = condorPath / "NaviCon.dll";
+    if(naviCon.dllPath != dllPath) {
+      naviCon.dllPath.clear();
+      naviCon.trn.clear();
+      naviCon.lib.reset(::LoadLibrary(dllPath.string().c_str()));
+      if(!naviCon.lib.get())
+        throw condor2nav::EOperationFailed{"ERROR: Couldn't open 'NaviCon.dll' from Condor directory '" + condorPath.string() + "'!!!"};
+
+      Symbol(naviCon.lib.get(), "NaviConInit", naviCon.naviConInit);
+      Symbol(naviCon.lib.get(), "GetMaxX",     naviCon.getMaxX);
+      Symbol(naviCon.lib.get(), "GetMaxY",     naviCon.getMaxY);
+      Symbol(naviCon.lib.get(), "XYToLon",     naviCon.xyToLon);
+      Symbol(naviCon.lib.get(), "XYToLat",     naviCon.xyToLat);
+      naviCon.dllPath = dllPath;
+    }
+    const auto trn = trnPath.string();
+    if(naviCon.trn != trn) {
+      naviCon.trn.clear();
+      naviCon.naviConInit(trn.c_str());
+      naviCon.trn = trn;
+    }
+    return naviCon;
+  }
+
+
+  /**
+   * @brief Rounds coordinates to 0.001 of a minute.
+   *
+   * Function rounds coordinates in place. The loop does not have any branches
+   * so it can be vectorized by the compiler.
+   *
+   * @param coord The array of coordinates in degrees.
+   * @param num   The number of coordinates.
+   */
+  void MinutesRound(double coord[], size_t num)
+  {
+    for(size_t i=0; i<num; i++) {
+      const auto deg = static_cast<int>(coord[i]);
+      const auto min = static_cast<int>(floor((coord[i] - deg) * 60.0 * 1000 + 0.5)) / 1000.0;
+      coord[i] = deg + min / 60;
+    }
+  }
+
+}
+
+/* ******************** C O N D O R   -   C O O R D   C O N V E R T E R ********************* */
+
+const bfs::path condor2nav::CCondor::CCoordConverter::GRIDS_PATH = bfs::path{"data"} / "Grids";
+const bfs::path condor2nav::CCondor::CCoordConverter::CACHE_PATH = bfs::path{"data"} / "Cache" / "Coordinates.cache";
+const float condor2nav::CCondor::CCoordConverter::GRID_STEP = 2000;
+
+
+/**
+ * @brief Returns the path to the projection grid file.
+ *
+ * @param trnName The name of the terrain
+ *
+ * @return The path to the projection grid file.
+ */
+bfs::path condor2nav::CCondor::CCoordConverter::GridPath(const std::string &trnName)
+{
+  return GRIDS_PATH / (trnName + ".grid");
+}
+
+
+/**
+ * @brief Generates landscape projection grid.
+ *
+ * Method samples NaviCon.dll in every node of a grid covering the whole
+ * landscape and stores the result in a grid file used by converters
+ * created later for that landscape.
+ *
+ * @param condorPath The path to Condor directory
+ * @param trnName    The name of the terrain
+ * @param step       The distance between grid nodes
+ */
+void condor2nav::CCondor::CCoordConverter::GridGenerate(const bfs::path &condorPath, const std::string &trnName, float step /* = GRID_STEP */)
+{
+  const CCoordConverter converter{condorPath, trnName, false};
+  std::lock_guard<std::mutex> lock{naviConMutex};
+  const auto &iface = NaviConSelect(condorPath, converter._trnPath);
+  const CProjectionGrid grid{CProjectionGrid::Stamp(TrnPath(condorPath, trnName)), iface.getMaxX(), iface.getMaxY(), step,
+                             [&](float x, float y){ return static_cast<double>(iface.xyToLat(x, y)); },
+                             [&](float x, float y){ return static_cast<double>(iface.xyToLon(x, y)); }};
+  bfs::create_directories(GRIDS_PATH);
+  grid.Dump(GridPath(trnName));
+}
+
+
+/**
+ * @brief Class constructor
+ *
+ * condor2nav::CCondor::CCoordConverter class constructor. It loads the projection
+ * grid for the terrain if it exists and is up to date. Otherwise it opens the
+ * conversions cache. NaviCon.dll is loaded on the first point not found in the cache.
+ *
+ * @param condorPath The path to Condor directory
+ * @param trnName The name of the terrain used in task
+ * @param gridUse Specifies if projection grid and cache should be used if available
+ * @param workers NaviCon.dll worker processes to use instead of the library (nullptr if not used)
+ */
+condor2nav::CCondor::CCoordConverter::CCoordConverter(const bfs::path &condorPath, const std::string &trnName, bool gridUse /* = true */,
+                                                      std::shared_ptr<CNaviConWorkers> workers /* = nullptr */) :
+  _condorPath{condorPath}, _trnPath{TrnPath(condorPath, trnName)}, _workers{std::move(workers)}
+{
+  if(!gridUse)
+    return;
+
+  const auto gridPath = GridPath(trnName);
+  boost::system::error_code ec;
+  if(bfs::exists(gridPath, ec)) {
+    try {
+      auto grid = std::make_unique<CProjectionGrid>(gridPath);
+      // grid without a terrain file to verify against is trusted
+      if(!bfs::exists(_trnPath, ec) || grid->Stamp() == CProjectionGrid::Stamp(_trnPath)) {
+        _grid = std::move(grid);
+        return;
+      }
+    }
+    catch(const Exception &) {
+      // corrupted grid file
+    }
+  }
+
+  // cache is used only for existing terrain files so NaviCon.dll reports errors for other ones
+  const auto trnTime = bfs::last_write_time(_trnPath, ec);
+  if(!ec) {
+    try {
+      bfs::create_directories(CACHE_PATH.parent_path(), ec);
+      _cache = std::make_unique<CCoordCache>(CACHE_PATH, trnName, trnTime);
+    }
+    catch(const Exception &) {
+      // work without the cache
+    }
+  }
+}
+
+
+/**
+* @brief Class constructor
+*
+* NOTE: Destructor definition is needed here to make sure that CProjectionGrid and CCoordCache are defined.
+*/
+condor2nav::CCondor::CCoordConverter::~CCoordConverter()
+{
+}
+
+
+/**
+ * @brief Returns memory used by the converter.
+ *
+ * Method estimates the memory owned by the converter: its projection grid
+ * and conversions cache. Both have a constant size for the converter's
+ * lifetime. The terrain loaded by NaviCon.dll is not included as it is
+ * shared by the whole process and is not released with the converter.
+ *
+ * @return The number of bytes used.
+ */
+size_t condor2nav::CCondor::CCoordConverter::MemoryUsage() const
+{
+  size_t size = sizeof(*this);
+  if(_grid)
+    size += static_cast<size_t>(_grid->Cols()) * _grid->Rows() * 2 * sizeof(double);
+  if(_cache)
+    size += _cache->Size();
+  return size;
+}
+
+
+/**
+ * @brief Converts Condor coordinates to longitude.
+ *
+ * Method converts Condor coordinates to a double longitude value.
+ * 
+ * @param x The x coordinate.
+ * @param y The y coordinate. 
+ *
+ * @return Converted double longitude value.
+ */
+condor2nav::TLongitude condor2nav::CCondor::CCoordConverter::Longitude(float x, float y) const
+{
+  double lat, lon;
+  LatLon(&x, &y, 1, &lat, &lon);
+  return TLongitude{lon};
+}
+
+
+/**
+ * @brief Converts Condor coordinates to double latitude value.
+ *
+ * Method converts Condor coordinates to latitude.
+ * 
+ * @param x The x coordinate.
+ * @param y The y coordinate. 
+ *
+ * @return Converted double latitude value.
+ */
+condor2nav::TLatitude condor2nav::CCondor::CCoordConverter::Latitude(float x, float y) const
+{
+  double lat, lon;
+  LatLon(&x, &y, 1, &lat, &lon);
+  return TLatitude{lat};
+}
+
+
+/**
+ * @brief Converts an array of Condor coordinates to latitudes and longitudes.
+ *
+ * Method converts all the points in one pass. Points are interpolated with the
+ * projection grid or taken from the cache (NaviCon.dll or its worker processes
+ * are used only for points not found there) first and then all the results are
+ * rounded in one loop.
+ * 
+ * @param x               The array of x coordinates.
+ * @param y               The array of y coordinates.
+ * @param num             The number of points to convert.
+ * @param [out] latitude  The array of converted latitudes.
+ * @param [out] longitude The array of converted longitudes.
+ */
+void condor2nav::CCondor::CCoordConverter::LatLon(const float x[], const float y[], size_t num, double latitude[], double longitude[]) const
+{
+  if(_grid)
+    _grid->LatLon(x, y, num, latitude, longitude);
+  else if(_workers) {
+    // points not found in the cache are converted in one batch by a worker process
+    std::vector<size_t> misses;
+    std::vector<float> missX, missY;
+    for(size_t i=0; i<num; i++) {
+      if(_cache && _cache->Find(x[i], y[i], latitude[i], longitude[i]))
+        continue;
+      misses.push_back(i);
+      missX.push_back(x[i]);
+      missY.push_back(y[i]);
+    }
+    if(!misses.empty()) {
+      std::vector<double> missLat(misses.size()), missLon(misses.size());
+      _workers->LatLon(_condorPath / "NaviCon.dll", _trnPath, missX.data(), missY.data(), misses.size(), missLat.data(), missLon.data());
+      for(size_t i=0; i<misses.size(); i++) {
+        latitude[misses[i]] = missLat[i];
+        longitude[misses[i]] = missLon[i];
+        if(_cache)
+          _cache->Insert(missX[i], missY[i], missLat[i], missLon[i]);
+      }
+    }
+  }
+  else {
+    std::unique_lock<std::mutex> lock{naviConMutex, std::defer_lock};
+    const TNaviCon *dll = nullptr;
+    for(size_t i=0; i<num; i++) {
+      if(_cache && _cache->Find(x[i], y[i], latitude[i], longitude[i]))
+        continue;
+      if(!lock) {
+        lock.lock();
+        dll = &NaviConSelect(_condorPath, _trnPath);
+      }
+      latitude[i] = dll->xyToLat(x[i], y[i]);
+      longitude[i] = dll->xyToLon(x[i], y[i]);
+      if(_cache)
+        _cache->Insert(x[i], y[i], latitude[i], longitude[i]);
+    }
+  }
+  MinutesRound(latitude, num);
+  MinutesRound(longitude, num);
+}
+
+
+
+
+/* *************** C O N D O R   -   C O O R D   C O N V E R T E R   P O O L ***************** */
+
+
+/**
+ * @brief Class constructor
+ *
+ * condor2nav::CCondor::CCoordConverterPool class constructor.
+ */
+condor2nav::CCondor::CCoordConverterPool::CCoordConverterPool() :
+  _memoryLimit{MEMORY_LIMIT_DEFAULT}
+{
+}
+
+
+/**
+ * @brief Returns the process-wide converters pool.
+ *
+ * @return Converters pool.
+ */
+condor2nav::CCondor::CCoordConverterPool &condor2nav::CCondor::CCoordConverterPool::Instance()
+{
+  static CCoordConverterPool instance;
+  return instance;
+}
+
+
+/**
+ * @brief Sets the memory limit of the pool.
+ *
+ * @param limit The number of bytes all pooled converters may use.
+ */
+void condor2nav::CCondor::CCoordConverterPool::MemoryLimit(size_t limit)
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  _memoryLimit = limit;
+  Trim();
+}
+
+
+/**
+ * @brief Sets NaviCon.dll worker processes.
+ *
+ * All converters created from now on will use the workers. Already pooled
+ * converters are dropped.
+ *
+ * @param workers NaviCon.dll worker processes (nullptr to use the library loaded in the current process).
+ */
+void condor2nav::CCondor::CCoordConverterPool::Workers(std::shared_ptr<CNaviConWorkers> workers)
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  _workers = std::move(workers);
+  _entries.clear();
+}
+
+
+/**
+ * @brief Drops least recently used converters exceeding the memory limit.
+ *
+ * The most recently used converter always stays in the pool.
+ *
+ * NOTE: _mutex has to be locked by the caller.
+ */
+void condor2nav::CCondor::CCoordConverterPool::Trim()
+{
+  size_t memory = 0;
+  for(auto &entry : _entries)
+    memory += entry.memory;
+  while(memory > _memoryLimit && _entries.size() > 1) {
+    memory -= _entries.back().memory;
+    _entries.pop_back();
+  }
+}
+
+
+/**
+ * @brief Returns a converter for the landscape.
+ *
+ * Method returns a pooled converter if one was already created for the landscape.
+ * Otherwise a new converter is created and added to the pool.
+ *
+ * @param condorPath The path to Condor directory
+ * @param landscape  The name of the landscape
+ *
+ * @return Shared converter.
+ */
+std::shared_ptr<const condor2nav::CCondor::CCoordConverter> condor2nav::CCondor::CCoordConverterPool::Converter(const bfs::path &condorPath,
+                                                                                                               const std::string &landscape)
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto it = std::find_if(_entries.begin(), _entries.end(),
+                         [&](const TEntry &entry){ return entry.landscape == landscape && entry.condorPath == condorPath; });
+  if(it != _entries.end())
+    _entries.splice(_entries.begin(), _entries, it);
+  else {
+    TEntry entry;
+    entry.condorPath = condorPath;
+    entry.landscape = landscape;
+    entry.converter = std::make_shared<const CCoordConverter>(condorPath, landscape, true, _workers);
+    entry.memory = entry.converter->MemoryUsage();
+    _entries.push_front(std::move(entry));
+  }
+  Trim();
+  return _entries.front().converter;
+}
+
+
+/**
+ * @brief Returns the number of pooled converters.
+ *
+ * @return The number of converters.
+ */
+size_t condor2nav::CCondor::CCoordConverterPool::Size() const
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _entries.size();
+}
+
+
+/**
+ * @brief Drops all pooled converters.
+ */
+void condor2nav::CCondor::CCoordConverterPool::Clear()
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  _entries.clear();
+}
+
+
+
+
+/* ************************************* C O N D O R **************************************** */
+
+
+/**
+ * @brief Class constructor. 
+ *
+ * condor2nav::CCondor class constructor. Coordinates converter is obtained
+ * from the converters pool on the first use.
+ * 
+ * @param condorPath Full pathname of the Condor directory. 
+ * @param fplPath    Condor FPL file to convert path
+ *
+ * @exception std Thrown when not supported Condor version.
+ */
+condor2nav::CCondor::CCondor(const bfs::path &condorPath, const bfs::path &fplPath):
+_condorPath{condorPath},
+_task{VersionCheck(CFileParserINI{fplPath})}
+{
+}
+
+
+/**
+ * @brief Class destructor.
+ *
+ * NOTE: Destructor definition is needed here to make sure that CCoordConverter is defined.
+ */
+condor2nav::CCondor::~CCondor()
+{
+}
+
+
+/**
+ * @brief Probes Condor task file. 
+ *
+ * Method reads only the task header from the FPL file and verifies if the task
+ * was created with a supported Condor version. It does not parse the rest of the
+ * task and does not touch the landscape.
+ * 
+ * @param fplPath Condor FPL file path
+ *
+ * @exception std Thrown when not supported Condor version or file is corrupted.
+ *
+ * @return Task header.
+ */
+condor2nav::condor::TTaskHeader condor2nav::CCondor::TaskProbe(const bfs::path &fplPath)
+{
+  condor::TTaskHeader header{fplPath};
+  VersionCheck(header.version);
+  return header;
+}
+
+
+/**
+ * @brief Returns Condor map coordinates converter. 
+ *
+ * Method obtains the converter for the task landscape from the converters
+ * pool on the first call.
+ * 
+ * @return Coordinates converter.
+ */
+const condor2nav::CCondor::CCoordConverter &condor2nav::CCondor::CoordConverter() const
+{
+  std::lock_guard<std::mutex> lock{_coordConverterMutex};
+  if(!_coordConverter)
+    _coordConverter = CCoordConverterPool::Instance().Converter(_condorPath, _task.landscape);
+  return *_coordConverter;
+}
+
+
+/**
+ * @brief Verifies Condor version. 
+ *
+ * Method verifies if the task file was created with a supported Condor version.
+ * 
+ * @param version Condor version that created the task. 
+ *
+ * @exception std Thrown when not supported Condor version.
+ */
+void condor2nav::CCondor::VersionCheck(unsigned version)
+{
+  if(version < CONDOR_VERSION_SUPPORTED)
+    throw EOperationFailed{"Condor vesion '" + Convert(version) + "' not supported!!!"};
+}
+
+
+/**
+ * @brief Verifies Condor task file version. 
+ *
+ * Method verifies if the task file was created with a supported Condor version.
+ * 
+ * @param taskParser Condor task file parser. 
+ *
+ * @exception std Thrown when not supported Condor version.
+ *
+ * @return Condor task file parser.
+ */
+const condor2nav::CFileParserINI &condor2nav::CCondor::VersionCheck(const CFileParserINI &taskParser)
+{
+  VersionCheck(Convert<unsigned>(taskParser.Value("Version", "Condor version")));
+  return taskParser;
+}
+
+
+
+/* ******************************** C O N D O R   T A S K *********************************** */
+
+
+/**
+ * @brief Class constructor. 
+ *
+ * condor2nav::condor::TTaskHeader class constructor that probes the FPL file.
+ * Only [Version] and [Task] chapters are scanned and the file is not read any
+ * further once both of them were passed.
+ * 
+ * @param fplPath Condor FPL file path. 
+ *
+ * @exception std Thrown when task file is corrupted.
+ */
+condor2nav::condor::TTaskHeader::TTaskHeader(const bfs::path &fplPath) :
+  version{0},
+  aatType{TAATType::NONE},
+  aatTime{0},
+  aatTimeValid{false}
+{
+  enum class TChapter { OTHER, VERSION, TASK };
+
+  // lines are parsed the same way as with CFileParserINI so the probe agrees
+  // with the translation: the first chapter of a given name is used and
+  // a key provided more than once in a chapter is an error
+  CIStream stream{fplPath};
+  boost::string_ref line, name, value;
+  TChapter chapter = TChapter::OTHER;
+  bool versionSeen = false, taskSeen = false;
+  bool versionFound = false, landscapeFound = false;
+  std::set<boost::string_ref> keys;
+  boost::string_ref aat, designatedTime;
+  while(stream.GetLine(line)) {
+    const auto type = CFileParserINI::LineParse(fplPath, line, name, value);
+    if(type == CFileParserINI::TLine::SKIP)
+      continue;
+
+    if(type == CFileParserINI::TLine::CHAPTER) {
+      if(versionSeen && taskSeen)
+        // both chapters were already read
+        break;
+      keys.clear();
+      if(name == "Version" && !versionSeen) {
+        chapter = TChapter::VERSION;
+        versionSeen = true;
+      }
+      else if(name == "Task" && !taskSeen) {
+        chapter = TChapter::TASK;
+        taskSeen = true;
+      }
+      else
+        chapter = TChapter::OTHER;
+      continue;
+    }
+
+    if(chapter == TChapter::OTHER)
+      continue;
+    if(!keys.insert(name).second)
+      throw EOperationFailed{"ERROR: Entry '" + name.to_string() + "' provided more than once in '" + fplPath.string() + "' INI file!!!"};
+
+    if(chapter == TChapter::VERSION) {
+      if(name == "Condor version") {
+        version = Convert<unsigned>(value);
+        versionFound = true;
+      }
+    }
+    else if(name == "Landscape") {
+      landscape.assign(value.begin(), value.end());
+      landscapeFound = true;
+    }
+    else if(name == "AAT")
+      aat = value;
+    else if(name == "DesignatedTime")
+      designatedTime = value;
+  }
+
+  if(!versionFound)
+    throw EOperationFailed{"ERROR: Entry 'Condor version' not found in '" + fplPath.string() + "' INI file!!!"};
+  if(!landscapeFound)
+    throw EOperationFailed{"ERROR: Entry 'Landscape' not found in '" + fplPath.string() + "' INI file!!!"};
+
+  // condor-club AAT tasks
+  if(aat == "Distance")
+    aatType = TAATType::DISTANCE;
+  else if(aat == "Speed") {
+    aatType = TAATType::SPEED;
+    try {
+      if(!designatedTime.empty()) {
+        aatTime = Convert<unsigned>(designatedTime);
+        aatTimeValid = true;
+      }
+    }
+    catch(EOperationFailed &) {
+    }
+  }
+}
+
+
+/**
+ * @brief Class constructor. 
+ *
+ * condor2nav::condor::TTaskHeader class constructor.
+ * 
+ * @param taskParser Condor task file parser. 
+ *
+ * @exception std Thrown when task file is corrupted.
+ */
+condor2nav::condor::TTaskHeader::TTaskHeader(const CFileParserINI &taskParser) :
+  version{Convert<unsigned>(taskParser.Value("Version", "Condor version"))},
+  landscape{taskParser.Value("Task", "Landscape")},
+  aatType{TAATType::NONE},
+  aatTime{0},
+  aatTimeValid{false}
+{
+  // condor-club AAT tasks
+  try {
+    const auto &aat = taskParser.Value("Task", "AAT");
+    if(aat == "Distance")
+      aatType = TAATType::DISTANCE;
+    else if(aat == "Speed") {
+      aatType = TAATType::SPEED;
+      aatTime = Convert<unsigned>(taskParser.Value("Task", "DesignatedTime"));
+      aatTimeValid = true;
+    }
+  }
+  catch(EOperationFailed &) {
+  }
+}
+
+
+/**
+ * @brief Class constructor. 
+ *
+ * condor2nav::condor::TTask class constructor that parses all the task data
+ * used by translation targets.
+ * 
+ * @param taskParser Condor task file parser. 
+ *
+ * @exception std Thrown when task file is corrupted.
+ */
+condor2nav::condor::TTask::TTask(const CFileParserINI &taskParser) :
+  TTaskHeader{taskParser}
+{
+  // turnpoints
+  PartParse(turnpoints, [&]{
+    const auto tpNum = Convert<unsigned>(taskParser.Value("Task", "Count"));
+    turnpoints.name.reserve(tpNum);
+    turnpoints.x.reserve(tpNum);
+    turnpoints.y.reserve(tpNum);
+    turnpoints.z.reserve(tpNum);
+    turnpoints.width.reserve(tpNum);
+    turnpoints.sectorType.reserve(tpNum);
+    turnpoints.radius.reserve(tpNum);
+    turnpoints.angle.reserve(tpNum);
+    turnpoints.height.reserve(tpNum);
+    for(unsigned i=0; i<tpNum; i++) {
+      const auto tpIdxStr = Convert(i);
+      turnpoints.name.push_back(taskParser.Value("Task", "TPName" + tpIdxStr));
+      turnpoints.x.push_back(Convert<float>(taskParser.Value("Task", "TPPosX" + tpIdxStr)));
+      turnpoints.y.push_back(Convert<float>(taskParser.Value("Task", "TPPosY" + tpIdxStr)));
+      turnpoints.z.push_back(Convert<double>(taskParser.Value("Task", "TPPosZ" + tpIdxStr)));
+      turnpoints.width.push_back(Convert<unsigned>(taskParser.Value("Task", "TPWidth" + tpIdxStr)));
+      turnpoints.sectorType.push_back(Convert<unsigned>(taskParser.Value("Task", "TPSectorType" + tpIdxStr)));
+      turnpoints.radius.push_back(Convert<unsigned>(taskParser.Value("Task", "TPRadius" + tpIdxStr)));
+      turnpoints.angle.push_back(Convert<unsigned>(taskParser.Value("Task", "TPAngle" + tpIdxStr)));
+      turnpoints.height.push_back(Convert<unsigned>(taskParser.Value("Task", "TPHeight" + tpIdxStr)));
+    }
+  });
+
+  // penalty zones
+  PartParse(penaltyZones, [&]{
+    const auto pzNum = Convert<unsigned>(taskParser.Value("Task", "PZCount"));
+    penaltyZones.top.reserve(pzNum);
+    penaltyZones.base.reserve(pzNum);
+    for(unsigned j=0; j<TPenaltyZones::CORNERS_NUM; j++) {
+      penaltyZones.x[j].reserve(pzNum);
+      penaltyZones.y[j].reserve(pzNum);
+    }
+    for(unsigned i=0; i<pzNum; i++) {
+      const auto pzIdxStr = Convert(i);
+      penaltyZones.top.push_back(taskParser.Value("Task", "PZTop" + pzIdxStr));
+      penaltyZones.base.push_back(Convert<unsigned>(taskParser.Value("Task", "PZBase" + pzIdxStr)));
+      for(unsigned j=0; j<TPenaltyZones::CORNERS_NUM; j++) {
+        const auto cornerIdxStr = Convert(j);
+        penaltyZones.x[j].push_back(Convert<float>(taskParser.Value("Task", "PZPos" + cornerIdxStr + "X" + pzIdxStr)));
+        penaltyZones.y[j].push_back(Convert<float>(taskParser.Value("Task", "PZPos" + cornerIdxStr + "Y" + pzIdxStr)));
+      }
+    }
+  });
+
+  // glider
+  PartParse(plane, [&]{
+    plane.name = taskParser.Value("Plane", "Name");
+    plane.className = taskParser.Value("Plane", "Class");
+    plane.water = Convert<unsigned>(taskParser.Value("Plane", "Water"));
+  });
+
+  // weather
+  PartParse(weather, [&]{
+    weather.windDir = Convert<float>(taskParser.Value("Weather", "WindDir"));
+    weather.windSpeed = Convert<float>(taskParser.Value("Weather", "WindSpeed"));
+  });
+}
+
+
+
+/**
+* @brief Returns a path to Condor: The Competition Soaring Simulator
+*
+* Method returns a path to Condor: The Competition Soaring Simulator.
+*
+* @return Path to Condor: The Competition Soaring Simulator
+*/
+bfs::path condor2nav::condor::InstallPath()
+{
+  HKEY hTestKey;
+  if((RegOpenKeyEx(HKEY_CURRENT_USER, "Software\\Condor", 0, KEY_READ, &hTestKey)) == ERROR_SUCCESS) {
+    DWORD bufferSize = 0;
+    RegQueryValueEx(hTestKey, "InstallDir", nullptr, nullptr, nullptr, &bufferSize);
+    auto buffer = std::make_unique<char[]>(bufferSize);
+    RegQueryValueEx(hTestKey, "InstallDir", nullptr, nullptr, reinterpret_cast<BYTE *>(buffer.get()), &bufferSize);
+    bfs::path condorPath{buffer.get()};
+    RegCloseKey(hTestKey);
+    return condorPath;
+  }
+  else
+    throw EOperationFailed{"ERROR: Condor installation not found!!!"};
+}
+
+
+/**
+* @brief Returns FPL file path.
+*
+* Method returns FPL file path.
+*
+* @param configParser     The INI file configuration parser.
+* @param fplType          Type of the FPL file.
+* @param condorPath       Full pathname of the Condor: The Competition Soaring Simulator.
+*
+* @exception std::runtime_error Thrown when FPL file cannot be found.
+*
+* @return Full pathname of the FPL file.
+*/
+bfs::path condor2nav::condor::FPLPath(const CFileParserINI &configParser,
+                                       CCondor2Nav::TFPLType fplType,
+                                       const bfs::path &condorPath)
+{
+  bfs::path fplPath;
+  if(fplType == CCondor2Nav::TFPLType::DEFAULT) {
+    auto fplPathUser = bfs::path{configParser.Value("Condor", "FlightPlansPath")};
+    if(fplPathUser.empty())
+      fplPath = condorPath / FLIGHT_PLANS_PATH / (configParser.Value("Condor", "DefaultTaskName") + ".fpl");
+    else
+      fplPath = fplPathUser / (configParser.Value("Condor", "DefaultTaskName") + ".fpl");
+  }
+  else if(fplType == CCondor2Nav::TFPLType::RESULT) {
+    auto resultsPath = bfs::path{configParser.Value("Condor", "RaceResultsPath")};
+    if(resultsPath.empty())
+      resultsPath = condorPath / RACE_RESULTS_PATH;
+
+    // find the latest race result
+    std::vector<bfs::path> results;
+    std::copy_if(bfs::directory_iterator(resultsPath), bfs::directory_iterator(), std::back_inserter(results),
+                 [](const bfs::path &f){ return CStringNoCase{f.extension().string().c_str()} == ".fpl"; });
+    auto result = std::max_element(cbegin(results), cend(results),
+                                   [](const bfs::path &f1, const bfs::path &f2)
+    { return bfs::last_write_time(f1) < bfs::last_write_time(f2); });
+    if(result != results.end())
+      fplPath = result->string();
+    else
+      throw EOperationFailed{"ERROR: Cannot find last result FPL file in '" + fplPath.string() + "'(" + Convert(GetLastError()) + ")!!!"};
+  }
+  return fplPath;
+}
@@ -1,96 +1,293 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
- * @file condor.h
- *
- * @brief Declares the condor2nav::CCondor class. 
- */
-
-#ifndef __CONDOR_H__
-#define __CONDOR_H__
-
-#include "condor2nav.h"
-#include "nonCopyable.h"
-#include "fileParserINI.h"
-#include "boostfwd.h"
-#include <windows.h>
-
-namespace condor2nav {
-
-  /**
-   * @brief Condor data class. 
-   *
-   * condor2nav::CCondor is responsible for storing and handling of Condor
-   * (The Soaring Competition Simulator) data. It also provides some
-   * tools to interpret that data.
-   */
-  class CCondor : CNonCopyable {
-  public:
-    /**
-     * @brief Condor map coordinates converter.
-     *
-     * condor2nav::CCondor::CCoordConverter is responsible for
-     * Condor map coordinates convertions. It uses NaviCon.dll library
-     * provided with every Condor release.
-     */
-    class CCoordConverter : CNonCopyable {
-      struct TDLLIface;
-      std::unique_ptr<TDLLIface> _iface;	       ///< @brief DLL interface.
-      CLibraryRes _lib;                            ///< @brief DLL instance. 
-    public:
-      CCoordConverter(const bfs::path &condorPath, const std::string &trnName);
-      ~CCoordConverter();
-      TLongitude Longitude(const std::string &x, const std::string &y) const;
-      TLatitude Latitude(const std::string &x, const std::string &y) const;
-    };
-
-  private:
-    static const unsigned CONDOR_VERSION_SUPPORTED = 1120;	  ///< @brief Supported Condor version.
-    const CFileParserINI _taskParser;	           ///< @brief Condor task file parser. 
-    const CCoordConverter _coordConverter;	       ///< @brief Condor map coordinates converter. 
-
-  public:
-    CCondor(const bfs::path &condorPath, const bfs::path &fplPath);
-    const CFileParserINI &TaskParser() const      { return _taskParser; }
-    const CCoordConverter &CoordConverter() const { return _coordConverter; }
-  };
-
-  namespace condor {
-
-    /**
-    * @brief The types of Condor sectors.
-    */
-    enum TSectorType {
-      SECTOR_CLASSIC,	    ///< @brief Line, FAI Sector or Circle.
-      SECTOR_WINDOW	        ///< @brief Window. 
-    };
-
-    bfs::path InstallPath();
-    bfs::path FPLPath(const CFileParserINI &configParser,
-                      CCondor2Nav::TFPLType fplType,
-                      const bfs::path &condorPath);
-
-  }
-
-}
-
-#endif /* __CONDOR_H__ */
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file condor.h
+ *
+ * @brief Declares the condor2nav::CCondor class. 
+ */
+
+#ifndef __CONDOR_H__
+#define __CONDOR_H__
+
+#include "condor2nav.h"
+#include "nonCopyable.h"
+#include "fileParserINI.h"
+#include "boostfwd.h"
+#include <windows.h>
+#include <array>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace condor2nav {
+
+  class CProjectionGrid;
+  class CCoordCache;
+  class CNaviConWorkers;
+
+  namespace condor {
+
+    /**
+    * @brief The types of Condor sectors.
+    */
+    enum TSectorType {
+      SECTOR_CLASSIC,	    ///< @brief Line, FAI Sector or Circle.
+      SECTOR_WINDOW	        ///< @brief Window. 
+    };
+
+    /**
+     * @brief The types of condor-club AAT tasks.
+     */
+    enum class TAATType {
+      NONE,                 ///< @brief Not an AAT task.
+      DISTANCE,             ///< @brief AAT/D task.
+      SPEED                 ///< @brief AAT/S task.
+    };
+
+    /**
+     * @brief Part of the task data.
+     *
+     * Parts of the task are parsed independently. If a part cannot be parsed
+     * the error is reported only when the part is used by the translation.
+     */
+    struct TTaskPart {
+      std::string error;                             ///< @brief Parsing error (empty if the part is valid).
+
+      /**
+       * @brief Verifies that the part was parsed successfully.
+       *
+       * @exception EOperationFailed Thrown with the parsing error.
+       */
+      void Check() const { if(!error.empty()) throw EOperationFailed{error}; }
+    };
+
+    /**
+     * @brief Task turnpoints.
+     *
+     * Turnpoints are stored as a structure of arrays indexed with the
+     * turnpoint number used in the FPL file (0 is a takeoff point).
+     */
+    struct TTurnpoints : TTaskPart {
+      std::vector<std::string> name;                 ///< @brief Turnpoint names.
+      std::vector<float> x;                          ///< @brief Condor map X coordinates.
+      std::vector<float> y;                          ///< @brief Condor map Y coordinates.
+      std::vector<double> z;                         ///< @brief Turnpoint altitudes.
+      std::vector<unsigned> width;                   ///< @brief Sector minimum altitudes (0 if not set).
+      std::vector<unsigned> sectorType;              ///< @brief Sector types (condor::TSectorType).
+      std::vector<unsigned> radius;                  ///< @brief Sector radiuses.
+      std::vector<unsigned> angle;                   ///< @brief Sector angles.
+      std::vector<unsigned> height;                  ///< @brief Sector maximum altitudes.
+
+      size_t Size() const { return name.size(); }
+    };
+
+    /**
+     * @brief Task penalty zones.
+     *
+     * Penalty zones are stored as a structure of arrays indexed with the zone number.
+     */
+    struct TPenaltyZones : TTaskPart {
+      static const unsigned CORNERS_NUM = 4;         ///< @brief The number of corners of every penalty zone.
+      std::vector<std::string> top;                  ///< @brief Zone top altitudes (as provided in the task file).
+      std::vector<unsigned> base;                    ///< @brief Zone base altitudes (0 for ground).
+      std::array<std::vector<float>, CORNERS_NUM> x; ///< @brief Condor map X coordinates of zone corners.
+      std::array<std::vector<float>, CORNERS_NUM> y; ///< @brief Condor map Y coordinates of zone corners.
+
+      size_t Size() const { return top.size(); }
+    };
+
+    /**
+     * @brief Task glider data.
+     */
+    struct TPlane : TTaskPart {
+      std::string name;                              ///< @brief Glider name.
+      std::string className;                         ///< @brief Glider competition class.
+      unsigned water;                                ///< @brief Water ballast.
+    };
+
+    /**
+     * @brief Task weather data.
+     */
+    struct TWeather : TTaskPart {
+      float windDir;                                 ///< @brief Wind direction.
+      float windSpeed;                               ///< @brief Wind speed.
+    };
+
+    /**
+     * @brief Condor task header.
+     *
+     * condor2nav::condor::TTaskHeader holds the task data needed to verify
+     * the task before the translation. It can be probed directly from the FPL
+     * file without parsing the rest of the task.
+     */
+    struct TTaskHeader {
+      unsigned version;                              ///< @brief Condor version that created the task.
+      std::string landscape;                         ///< @brief Landscape name.
+      TAATType aatType;                              ///< @brief condor-club AAT task type.
+      unsigned aatTime;                              ///< @brief condor-club AAT designated time.
+      bool aatTimeValid;                             ///< @brief true if AAT designated time was provided and is valid.
+
+      explicit TTaskHeader(const bfs::path &fplPath);
+      explicit TTaskHeader(const CFileParserINI &taskParser);
+    };
+
+    /**
+     * @brief Condor task.
+     *
+     * condor2nav::condor::TTask holds all the Condor task data used by translation
+     * targets. Every value is parsed once when the task is loaded. Every part
+     * of the task has to be checked with condor2nav::condor::TTaskPart::Check()
+     * before it is used.
+     */
+    struct TTask : TTaskHeader {
+      TTurnpoints turnpoints;                        ///< @brief Task turnpoints.
+      TPenaltyZones penaltyZones;                    ///< @brief Task penalty zones.
+      TPlane plane;                                  ///< @brief Glider data.
+      TWeather weather;                              ///< @brief Weather data.
+
+      explicit TTask(const CFileParserINI &taskParser);
+    };
+
+  }
+
+  /**
+   * @brief Condor data class. 
+   *
+   * condor2nav::CCondor is responsible for storing and handling of Condor
+   * (The Soaring Competition Simulator) data. It also provides some
+   * tools to interpret that data.
+   */
+  class CCondor : CNonCopyable {
+  public:
+    /**
+     * @brief Condor map coordinates converter.
+     *
+     * condor2nav::CCondor::CCoordConverter is responsible for
+     * Condor map coordinates convertions. It uses a landscape projection
+     * grid if one was generated for the current terrain file. Otherwise
+     * NaviCon.dll library provided with every Condor release is used.
+     * NaviCon.dll results are stored in a persistent cache and the library
+     * is loaded only when a point is not found there. If NaviCon.dll worker
+     * processes are provided the points are converted by them instead of
+     * the library loaded in the current process. NaviCon.dll has a global
+     * state so it is loaded once per process and shared by all the converters.
+     */
+    class CCoordConverter : CNonCopyable {
+      const bfs::path _condorPath;                 ///< @brief The path to Condor directory.
+      const bfs::path _trnPath;                    ///< @brief The path to the terrain file.
+      std::unique_ptr<CProjectionGrid> _grid;      ///< @brief Projection grid (nullptr if NaviCon.dll is used).
+      std::unique_ptr<CCoordCache> _cache;         ///< @brief Conversions cache (nullptr if not available).
+      const std::shared_ptr<CNaviConWorkers> _workers;  ///< @brief NaviCon.dll worker processes (nullptr if not used).
+
+    public:
+      static const bfs::path GRIDS_PATH;           ///< @brief Landscape projection grids directory path.
+      static const bfs::path CACHE_PATH;           ///< @brief Conversions cache file path.
+      static const float GRID_STEP;                ///< @brief Default distance between projection grid nodes.
+
+      static bfs::path GridPath(const std::string &trnName);
+      static void GridGenerate(const bfs::path &condorPath, const std::string &trnName, float step = GRID_STEP);
+
+      CCoordConverter(const bfs::path &condorPath, const std::string &trnName, bool gridUse = true,
+                      std::shared_ptr<CNaviConWorkers> workers = nullptr);
+      ~CCoordConverter();
+      size_t MemoryUsage() const;
+      TLongitude Longitude(float x, float y) const;
+      TLatitude Latitude(float x, float y) const;
+      void LatLon(const float x[], const float y[], size_t num, double latitude[], double longitude[]) const;
+    };
+
+    /**
+     * @brief Pool of Condor map coordinates converters.
+     *
+     * condor2nav::CCondor::CCoordConverterPool keeps converters of previous tasks
+     * so the next task on the same landscape reuses an already initialized one.
+     * Least recently used converters are dropped from the pool when the memory
+     * used by all of them exceeds the limit. The limit covers projection grids
+     * and conversions caches only; the terrain loaded by NaviCon.dll is shared
+     * by the process and is not charged to any converter. Converters still
+     * used by some task stay alive until that task releases them, so dropping
+     * them from the pool frees their memory only after that.
+     */
+    class CCoordConverterPool : CNonCopyable {
+      /**
+       * @brief Pool entry.
+       */
+      struct TEntry {
+        bfs::path condorPath;                      ///< @brief The path to Condor directory.
+        std::string landscape;                     ///< @brief Landscape name.
+        std::shared_ptr<const CCoordConverter> converter;  ///< @brief Converter.
+        size_t memory;                             ///< @brief Memory used by the converter (measured when created).
+      };
+
+      mutable std::mutex _mutex;                   ///< @brief Pool access synchronization.
+      std::list<TEntry> _entries;                  ///< @brief Pool entries (most recently used first).
+      size_t _memoryLimit;                         ///< @brief Memory limit of all pooled converters.
+      std::shared_ptr<CNaviConWorkers> _workers;   ///< @brief NaviCon.dll worker processes used by new converters.
+
+      CCoordConverterPool();
+      void Trim();
+
+    public:
+      static const size_t MEMORY_LIMIT_DEFAULT = 256 * 1024 * 1024;  ///< @brief Default memory limit of the pool.
+
+      static CCoordConverterPool &Instance();
+
+      void MemoryLimit(size_t limit);
+      void Workers(std::shared_ptr<CNaviConWorkers> workers);
+      std::shared_ptr<const CCoordConverter> Converter(const bfs::path &condorPath, const std::string &landscape);
+      size_t Size() const;
+      void Clear();
+    };
+
+  private:
+    static const unsigned CONDOR_VERSION_SUPPORTED = 1120;	  ///< @brief Supported Condor version.
+    const bfs::path _condorPath;                   ///< @brief The path to Condor directory.
+    const condor::TTask _task;	                   ///< @brief Condor task. 
+    mutable std::shared_ptr<const CCoordConverter> _coordConverter;	  ///< @brief Condor map coordinates converter (nullptr until needed). 
+    mutable std::mutex _coordConverterMutex;       ///< @brief Coordinates converter lazy initialization synchronization.
+
+    static void VersionCheck(unsigned version);
+    static const CFileParserINI &VersionCheck(const CFileParserINI &taskParser);
+
+  public:
+    static condor::TTaskHeader TaskProbe(const bfs::path &fplPath);
+
+    CCondor(const bfs::path &condorPath, const bfs::path &fplPath);
+    ~CCondor();
+    const condor::TTask &Task() const             { return _task; }
+    const CCoordConverter &CoordConverter() const;
+  };
+
+  namespace condor {
+
+    bfs::path InstallPath();
+    bfs::path FPLPath(const CFileParserINI &configParser,
+                      CCondor2Nav::TFPLType fplType,
+                      const bfs::path &condorPath);
+
+  }
+
+}
+
+#endif /* __CONDOR_H__ */
@@ -0,0 +1,309 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file coordCache.cpp
+ *
+ * @brief Implements the condor2nav::CCoordCache class.
+ *
+ * Cache file layout (little endian):
+ * - TFileHeader
+ * - sets * WAYS entries (TEntry)
+ */
+
+#include "coordCache.h"
+#include "hashTable.h"
+#include "tools.h"
+#include <boost/filesystem.hpp>
+#include <cstring>
+
+
+namespace {
+
+  const char CACHE_MAGIC[8] = { 'C', '2', 'N', 'C', 'A', 'C', 'H', 'E' };  ///< @brief Cache file identifier.
+  const uint32_t CACHE_VERSION = 1;                                          ///< @brief Cache file format version.
+
+  /**
+   * @brief Cache file header.
+   */
+  struct TFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t sets;
+    uint32_t ways;
+    uint32_t reserved;
+    uint64_t tick;                                    ///< @brief Last access counter.
+  };
+
+  /**
+   * @brief Cache key.
+   */
+  struct TKey {
+    uint64_t landscape;
+    int64_t trnTime;
+    float x;
+    float y;
+  };
+
+  /**
+   * @brief Scoped ownership of a mutex.
+   */
+  class CMutexLock : condor2nav::CNonCopyable {
+    HANDLE _mutex;
+  public:
+    explicit CMutexLock(HANDLE mutex) :
+      _mutex{mutex}
+    {
+      // abandoned mutex is owned as well (its previous owner was terminated)
+      const DWORD status = ::WaitForSingleObject(_mutex, INFINITE);
+      if(status != WAIT_OBJECT_0 && status != WAIT_ABANDONED)
+        throw condor2nav::EOperationFailed{"ERROR: Couldn't lock coordinates cache file!!!"};
+    }
+    ~CMutexLock() { ::ReleaseMutex(_mutex); }
+  };
+
+}
+
+
+namespace condor2nav {
+
+  /**
+   * @brief Cache file entry.
+   */
+  struct CCoordCache::TEntry {
+    TKey key;                                         ///< @brief Entry key.
+    uint64_t tick;                                    ///< @brief Last access counter value (0 for empty entry).
+    double latitude;                                  ///< @brief Converted latitude.
+    double longitude;                                 ///< @brief Converted longitude.
+  };
+
+
+  /**
+   * @brief Read-write memory mapped file.
+   */
+  class CCoordCache::CMappedFile : CNonCopyable {
+    struct CViewDeleter {
+      void operator()(char *view) const { ::UnmapViewOfFile(view); }
+    };
+
+    CHandleRes _file;                                 ///< @brief File handle.
+    CHandleRes _mapping;                              ///< @brief File mapping handle.
+    std::unique_ptr<char, CViewDeleter> _view;        ///< @brief Mapped view of the file.
+    bool _resized;                                    ///< @brief true if the file had a different size.
+
+  public:
+    CMappedFile(const bfs::path &fileName, uint64_t size);
+    char *Data() const   { return _view.get(); }
+    bool Resized() const { return _resized; }
+  };
+
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CCoordCache::CMappedFile class constructor. Opens or creates
+ * the file, sets its size and maps it into the process address space.
+ *
+ * @param fileName The name of the file to map.
+ * @param size     Required file size.
+ */
+condor2nav::CCoordCache::CMappedFile::CMappedFile(const bfs::path &fileName, uint64_t size) :
+  _resized{false}
+{
+  HANDLE file = ::CreateFile(fileName.string().c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                             nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+    throw EOperationFailed{"ERROR: Couldn't open file '" + fileName.string() + "' for writing!!!"};
+  _file.reset(file);
+
+  LARGE_INTEGER fileSize;
+  if(!::GetFileSizeEx(file, &fileSize))
+    throw EOperationFailed{"ERROR: Couldn't obtain the size of '" + fileName.string() + "' file!!!"};
+  if(static_cast<uint64_t>(fileSize.QuadPart) != size) {
+    LARGE_INTEGER newSize;
+    newSize.QuadPart = static_cast<LONGLONG>(size);
+    if(!::SetFilePointerEx(file, newSize, nullptr, FILE_BEGIN) || !::SetEndOfFile(file))
+      throw EOperationFailed{"ERROR: Couldn't resize '" + fileName.string() + "' file!!!"};
+    _resized = true;
+  }
+
+  _mapping.reset(::CreateFileMapping(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr));
+  if(!_mapping)
+    throw EOperationFailed{"ERROR: Couldn't map file '" + fileName.string() + "' for writing!!!"};
+  _view.reset(static_cast<char *>(::MapViewOfFile(_mapping.get(), FILE_MAP_WRITE, 0, 0, 0)));
+  if(!_view)
+    throw EOperationFailed{"ERROR: Couldn't map file '" + fileName.string() + "' for writing!!!"};
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CCoordCache class constructor. Cache file is created if it does not
+ * exist or was created with a different layout.
+ *
+ * @param path      The path of the cache file.
+ * @param landscape The name of the landscape.
+ * @param trnTime   The last write time of the landscape terrain file.
+ * @param sets      The number of sets in the cache (has to be a power of 2).
+ *
+ * @exception EOperationFailed Thrown when the cache file cannot be opened.
+ */
+condor2nav::CCoordCache::CCoordCache(const bfs::path &path, const std::string &landscape, int64_t trnTime, unsigned sets /* = SETS_DEFAULT */) :
+  _landscape{HashFNV1a<CHashTraits>(landscape)}, _trnTime{trnTime}
+{
+  if(!sets || (sets & (sets - 1)))
+    throw EOperationFailed{"ERROR: The number of coordinates cache sets (" + Convert(sets) + ") is not a power of 2!!!"};
+
+  // the mutex name is derived from the file path so all processes use the same one
+  const auto mutexName = "Local\\condor2nav-coordcache-" + Convert(HashFNV1a<CHashTraitsNoCase>(bfs::absolute(path).string()));
+  _mutex.reset(::CreateMutex(nullptr, FALSE, mutexName.c_str()));
+  if(!_mutex)
+    throw EOperationFailed{"ERROR: Couldn't create coordinates cache mutex for '" + path.string() + "'!!!"};
+  CMutexLock lock{_mutex.get()};
+
+  const uint64_t size = sizeof(TFileHeader) + static_cast<uint64_t>(sets) * WAYS * sizeof(TEntry);
+  _file = std::make_unique<CMappedFile>(path, size);
+
+  auto &header = *reinterpret_cast<TFileHeader *>(_file->Data());
+  if(_file->Resized() || memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) || header.version != CACHE_VERSION ||
+     header.sets != sets || header.ways != WAYS) {
+    // new or incompatible file
+    memset(_file->Data(), 0, static_cast<size_t>(size));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.sets = sets;
+    header.ways = WAYS;
+  }
+}
+
+
+/**
+ * @brief Class destructor.
+ *
+ * NOTE: Destructor definition is needed here to make sure that CMappedFile is defined.
+ */
+condor2nav::CCoordCache::~CCoordCache()
+{
+}
+
+
+/**
+ * @brief Returns the next value of the access counter.
+ *
+ * @return Access counter value.
+ */
+uint64_t condor2nav::CCoordCache::Tick() const
+{
+  return ++reinterpret_cast<TFileHeader *>(_file->Data())->tick;
+}
+
+
+/**
+ * @brief Returns the size of the cache.
+ *
+ * @return The size of the cache file in bytes.
+ */
+size_t condor2nav::CCoordCache::Size() const
+{
+  const auto &header = *reinterpret_cast<const TFileHeader *>(_file->Data());
+  return sizeof(TFileHeader) + static_cast<size_t>(header.sets) * WAYS * sizeof(TEntry);
+}
+
+
+/**
+ * @brief Returns the set for the point.
+ *
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ *
+ * @return The first entry of the set.
+ */
+auto condor2nav::CCoordCache::Set(float x, float y) const -> TEntry *
+{
+  const auto &header = *reinterpret_cast<const TFileHeader *>(_file->Data());
+  const TKey key = { _landscape, _trnTime, x, y };
+  const size_t hash = HashFNV1a<CHashTraits>(boost::string_ref{reinterpret_cast<const char *>(&key), sizeof(key)});
+  auto entries = reinterpret_cast<TEntry *>(_file->Data() + sizeof(TFileHeader));
+  return entries + (hash & (header.sets - 1)) * WAYS;
+}
+
+
+/**
+ * @brief Finds converted coordinates of the point.
+ *
+ * @param x               The x coordinate.
+ * @param y               The y coordinate.
+ * @param [out] latitude  Converted latitude.
+ * @param [out] longitude Converted longitude.
+ *
+ * @return true if the point was found in the cache.
+ */
+bool condor2nav::CCoordCache::Find(float x, float y, double &latitude, double &longitude)
+{
+  CMutexLock lock{_mutex.get()};
+  TEntry *set = Set(x, y);
+  for(unsigned i=0; i<WAYS; i++) {
+    TEntry &entry = set[i];
+    if(entry.tick && entry.key.landscape == _landscape && entry.key.trnTime == _trnTime && entry.key.x == x && entry.key.y == y) {
+      entry.tick = Tick();
+      latitude = entry.latitude;
+      longitude = entry.longitude;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+/**
+ * @brief Stores converted coordinates of the point.
+ *
+ * Method replaces the least recently used entry of the set if the set is full.
+ *
+ * @param x         The x coordinate.
+ * @param y         The y coordinate.
+ * @param latitude  Converted latitude.
+ * @param longitude Converted longitude.
+ */
+void condor2nav::CCoordCache::Insert(float x, float y, double latitude, double longitude)
+{
+  CMutexLock lock{_mutex.get()};
+  TEntry *set = Set(x, y);
+  TEntry *victim = set;
+  for(unsigned i=0; i<WAYS; i++) {
+    TEntry &entry = set[i];
+    if(entry.tick && entry.key.landscape == _landscape && entry.key.trnTime == _trnTime && entry.key.x == x && entry.key.y == y) {
+      victim = &entry;
+      break;
+    }
+    if(entry.tick < victim->tick)
+      victim = &entry;
+  }
+
+  const TKey key = { _landscape, _trnTime, x, y };
+  victim->key = key;
+  victim->latitude = latitude;
+  victim->longitude = longitude;
+  victim->tick = Tick();
+}
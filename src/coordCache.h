@@ -0,0 +1,78 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file coordCache.h
+ *
+ * @brief Declares the condor2nav::CCoordCache class.
+ */
+
+#ifndef __COORDCACHE_H__
+#define __COORDCACHE_H__
+
+#include "nonCopyable.h"
+#include "tools.h"
+#include "boostfwd.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace condor2nav {
+
+  /**
+   * @brief Persistent cache of Condor coordinates conversions.
+   *
+   * condor2nav::CCoordCache stores results of Condor coordinates conversions
+   * in a memory mapped file so they survive between application runs. Entries
+   * are keyed with the landscape name, the terrain file last write time and
+   * coordinates of the point. The file is a set-associative hash table of a
+   * constant size: every key may be stored only in one of a few entries of its
+   * set and the least recently used entry of the set is replaced when the set
+   * is full. The file may be shared by many converters and processes, so every
+   * access to it is serialized with a named mutex.
+   */
+  class CCoordCache : CNonCopyable {
+    class CMappedFile;
+    struct TEntry;
+
+    CHandleRes _mutex;                                ///< @brief Named mutex serializing access to the file.
+    std::unique_ptr<CMappedFile> _file;               ///< @brief Memory mapped cache file.
+    const uint64_t _landscape;                        ///< @brief Landscape name hash.
+    const int64_t _trnTime;                           ///< @brief Terrain file last write time.
+
+    TEntry *Set(float x, float y) const;
+    uint64_t Tick() const;
+
+  public:
+    static const unsigned WAYS = 8;                   ///< @brief The number of entries in every set.
+    static const unsigned SETS_DEFAULT = 4096;        ///< @brief Default number of sets.
+
+    CCoordCache(const bfs::path &path, const std::string &landscape, int64_t trnTime, unsigned sets = SETS_DEFAULT);
+    ~CCoordCache();
+
+    size_t Size() const;
+    bool Find(float x, float y, double &latitude, double &longitude);
+    void Insert(float x, float y, double latitude, double longitude);
+  };
+
+}
+
+#endif /* __COORDCACHE_H__ */
@@ -0,0 +1,298 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file csvTokenizer.cpp
+ *
+ * @brief Implements CSV line tokenizer.
+ *
+ * Vectorized implementations process the line in 64-bytes blocks. For every
+ * block the bitmasks of commas and quotes are obtained with SIMD compares. Quoted
+ * regions are found with the prefix XOR of the quotes mask and the state is carried
+ * over to the next block, so commas inside quotes are removed from the mask without
+ * any branches. Fields are then emitted by walking set bits of the separators mask.
+ */
+
+#include "csvTokenizer.h"
+#include "tools.h"
+#include <cstdint>
+#include <cstring>
+#include <intrin.h>
+#include <immintrin.h>
+
+
+namespace {
+
+  const size_t BLOCK_SIZE = 64;                       ///< @brief Number of bytes processed at once by vectorized tokenizers.
+
+  /**
+   * @brief Bitmasks of special characters in a block.
+   */
+  struct TBlockMasks {
+    uint64_t commas;
+    uint64_t quotes;
+  };
+
+
+  /**
+   * @brief Converts raw CSV field to its value.
+   *
+   * Function removes white spaces and quotes surrounding the field.
+   *
+   * @param field The raw field text.
+   *
+   * @return Field value.
+   */
+  boost::string_ref FieldValue(boost::string_ref field)
+  {
+    condor2nav::Trim(field);
+    if(!field.empty() && field[0] == '\"')
+      // remove quotes
+      field = field.size() > 1 ? field.substr(1, field.size() - 2) : boost::string_ref{};
+    return field;
+  }
+
+
+  /**
+   * @brief Returns the index of the lowest set bit.
+   *
+   * @param mask Not zero mask.
+   *
+   * @return The index of the lowest set bit.
+   */
+  unsigned LowestBit(uint64_t mask)
+  {
+    unsigned long index;
+    if(_BitScanForward(&index, static_cast<unsigned long>(mask)))
+      return index;
+    _BitScanForward(&index, static_cast<unsigned long>(mask >> 32));
+    return index + 32;
+  }
+
+
+  /**
+   * @brief Computes prefix XOR of the mask.
+   *
+   * @param mask The mask to process.
+   *
+   * @return The mask where each bit is a XOR of the bit and all lower bits of @p mask.
+   */
+  uint64_t PrefixXor(uint64_t mask)
+  {
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+  }
+
+
+  /**
+   * @brief Finds commas and quotes in a block using SSE2 instructions.
+   *
+   * @param block 64-bytes block to process.
+   *
+   * @return Block masks.
+   */
+  TBlockMasks BlockMasksSSE2(const char *block)
+  {
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i quote = _mm_set1_epi8('\"');
+    TBlockMasks masks = { 0, 0 };
+    for(unsigned i=0; i<BLOCK_SIZE / 16; i++) {
+      const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i * 16));
+      masks.commas |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, comma)))) << (i * 16);
+      masks.quotes |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, quote)))) << (i * 16);
+    }
+    return masks;
+  }
+
+
+  /**
+   * @brief Finds commas and quotes in a block using AVX2 instructions.
+   *
+   * @param block 64-bytes block to process.
+   *
+   * @return Block masks.
+   */
+  TBlockMasks BlockMasksAVX2(const char *block)
+  {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i quote = _mm256_set1_epi8('\"');
+    TBlockMasks masks = { 0, 0 };
+    for(unsigned i=0; i<BLOCK_SIZE / 32; i++) {
+      const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + i * 32));
+      masks.commas |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, comma)))) << (i * 32);
+      masks.quotes |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, quote)))) << (i * 32);
+    }
+    return masks;
+  }
+
+
+  /**
+   * @brief Splits CSV line to fields byte by byte.
+   *
+   * @param line        The line to parse.
+   * @param [out] fields Parsed fields.
+   */
+  void TokenizeScalar(boost::string_ref line, condor2nav::CFieldViews &fields)
+  {
+    bool insideQuote = false;
+    size_t newValuePos = 0;
+    for(size_t pos = 0; pos < line.size(); ++pos) {
+      if(line[pos] == '\"') {
+        insideQuote = !insideQuote;
+      }
+      else if(line[pos] == ',' && !insideQuote) {
+        fields.push_back(FieldValue(line.substr(newValuePos, pos - newValuePos)));
+        newValuePos = pos + 1;
+      }
+    }
+    // value with not terminated quote is dropped
+    if(!insideQuote)
+      fields.push_back(FieldValue(line.substr(newValuePos)));
+  }
+
+
+  /**
+   * @brief Splits CSV line to fields using block masks.
+   *
+   * @param line        The line to parse.
+   * @param [out] fields Parsed fields.
+   */
+  template<TBlockMasks (*BlockMasks)(const char *)>
+  void TokenizeBlocks(boost::string_ref line, condor2nav::CFieldViews &fields)
+  {
+    uint64_t insideQuote = 0;                         // all bits set when block starts inside quotes
+    size_t newValuePos = 0;
+    char tail[BLOCK_SIZE];
+    for(size_t pos = 0; pos < line.size(); pos += BLOCK_SIZE) {
+      const char *block = line.data() + pos;
+      if(line.size() - pos < BLOCK_SIZE) {
+        // zero padding is neither comma nor quote
+        memset(tail, 0, BLOCK_SIZE);
+        memcpy(tail, block, line.size() - pos);
+        block = tail;
+      }
+
+      const TBlockMasks masks = BlockMasks(block);
+      const uint64_t quoted = PrefixXor(masks.quotes) ^ insideQuote;
+      insideQuote = 0 - (quoted >> 63);
+      for(uint64_t separators = masks.commas & ~quoted; separators; separators &= separators - 1) {
+        const size_t sepPos = pos + LowestBit(separators);
+        fields.push_back(FieldValue(line.substr(newValuePos, sepPos - newValuePos)));
+        newValuePos = sepPos + 1;
+      }
+    }
+    // value with not terminated quote is dropped
+    if(!insideQuote)
+      fields.push_back(FieldValue(line.substr(newValuePos)));
+  }
+
+
+  /**
+   * @brief Detects the best tokenizer supported by the CPU.
+   *
+   * @return The best tokenizer.
+   */
+  condor2nav::TCSVTokenizer Detect()
+  {
+    using condor2nav::TCSVTokenizer;
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    if(maxLeaf < 1)
+      return TCSVTokenizer::SCALAR;
+
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if(maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+      // OS saves YMM registers
+      __cpuidex(info, 7, 0);
+      if(info[1] & (1 << 5))
+        return TCSVTokenizer::AVX2;
+    }
+    return sse2 ? TCSVTokenizer::SSE2 : TCSVTokenizer::SCALAR;
+  }
+
+  const condor2nav::TCSVTokenizer bestTokenizer = Detect();   ///< @brief The best tokenizer supported by the CPU.
+
+}
+
+
+/**
+ * @brief Returns the best CSV tokenizer.
+ *
+ * Function returns the fastest CSV tokenizer implementation supported by the CPU.
+ *
+ * @return The best tokenizer.
+ */
+condor2nav::TCSVTokenizer condor2nav::CSVTokenizerBest()
+{
+  return bestTokenizer;
+}
+
+
+/**
+ * @brief Splits CSV line to fields.
+ *
+ * Function splits the line to fields separated by commas that are not inside
+ * quotes. White spaces and quotes surrounding every field are removed. A field with
+ * not terminated quote is dropped. Fields are views of the @p line so no
+ * characters are copied. The fastest implementation supported by the CPU is used.
+ *
+ * @param line        The line to parse.
+ * @param [out] fields Parsed fields.
+ */
+void condor2nav::CSVTokenize(boost::string_ref line, CFieldViews &fields)
+{
+  CSVTokenize(line, fields, bestTokenizer);
+}
+
+
+/**
+ * @brief Splits CSV line to fields.
+ *
+ * Function splits the line to fields using the provided implementation.
+ *
+ * @param line        The line to parse.
+ * @param [out] fields Parsed fields.
+ * @param tokenizer   The implementation to use (has to be supported by the CPU).
+ */
+void condor2nav::CSVTokenize(boost::string_ref line, CFieldViews &fields, TCSVTokenizer tokenizer)
+{
+  fields.clear();
+  switch(tokenizer) {
+  case TCSVTokenizer::SCALAR:
+    TokenizeScalar(line, fields);
+    break;
+  case TCSVTokenizer::SSE2:
+    TokenizeBlocks<BlockMasksSSE2>(line, fields);
+    break;
+  case TCSVTokenizer::AVX2:
+    TokenizeBlocks<BlockMasksAVX2>(line, fields);
+    break;
+  }
+}
@@ -0,0 +1,53 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file csvTokenizer.h
+ *
+ * @brief Declares CSV line tokenizer.
+ */
+
+#ifndef __CSVTOKENIZER_H__
+#define __CSVTOKENIZER_H__
+
+#include <vector>
+#include <boost/utility/string_ref.hpp>
+
+namespace condor2nav {
+
+  using CFieldViews = std::vector<boost::string_ref>;    ///< @brief The views of CSV line fields.
+
+  /*
+   * @brief CSV tokenizer implementations
+   */
+  enum class TCSVTokenizer {
+    SCALAR,                             ///< @brief Byte by byte implementation.
+    SSE2,                               ///< @brief 16-bytes vectors implementation.
+    AVX2                                ///< @brief 32-bytes vectors implementation.
+  };
+
+  TCSVTokenizer CSVTokenizerBest();
+  void CSVTokenize(boost::string_ref line, CFieldViews &fields);
+  void CSVTokenize(boost::string_ref line, CFieldViews &fields, TCSVTokenizer tokenizer);
+
+}
+
+#endif /* __CSVTOKENIZER_H__ */
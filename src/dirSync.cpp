@@ -0,0 +1,293 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file dirSync.cpp
+ *
+ * @brief Implements the condor2nav::CDirSync class.
+ *
+ * Manifest file contains one line per file:
+ * <XXH64 hash (hex)> <size> <last write time> <file name>
+ */
+
+#include "dirSync.h"
+#include "hashTable.h"
+#include "tools.h"
+#include "transfer.h"
+#include "vfs.h"
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <sstream>
+#include <thread>
+
+const char *condor2nav::CDirSync::MANIFEST_NAME = "Condor2Nav.sync";
+const bfs::path condor2nav::CDirSync::CACHE_PATH = bfs::path{"data"} / "Cache" / "Sync";
+
+
+/**
+ * @brief Returns the path of the source directory manifest.
+ *
+ * Source manifests are kept in the cache directory so source directories
+ * are never written.
+ *
+ * @param srcDir Local source directory.
+ *
+ * @return The path of the manifest file.
+ */
+bfs::path condor2nav::CDirSync::SourceManifestPath(const bfs::path &srcDir)
+{
+  return CACHE_PATH / (Convert(HashFNV1a<CHashTraitsNoCase>(bfs::absolute(srcDir).string())) + ".sync");
+}
+
+
+/**
+ * @brief Calculates the hash of a local file.
+ *
+ * @param path The path of the file.
+ *
+ * @return XXH64 hash of the whole file.
+ *
+ * @exception EOperationFailed Thrown when the file cannot be read.
+ */
+uint64_t condor2nav::CDirSync::Checksum(const bfs::path &path)
+{
+  class CHashSink : public CTransfer::CSink {
+    CHashXXH64 &_hash;
+  public:
+    explicit CHashSink(CHashXXH64 &hash) : _hash(hash) {}
+    void Write(const char *data, size_t size) override { _hash.Update(boost::string_ref{data, size}); }
+  };
+
+  CHashXXH64 hash;
+  CTransfer::CFileSource source{path};
+  CHashSink sink{hash};
+  CTransfer{}.Run(source, sink);
+  return hash.Digest();
+}
+
+
+/**
+ * @brief Reads the manifest file.
+ *
+ * Malformed lines are ignored.
+ *
+ * @param path The path of the manifest file.
+ *
+ * @return Manifest entries (empty if the file does not exist).
+ */
+auto condor2nav::CDirSync::ManifestRead(const bfs::path &path) -> CManifest
+{
+  CManifest manifest;
+  auto &vfs = CVfs::Instance(path);
+  CVfs::TStat stat;
+  if(!vfs.Stat(path, stat))
+    return manifest;
+
+  std::istringstream stream{vfs.Read(path)};
+  std::string line;
+  while(std::getline(stream, line)) {
+    std::istringstream str{line};
+    TEntry entry;
+    std::string name;
+    str >> std::hex >> entry.checksum >> std::dec >> entry.size >> entry.time;
+    str.ignore(1);
+    if(str && std::getline(str, name) && !name.empty())
+      manifest[name] = entry;
+  }
+  return manifest;
+}
+
+
+/**
+ * @brief Returns the content of the manifest file.
+ *
+ * @param manifest Manifest entries.
+ *
+ * @return Manifest file content.
+ */
+std::string condor2nav::CDirSync::ManifestData(const CManifest &manifest)
+{
+  std::ostringstream stream;
+  for(auto &entry : manifest)
+    stream << std::hex << entry.second.checksum << std::dec << " " << entry.second.size << " " << entry.second.time << " " << entry.first << "\n";
+  return stream.str();
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CDirSync class constructor.
+ *
+ * @param log Logger used to report progress.
+ */
+condor2nav::CDirSync::CDirSync(const CCondor2Nav::CLogger &log) :
+  _log(log)
+{
+}
+
+
+/**
+ * @brief Synchronizes the directories.
+ *
+ * Copies all the files of @p srcDir that are missing or changed in @p destDir.
+ * Files that could not be copied are not recorded in the target manifest so
+ * they are copied again next time.
+ *
+ * @param srcDir  Local source directory.
+ * @param destDir Target directory.
+ *
+ * @return Synchronization statistics.
+ *
+ * @exception EOperationFailed The error of the first file that could not be copied.
+ */
+auto condor2nav::CDirSync::Run(const bfs::path &srcDir, const bfs::path &destDir) const -> TStats
+{
+  struct TFile {
+    std::string name;                                 ///< @brief File name.
+    TEntry entry;                                     ///< @brief Source file information.
+  };
+
+  TStats stats = { 0, 0, 0, 0 };
+
+  // update the source manifest
+  auto &srcVfs = CVfs::Instance(srcDir);
+  const auto srcManifestPath = SourceManifestPath(srcDir);
+  bfs::create_directories(CACHE_PATH);
+  const auto srcManifest = ManifestRead(srcManifestPath);
+  CManifest srcFiles;
+  for(auto &path : srcVfs.List(srcDir)) {
+    const auto name = path.filename().string();
+    CVfs::TStat stat;
+    if(name == MANIFEST_NAME || !srcVfs.Stat(path, stat) || stat.directory)
+      continue;
+    TEntry entry = { stat.size, stat.time, 0 };
+    auto it = srcManifest.find(name);
+    if(it != srcManifest.end() && it->second.size == entry.size && it->second.time == entry.time)
+      entry.checksum = it->second.checksum;
+    else
+      entry.checksum = Checksum(path);
+    srcFiles[name] = entry;
+  }
+  if(srcFiles.size() != srcManifest.size() ||
+     !std::equal(srcFiles.begin(), srcFiles.end(), srcManifest.begin(), [](const CManifest::value_type &l, const CManifest::value_type &r) {
+       return l.first == r.first && l.second.size == r.second.size && l.second.time == r.second.time && l.second.checksum == r.second.checksum;
+     })) {
+    const auto data = ManifestData(srcFiles);
+    CVfs::Instance(srcManifestPath).Write(srcManifestPath, { data });
+  }
+
+  // find missing and changed files
+  auto &destVfs = CVfs::Instance(destDir);
+  const auto destManifestPath = destDir / MANIFEST_NAME;
+  auto destManifest = ManifestRead(destManifestPath);
+  std::vector<TFile> copies;
+  for(auto &file : srcFiles) {
+    auto it = destManifest.find(file.first);
+    if(it != destManifest.end() && it->second.size == file.second.size && it->second.checksum == file.second.checksum) {
+      CVfs::TStat stat;
+      if(destVfs.Stat(destDir / file.first, stat) && !stat.directory && stat.size == it->second.size && stat.time == it->second.time) {
+        stats.filesSkipped++;
+        stats.bytesSaved += file.second.size;
+        continue;
+      }
+    }
+    destManifest.erase(file.first);
+    const TFile copy = { file.first, file.second };
+    copies.push_back(copy);
+  }
+
+  // copy files
+  std::vector<std::exception_ptr> errors(copies.size());
+  std::vector<int64_t> times(copies.size());
+  auto copy = [&](size_t index, const CTransfer::FProgress &progress) {
+    try {
+      const auto dest = destDir / copies[index].name;
+      destVfs.Upload(srcDir / copies[index].name, dest, progress);
+      CVfs::TStat stat;
+      if(!destVfs.Stat(dest, stat))
+        throw EOperationFailed{"ERROR: Couldn't copy file '" + dest.string() + "'!!!"};
+      times[index] = stat.time;
+    }
+    catch(...) {
+      errors[index] = std::current_exception();
+    }
+  };
+
+  if(destVfs.Type() == TPathType::ACTIVE_SYNC) {
+    // one RAPI connection - copy one file after another
+    for(size_t i=0; i<copies.size(); i++)
+      copy(i, CTransfer::ProgressLog(_log, " - " + copies[i].name, 25));
+  }
+  else {
+    for(auto &file : copies)
+      _log << " - " << file.name << std::endl;
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    const size_t num = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), copies.size());
+    for(size_t i=0; i<num; i++)
+      workers.emplace_back([&]{
+        for(size_t index = next++; index < copies.size(); index = next++)
+          copy(index, CTransfer::FProgress());
+      });
+    for(auto &worker : workers)
+      worker.join();
+  }
+
+  // record copied files
+  std::exception_ptr error;
+  for(size_t i=0; i<copies.size(); i++) {
+    if(errors[i]) {
+      if(!error)
+        error = errors[i];
+      continue;
+    }
+    const TEntry entry = { copies[i].entry.size, times[i], copies[i].entry.checksum };
+    destManifest[copies[i].name] = entry;
+    stats.filesCopied++;
+    stats.bytesCopied += entry.size;
+  }
+  if(!copies.empty()) {
+    // uploaded directly (after all the operations queued in ActiveSync batch) as the copied files
+    const auto uploadPath = srcManifestPath.string() + ".upload";
+    {
+      CTransfer::CFileSink sink{uploadPath};
+      const auto data = ManifestData(destManifest);
+      sink.Write(data.data(), data.size());
+    }
+    try {
+      destVfs.Upload(uploadPath, destManifestPath);
+    }
+    catch(...) {
+      boost::system::error_code ec;
+      bfs::remove(uploadPath, ec);
+      throw;
+    }
+    boost::system::error_code ec;
+    bfs::remove(uploadPath, ec);
+  }
+  if(error)
+    std::rethrow_exception(error);
+
+  return stats;
+}
@@ -0,0 +1,97 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file dirSync.h
+ *
+ * @brief Declares the condor2nav::CDirSync class.
+ */
+
+#ifndef __DIRSYNC_H__
+#define __DIRSYNC_H__
+
+#include "condor2nav.h"
+#include "nonCopyable.h"
+#include "boostfwd.h"
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace condor2nav {
+
+  /**
+   * @brief Delta synchronization of a local directory.
+   *
+   * condor2nav::CDirSync copies the files of a local directory to a target
+   * directory (local, on ActiveSync device or in any other condor2nav::CVfs)
+   * only if they are missing or changed there. Both directories have
+   * a manifest with the size, the last write time and the XXH64 hash of
+   * every file. The source manifest is kept in the cache directory and allows
+   * not to hash unchanged source files again. The target manifest is kept in
+   * the target directory, describes the files copied before and is trusted
+   * only if the target file still has the recorded size and last write time.
+   * It is uploaded like the copied files so it is written after all the
+   * operations queued in condor2nav::CActiveSync::CBatch. Files are copied
+   * in parallel to local targets and one after another over ActiveSync.
+   * Target files not present in the source directory are left untouched.
+   */
+  class CDirSync : CNonCopyable {
+  public:
+    /**
+     * @brief Synchronization statistics.
+     */
+    struct TStats {
+      unsigned filesCopied;                           ///< @brief The number of files copied.
+      uint64_t bytesCopied;                           ///< @brief The number of bytes copied.
+      unsigned filesSkipped;                          ///< @brief The number of up to date files not copied.
+      uint64_t bytesSaved;                            ///< @brief The number of bytes not copied.
+    };
+
+    static const char *MANIFEST_NAME;                 ///< @brief The name of the manifest file in the target directory.
+    static const bfs::path CACHE_PATH;                ///< @brief Source directories manifests directory path.
+
+  private:
+    /**
+     * @brief Manifest entry.
+     */
+    struct TEntry {
+      uint64_t size;                                  ///< @brief File size.
+      int64_t time;                                   ///< @brief File last write time.
+      uint64_t checksum;                              ///< @brief File content XXH64 hash.
+    };
+    using CManifest = std::map<std::string, TEntry>;
+
+    const CCondor2Nav::CLogger &_log;                 ///< @brief Logger used to report progress.
+
+    static CManifest ManifestRead(const bfs::path &path);
+    static std::string ManifestData(const CManifest &manifest);
+
+  public:
+    static bfs::path SourceManifestPath(const bfs::path &srcDir);
+    static uint64_t Checksum(const bfs::path &path);
+
+    explicit CDirSync(const CCondor2Nav::CLogger &log);
+    TStats Run(const bfs::path &srcDir, const bfs::path &destDir) const;
+  };
+
+}
+
+#endif /* __DIRSYNC_H__ */
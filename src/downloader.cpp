@@ -0,0 +1,865 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file downloader.cpp
+ *
+ * @brief Implements the condor2nav::CDownloader class.
+ */
+
+#include "downloader.h"
+#include <boost/asio.hpp>
+#include "transfer.h"     // has to be included after boost/asio
+#include "httpCache.h"
+#include "traitsNoCase.h"
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <deque>
+#include <istream>
+#include <map>
+#include <sstream>
+
+const condor2nav::CDownloader::TConfig condor2nav::CDownloader::DEFAULT_CONFIG = { 8, 4, 2, 1000 };
+const char *condor2nav::CDownloader::PART_EXTENSION = ".part";
+const char *condor2nav::CDownloader::VALIDATOR_EXTENSION = ".validator";
+
+
+namespace {
+
+  /**
+   * @brief Memory buffer data sink.
+   */
+  class CStringSink : public condor2nav::CTransfer::CSink {
+    std::string &_str;
+  public:
+    explicit CStringSink(std::string &str) : _str(str) { _str.clear(); }
+    void Write(const char *data, size_t size) override { _str.append(data, size); }
+    void Reserve(uint64_t size) override { _str.reserve(_str.size() + static_cast<size_t>(size)); }
+  };
+
+}
+
+
+/**
+ * @brief Single download attempt.
+ *
+ * condor2nav::CDownloader::CAttempt sends HTTP/1.1 request over a kept alive
+ * connection (or resolves the server name and connects to it first) and
+ * streams the body of the response to the temporary file or to the memory
+ * buffer. If the temporary file already exists only the missing part of the
+ * file is requested, provided that the resource still matches the validator
+ * stored next to the temporary file. Every step is asynchronous and keeps the object alive
+ * until the next one is started. The result is reported with the finish
+ * callback exactly once.
+ */
+class condor2nav::CDownloader::CAttempt : public std::enable_shared_from_this<CAttempt>, CNonCopyable {
+public:
+  using CSocket = boost::asio::ip::tcp::socket;
+
+  /**
+   * @brief Attempt completion callback.
+   *
+   * @param error      Attempt error (nullptr on success).
+   * @param retry      Specifies if the download may succeed when retried.
+   * @param connection The connection that may be reused (nullptr if closed).
+   */
+  using FFinish = std::function<void(std::exception_ptr error, bool retry, std::shared_ptr<CSocket> connection)>;
+
+private:
+  /**
+   * @brief Response body framing.
+   */
+  enum class TBody {
+    LENGTH,                                           ///< @brief The size is given with Content-Length header.
+    CHUNKED,                                          ///< @brief Chunked transfer encoding.
+    CLOSE                                             ///< @brief The body ends when the server closes the connection.
+  };
+
+  static const uint64_t UNKNOWN = static_cast<uint64_t>(-1);   ///< @brief Unknown size.
+
+  boost::asio::io_service &_io;                       ///< @brief I/O service running the attempt.
+  const TRequest &_request;                           ///< @brief Download request.
+  CHttpCache *_cache;                                 ///< @brief HTTP validators cache (nullptr if not used).
+  std::string _host;                                  ///< @brief Server name.
+  std::string _port;                                  ///< @brief Server port or service name.
+  boost::asio::ip::tcp::resolver _resolver;           ///< @brief Server name resolver.
+  std::shared_ptr<CSocket> _socket;                   ///< @brief Server connection.
+  bool _reused;                                       ///< @brief Set when the connection was kept alive by a previous download.
+  boost::asio::deadline_timer _timer;                 ///< @brief Attempt timeout timer.
+  std::string _requestData;                           ///< @brief HTTP request being sent.
+  boost::asio::streambuf _response;                   ///< @brief Received and not processed response data.
+  std::unique_ptr<CTransfer::CSink> _sink;            ///< @brief Response body destination.
+  CTransfer::CFileSink *_file;                        ///< @brief Temporary file (if downloading to the file).
+  uint64_t _offset;                                   ///< @brief The size of the file part downloaded previously.
+  uint64_t _remaining;                                ///< @brief The number of bytes remaining in the body or current chunk.
+  TBody _body;                                        ///< @brief Response body framing.
+  bool _chunkEnd;                                     ///< @brief Set when CRLF following the chunk data is expected.
+  bool _keepAlive;                                    ///< @brief Set when the connection may be reused after the response.
+  const CHttpCache::TEntry *_cached;                  ///< @brief Cached resource validated with the request.
+  std::string _etag;                                  ///< @brief ETag of the response.
+  std::string _lastModified;                          ///< @brief Last-Modified date of the response.
+  FFinish _finish;                                    ///< @brief Completion callback.
+  bool _timedOut;                                     ///< @brief Set when attempt timeout expired.
+  bool _cancelled;                                    ///< @brief Set when attempt was cancelled.
+
+  std::string Name() const { return _request.server + _request.url; }
+  bfs::path PartPath() const { return _request.fileName + PART_EXTENSION; }
+  bfs::path ValidatorPath() const { return _request.fileName + PART_EXTENSION + VALIDATOR_EXTENSION; }
+  void PartRemove() const;
+  std::string ValidatorRead() const;
+  void ValidatorWrite() const;
+  void Close();
+  void Connect();
+  void Fail(const boost::system::error_code &error, const std::string &what);
+  void Finish(std::exception_ptr error, bool retry);
+  void OnResolve(const boost::system::error_code &error, boost::asio::ip::tcp::resolver::iterator it);
+  void RequestSend();
+  void OnRequestSent(const boost::system::error_code &error);
+  void OnHeader(const boost::system::error_code &error);
+  void DataRead();
+  void OnData(const boost::system::error_code &error);
+  void ChunkSizeRead();
+  void OnChunkSize(const boost::system::error_code &error);
+  void TrailerRead();
+  void OnTrailer(const boost::system::error_code &error);
+  void Complete();
+
+public:
+  CAttempt(boost::asio::io_service &io, const TRequest &request, CHttpCache *cache);
+  void Start(const FFinish &finish, std::shared_ptr<CSocket> connection);
+  void Cancel();
+};
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CDownloader::CAttempt class constructor.
+ *
+ * @param io      I/O service running the attempt.
+ * @param request Download request.
+ * @param cache   HTTP validators cache (nullptr if not used).
+ */
+condor2nav::CDownloader::CAttempt::CAttempt(boost::asio::io_service &io, const TRequest &request, CHttpCache *cache) :
+  _io(io), _request(request), _cache(cache), _resolver{io}, _reused{false}, _timer{io}, _response{CTransfer::CHUNK_SIZE},
+  _file{nullptr}, _offset{0}, _remaining{0}, _body{TBody::CLOSE}, _chunkEnd{false}, _keepAlive{false},
+  _cached{nullptr}, _timedOut{false}, _cancelled{false}
+{
+  const auto pos = _request.server.find_last_of(':');
+  _host = _request.server.substr(0, pos);
+  _port = pos != std::string::npos ? _request.server.substr(pos + 1) : "http";
+}
+
+
+/**
+ * @brief Starts the attempt.
+ *
+ * @param finish     Completion callback.
+ * @param connection Kept alive connection to the server (nullptr if a new one should be opened).
+ */
+void condor2nav::CDownloader::CAttempt::Start(const FFinish &finish, std::shared_ptr<CSocket> connection)
+{
+  _finish = finish;
+  auto self = shared_from_this();
+  _timer.expires_from_now(boost::posix_time::seconds(_request.timeout));
+  _timer.async_wait([self](const boost::system::error_code &error) {
+    if(!error && self->_finish) {
+      self->_timedOut = true;
+      self->Close();
+    }
+  });
+
+  if(connection) {
+    _socket = connection;
+    _reused = true;
+    RequestSend();
+  }
+  else {
+    Connect();
+  }
+}
+
+
+/**
+ * @brief Cancels the attempt.
+ *
+ * Pending operation is aborted and the attempt finishes with an error
+ * that is not retried.
+ */
+void condor2nav::CDownloader::CAttempt::Cancel()
+{
+  _cancelled = true;
+  Close();
+}
+
+
+/**
+ * @brief Aborts pending network operations.
+ */
+void condor2nav::CDownloader::CAttempt::Close()
+{
+  boost::system::error_code ignored;
+  _resolver.cancel();
+  if(_socket)
+    _socket->close(ignored);
+}
+
+
+/**
+ * @brief Opens a new connection to the server.
+ */
+void condor2nav::CDownloader::CAttempt::Connect()
+{
+  _reused = false;
+  _socket = std::make_shared<CSocket>(_io);
+  _response.consume(_response.size());
+  auto self = shared_from_this();
+  _resolver.async_resolve(boost::asio::ip::tcp::resolver::query{_host, _port},
+                          [self](const boost::system::error_code &error, boost::asio::ip::tcp::resolver::iterator it) { self->OnResolve(error, it); });
+}
+
+
+/**
+ * @brief Finishes the attempt with a network error.
+ *
+ * If the server closed a kept alive connection before responding, the
+ * request is sent again over a new connection.
+ *
+ * @param error Network error.
+ * @param what  The description of the failed operation.
+ */
+void condor2nav::CDownloader::CAttempt::Fail(const boost::system::error_code &error, const std::string &what)
+{
+  if(_cancelled)
+    Finish(std::make_exception_ptr(EOperationFailed{"ERROR: Download of '" + Name() + "' aborted!!!"}), false);
+  else if(_timedOut)
+    Finish(std::make_exception_ptr(EOperationFailed{"ERROR: Download timeout (" + Convert(_request.timeout) + " seconds) exceeded!"}), true);
+  else if(_reused && !_sink)
+    Connect();
+  else
+    Finish(std::make_exception_ptr(EOperationFailed{"ERROR: " + what + ": '" + Name() + "', error: " + error.message()}), true);
+}
+
+
+/**
+ * @brief Finishes the attempt.
+ *
+ * On error the temporary file is truncated to the data received so far, so
+ * the next attempt may resume the download. The file is removed if the
+ * download is not going to be retried.
+ *
+ * @param error Attempt error (nullptr on success).
+ * @param retry Specifies if the download may succeed when retried.
+ */
+void condor2nav::CDownloader::CAttempt::Finish(std::exception_ptr error, bool retry)
+{
+  if(!_finish)
+    return;
+  _timer.cancel();
+  std::shared_ptr<CSocket> connection;
+  if(!error && _keepAlive)
+    connection = _socket;
+  else
+    Close();
+
+  if(error) {
+    if(_file) {
+      try {
+        _file->Truncate();
+      }
+      catch(const EOperationFailed &) {
+        retry = false;
+      }
+    }
+    _sink.reset();
+    _file = nullptr;
+    if(_request.buffer)
+      _request.buffer->clear();
+    else if(!retry && !_cancelled)
+      PartRemove();
+  }
+
+  auto finish = _finish;
+  _finish = nullptr;
+  finish(error, retry, connection);
+}
+
+
+/**
+ * @brief Connects to the resolved server.
+ */
+void condor2nav::CDownloader::CAttempt::OnResolve(const boost::system::error_code &error, boost::asio::ip::tcp::resolver::iterator it)
+{
+  if(error || _timedOut || _cancelled)
+    return Fail(error ? error : boost::asio::error::operation_aborted, "Unable to connect to");
+  auto self = shared_from_this();
+  boost::asio::async_connect(*_socket, it, [self](const boost::system::error_code &error, boost::asio::ip::tcp::resolver::iterator) {
+    if(error)
+      return self->Fail(error, "Unable to connect to");
+    self->RequestSend();
+  });
+}
+
+
+/**
+ * @brief Removes the temporary file and its validator.
+ */
+void condor2nav::CDownloader::CAttempt::PartRemove() const
+{
+  boost::system::error_code ignored;
+  bfs::remove(PartPath(), ignored);
+  bfs::remove(ValidatorPath(), ignored);
+}
+
+
+/**
+ * @brief Reads the validator of the temporary file.
+ *
+ * @return The validator to send with If-Range header (empty if not available).
+ */
+std::string condor2nav::CDownloader::CAttempt::ValidatorRead() const
+{
+  bfs::ifstream stream{ValidatorPath(), std::ios_base::in | std::ios_base::binary};
+  std::string validator;
+  std::getline(stream, validator);
+  return validator;
+}
+
+
+/**
+ * @brief Stores the validator of the response that created the temporary file.
+ *
+ * Strong ETag is preferred as weak ones may not be used in range requests.
+ * If the response does not provide any validator the temporary file will
+ * not be resumed.
+ */
+void condor2nav::CDownloader::CAttempt::ValidatorWrite() const
+{
+  std::string validator;
+  if(!_etag.empty() && _etag.compare(0, 2, "W/") != 0)
+    validator = _etag;
+  else
+    validator = _lastModified;
+
+  boost::system::error_code ignored;
+  bfs::remove(ValidatorPath(), ignored);
+  if(!validator.empty()) {
+    bfs::ofstream stream{ValidatorPath(), std::ios_base::out | std::ios_base::binary};
+    stream << validator << "\n";
+  }
+}
+
+
+/**
+ * @brief Sends HTTP request.
+ *
+ * If a part of the file was downloaded before only the rest of the file is
+ * requested under the condition that the resource was not modified since.
+ * A part without a validator cannot be verified and is downloaded again.
+ * Otherwise, if the resource is cached, it is requested only if modified.
+ */
+void condor2nav::CDownloader::CAttempt::RequestSend()
+{
+  _offset = 0;
+  std::string validator;
+  boost::system::error_code ignored;
+  if(!_request.buffer && bfs::exists(PartPath(), ignored)) {
+    _offset = bfs::file_size(PartPath(), ignored);
+    if(_offset == static_cast<uint64_t>(-1))
+      _offset = 0;
+    validator = ValidatorRead();
+    if(validator.empty()) {
+      PartRemove();
+      _offset = 0;
+    }
+  }
+
+  _requestData = "GET " + _request.url + " HTTP/1.1\r\n"
+                 "Host: " + _request.server + "\r\n"
+                 "Accept: */*\r\n";
+  _cached = nullptr;
+  if(_offset) {
+    _requestData += "Range: bytes=" + Convert(_offset) + "-\r\n"
+                    "If-Range: " + validator + "\r\n";
+  }
+  else if(_cache) {
+    _cached = _cache->Find(Name());
+    if(_cached && !_request.buffer && _cached->body != _request.fileName)
+      _cached = nullptr;
+    if(_cached && _request.buffer && !_cache->BodyRead(Name(), *_request.buffer)) {
+      _cache->Remove(Name());
+      _cached = nullptr;
+    }
+    if(_cached && !_cached->etag.empty())
+      _requestData += "If-None-Match: " + _cached->etag + "\r\n";
+    if(_cached && !_cached->lastModified.empty())
+      _requestData += "If-Modified-Since: " + _cached->lastModified + "\r\n";
+  }
+  _requestData += "\r\n";
+
+  auto self = shared_from_this();
+  boost::asio::async_write(*_socket, boost::asio::buffer(_requestData), [self](const boost::system::error_code &error, size_t) { self->OnRequestSent(error); });
+}
+
+
+/**
+ * @brief Reads HTTP response headers.
+ */
+void condor2nav::CDownloader::CAttempt::OnRequestSent(const boost::system::error_code &error)
+{
+  if(error)
+    return Fail(error, "Unable to download");
+  auto self = shared_from_this();
+  boost::asio::async_read_until(*_socket, _response, "\r\n\r\n", [self](const boost::system::error_code &error, size_t) { self->OnHeader(error); });
+}
+
+
+/**
+ * @brief Verifies HTTP response headers and opens the body destination.
+ *
+ * Server errors (5xx) may be retried. Any other status than 200 (or 206 for
+ * a range request) finishes the download with an error.
+ */
+void condor2nav::CDownloader::CAttempt::OnHeader(const boost::system::error_code &error)
+{
+  if(error)
+    return Fail(error, "Unable to download");
+
+  try {
+    std::istream stream{&_response};
+    std::string version;
+    unsigned status = 0;
+    std::string message;
+    stream >> version >> status;
+    std::getline(stream, message);
+    if(!stream || version.substr(0, 5) != "HTTP/")
+      return Finish(std::make_exception_ptr(EOperationFailed{"ERROR: Invalid response from: '" + Name() + "'"}), false);
+
+    uint64_t contentLength = UNKNOWN;
+    uint64_t rangeBegin = UNKNOWN;
+    bool chunked = false;
+    CStringNoCase connection;
+    std::string header;
+    while(std::getline(stream, header) && header != "\r") {
+      const auto colon = header.find(':');
+      if(colon == std::string::npos)
+        continue;
+      const CStringNoCase name{header.substr(0, colon).c_str()};
+      std::string value = header.substr(colon + 1);
+      Trim(value);
+      if(name == "Content-Length")
+        contentLength = Convert<uint64_t>(value);
+      else if(name == "Transfer-Encoding")
+        chunked = CStringNoCase{value.c_str()}.find("chunked") != CStringNoCase::npos;
+      else if(name == "Connection")
+        connection = value.c_str();
+      else if(name == "Content-Range" && value.compare(0, 6, "bytes ") == 0)
+        rangeBegin = Convert<uint64_t>(value.substr(6, value.find('-') - 6));
+      else if(name == "ETag")
+        _etag = value;
+      else if(name == "Last-Modified")
+        _lastModified = value;
+    }
+    _keepAlive = version == "HTTP/1.1" ? connection != "close" : connection == "keep-alive";
+
+    if(status == 304 && _cached) {
+      // not modified - cached body was already read to the buffer
+      return Finish(nullptr, false);
+    }
+    if(status == 416 && _offset) {
+      // the file changed on the server - start from the beginning
+      PartRemove();
+      return Finish(std::make_exception_ptr(EOperationFailed{"ERROR: '" + Name() + "' does not match already downloaded part"}), true);
+    }
+    if(status != 200 && status != 206)
+      return Finish(std::make_exception_ptr(EOperationFailed{"ERROR: '" + Name() + "' returned a response with status code: " + Convert(status)}), status >= 500);
+    if(status == 206 && rangeBegin != _offset)
+      return Finish(std::make_exception_ptr(EOperationFailed{"ERROR: Invalid response from: '" + Name() + "'"}), false);
+
+    if(_request.buffer)
+      _sink = std::make_unique<CStringSink>(*_request.buffer);
+    else {
+      // the server sends the whole file if it was modified or if it ignores range requests
+      auto file = std::make_unique<CTransfer::CFileSink>(PartPath(), status == 206);
+      _file = file.get();
+      _sink = std::move(file);
+      if(status == 200)
+        ValidatorWrite();
+    }
+
+    if(chunked) {
+      _body = TBody::CHUNKED;
+      return ChunkSizeRead();
+    }
+    if(contentLength != UNKNOWN) {
+      _body = TBody::LENGTH;
+      _remaining = contentLength;
+      _sink->Reserve(contentLength);
+    }
+    else {
+      _body = TBody::CLOSE;
+      _remaining = UNKNOWN;
+      _keepAlive = false;
+    }
+  }
+  catch(...) {
+    return Finish(std::current_exception(), false);
+  }
+  DataRead();
+}
+
+
+/**
+ * @brief Writes available body data to the destination and reads more.
+ *
+ * At most condor2nav::CTransfer::CHUNK_SIZE bytes are received at once.
+ */
+void condor2nav::CDownloader::CAttempt::DataRead()
+{
+  try {
+    while(_remaining && _response.size()) {
+      const size_t size = static_cast<size_t>(std::min<uint64_t>(_remaining, _response.size()));
+      _sink->Write(boost::asio::buffer_cast<const char *>(_response.data()), size);
+      _response.consume(size);
+      if(_remaining != UNKNOWN)
+        _remaining -= size;
+    }
+  }
+  catch(...) {
+    return Finish(std::current_exception(), false);
+  }
+
+  if(!_remaining) {
+    if(_body == TBody::CHUNKED) {
+      _chunkEnd = true;
+      return ChunkSizeRead();
+    }
+    return Complete();
+  }
+
+  auto self = shared_from_this();
+  boost::asio::async_read(*_socket, _response, boost::asio::transfer_at_least(1), [self](const boost::system::error_code &error, size_t) { self->OnData(error); });
+}
+
+
+/**
+ * @brief Processes received body data.
+ */
+void condor2nav::CDownloader::CAttempt::OnData(const boost::system::error_code &error)
+{
+  if(error == boost::asio::error::eof && _body == TBody::CLOSE)
+    return Complete();
+  if(error)
+    return Fail(error, "Unable to download");
+  DataRead();
+}
+
+
+/**
+ * @brief Reads the size of the next chunk.
+ */
+void condor2nav::CDownloader::CAttempt::ChunkSizeRead()
+{
+  auto self = shared_from_this();
+  boost::asio::async_read_until(*_socket, _response, "\r\n", [self](const boost::system::error_code &error, size_t) { self->OnChunkSize(error); });
+}
+
+
+/**
+ * @brief Processes the chunk size line.
+ *
+ * Chunk of size 0 ends the body.
+ */
+void condor2nav::CDownloader::CAttempt::OnChunkSize(const boost::system::error_code &error)
+{
+  if(error)
+    return Fail(error, "Unable to download");
+
+  std::istream stream{&_response};
+  std::string line;
+  std::getline(stream, line);
+  if(_chunkEnd) {
+    // CRLF after the chunk data
+    _chunkEnd = false;
+    return ChunkSizeRead();
+  }
+
+  std::istringstream str{line};
+  uint64_t size;
+  if(!(str >> std::hex >> size))
+    return Finish(std::make_exception_ptr(EOperationFailed{"ERROR: Invalid response from: '" + Name() + "'"}), true);
+  if(!size)
+    return TrailerRead();
+  _remaining = size;
+  DataRead();
+}
+
+
+/**
+ * @brief Reads next trailer line of the chunked body.
+ */
+void condor2nav::CDownloader::CAttempt::TrailerRead()
+{
+  auto self = shared_from_this();
+  boost::asio::async_read_until(*_socket, _response, "\r\n", [self](const boost::system::error_code &error, size_t) { self->OnTrailer(error); });
+}
+
+
+/**
+ * @brief Processes the trailer line of the chunked body.
+ *
+ * Empty line ends the response.
+ */
+void condor2nav::CDownloader::CAttempt::OnTrailer(const boost::system::error_code &error)
+{
+  if(error)
+    return Fail(error, "Unable to download");
+
+  std::istream stream{&_response};
+  std::string line;
+  std::getline(stream, line);
+  if(line == "\r" || line.empty())
+    return Complete();
+  TrailerRead();
+}
+
+
+/**
+ * @brief Finishes successfully received response.
+ *
+ * Renames the temporary file to the destination file and updates
+ * the cache.
+ */
+void condor2nav::CDownloader::CAttempt::Complete()
+{
+  try {
+    if(_file) {
+      _file->Truncate();
+      _sink.reset();
+      _file = nullptr;
+      bfs::rename(PartPath(), _request.fileName);
+      boost::system::error_code ignored;
+      bfs::remove(ValidatorPath(), ignored);
+    }
+    _sink.reset();
+
+    if(_cache) {
+      if(_request.buffer)
+        _cache->BodyStore(Name(), _etag, _lastModified, *_request.buffer);
+      else
+        _cache->FileStore(Name(), _etag, _lastModified, _request.fileName);
+    }
+  }
+  catch(...) {
+    return Finish(std::current_exception(), false);
+  }
+  Finish(nullptr, false);
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CDownloader class constructor.
+ *
+ * @param config Scheduler configuration.
+ * @param cache  HTTP validators cache (nullptr if not used).
+ */
+condor2nav::CDownloader::CDownloader(const TConfig &config /* = DEFAULT_CONFIG */, CHttpCache *cache /* = nullptr */) :
+  _config(config), _cache(cache)
+{
+}
+
+
+/**
+ * @brief Adds a download.
+ *
+ * @param server   The server from which to download the file (optionally followed by ":port").
+ * @param url      The path on the server to the file.
+ * @param fileName Local file name.
+ * @param timeout  Single attempt timeout in seconds.
+ *
+ * @return The index of the download.
+ */
+size_t condor2nav::CDownloader::Add(const std::string &server, const bfs::path &url, const bfs::path &fileName, unsigned timeout /* = 30 */)
+{
+  const TRequest request = { server, url.generic_string(), fileName.string(), nullptr, timeout };
+  _requests.push_back(request);
+  return _requests.size() - 1;
+}
+
+
+/**
+ * @brief Adds a download to the memory buffer.
+ *
+ * @param server  The server from which to download the data (optionally followed by ":port").
+ * @param url     The path on the server to the data.
+ * @param buffer  The buffer to store the data in (has to exist until Run() returns).
+ * @param timeout Single attempt timeout in seconds.
+ *
+ * @return The index of the download.
+ */
+size_t condor2nav::CDownloader::Add(const std::string &server, const bfs::path &url, std::string &buffer, unsigned timeout /* = 30 */)
+{
+  const TRequest request = { server, url.generic_string(), "", &buffer, timeout };
+  _requests.push_back(request);
+  return _requests.size() - 1;
+}
+
+
+/**
+ * @brief Runs all the added downloads.
+ *
+ * Downloads are started in the order of Add() calls as long as the limits of
+ * concurrent downloads are not exceeded. A failed download is retried if the
+ * error was caused by the network or the server. The abort functor is polled
+ * periodically; when it returns true all running downloads are cancelled and
+ * the ones not started yet finish with an error. The list of downloads is
+ * cleared when the method returns.
+ *
+ * @param abort Functor returning true when downloads should be aborted.
+ * @param done  Callback called (by the calling thread) when any download finishes.
+ *
+ * @return Errors of all the downloads in the order of Add() calls (nullptr on success).
+ */
+std::vector<std::exception_ptr> condor2nav::CDownloader::Run(const std::function<bool()> &abort, const FDone &done /* = FDone() */)
+{
+  boost::asio::io_service io;
+  std::vector<std::exception_ptr> errors(_requests.size());
+  std::vector<unsigned> attempts(_requests.size());
+  std::deque<size_t> pending;
+  std::map<std::string, unsigned> connections;
+  std::map<std::string, std::vector<std::shared_ptr<CAttempt::CSocket>>> idle;
+  std::map<size_t, std::shared_ptr<CAttempt>> running;
+  std::map<size_t, std::shared_ptr<boost::asio::deadline_timer>> delayed;
+  boost::asio::deadline_timer abortTimer{io};
+  bool aborted = false;
+
+  for(size_t i=0; i<_requests.size(); i++) {
+    DirectoryCreate(bfs::path{_requests[i].fileName}.parent_path());
+    pending.push_back(i);
+  }
+
+  auto abortError = [&](size_t index) {
+    return std::make_exception_ptr(EOperationFailed{"ERROR: Download of '" + _requests[index].server + _requests[index].url + "' aborted!!!"});
+  };
+
+  auto complete = [&](size_t index, std::exception_ptr error) {
+    errors[index] = error;
+    if(done)
+      done(index, error);
+  };
+
+  std::function<void()> schedule;
+  schedule = [&]{
+    for(auto it = pending.begin(); it != pending.end() && running.size() < _config.concurrency;) {
+      const size_t index = *it;
+      auto &hostConnections = connections[_requests[index].server];
+      if(hostConnections >= _config.hostConnections) {
+        ++it;
+        continue;
+      }
+      it = pending.erase(it);
+      hostConnections++;
+      attempts[index]++;
+
+      // reuse kept alive connection if available
+      std::shared_ptr<CAttempt::CSocket> connection;
+      auto &hostIdle = idle[_requests[index].server];
+      if(!hostIdle.empty()) {
+        connection = hostIdle.back();
+        hostIdle.pop_back();
+      }
+
+      auto attempt = std::make_shared<CAttempt>(io, _requests[index], _cache);
+      running[index] = attempt;
+      attempt->Start([&, index](std::exception_ptr error, bool retry, std::shared_ptr<CAttempt::CSocket> keptAlive) {
+        connections[_requests[index].server]--;
+        if(keptAlive && !aborted)
+          idle[_requests[index].server].push_back(keptAlive);
+        running.erase(index);
+        if(error && retry && !aborted && attempts[index] <= _config.retries) {
+          // retry with exponential backoff
+          auto timer = std::make_shared<boost::asio::deadline_timer>(io, boost::posix_time::milliseconds(_config.backoff << (attempts[index] - 1)));
+          delayed[index] = timer;
+          timer->async_wait([&, index, timer](const boost::system::error_code &) {
+            delayed.erase(index);
+            if(aborted)
+              complete(index, abortError(index));
+            else
+              pending.push_back(index);
+            schedule();
+          });
+        }
+        else {
+          complete(index, error);
+        }
+        schedule();
+      }, connection);
+    }
+
+    if(pending.empty() && running.empty() && delayed.empty())
+      abortTimer.cancel();
+  };
+
+  std::function<void()> poll;
+  poll = [&]{
+    abortTimer.expires_from_now(boost::posix_time::milliseconds(ABORT_POLL_INTERVAL));
+    abortTimer.async_wait([&](const boost::system::error_code &error) {
+      if(error)
+        return;
+      if(!aborted && abort && abort()) {
+        aborted = true;
+        for(auto index : pending)
+          complete(index, abortError(index));
+        pending.clear();
+        for(auto &attempt : running)
+          attempt.second->Cancel();
+        for(auto &timer : delayed)
+          timer.second->cancel();
+      }
+      if(!pending.empty() || !running.empty() || !delayed.empty())
+        poll();
+    });
+  };
+
+  if(abort && abort()) {
+    for(auto index : pending)
+      complete(index, abortError(index));
+    pending.clear();
+  }
+  if(!pending.empty()) {
+    poll();
+    schedule();
+    io.run();
+  }
+
+  if(_cache) {
+    try {
+      _cache->Dump();
+    }
+    catch(const EOperationFailed &) {
+      // resources will be downloaded again next time
+    }
+  }
+  _requests.clear();
+  return errors;
+}
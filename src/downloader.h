@@ -0,0 +1,113 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file downloader.h
+ *
+ * @brief Declares the condor2nav::CDownloader class.
+ */
+
+#ifndef __DOWNLOADER_H__
+#define __DOWNLOADER_H__
+
+#include "nonCopyable.h"
+#include "boostfwd.h"
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace condor2nav {
+
+  class CHttpCache;
+
+  /**
+   * @brief Concurrent HTTP downloads scheduler.
+   *
+   * condor2nav::CDownloader downloads a list of files over HTTP/1.1 using
+   * asynchronous I/O driven by the calling thread. The number of downloads
+   * running at the same time is limited, and so is the number of connections
+   * opened to one server. Connections are kept alive and reused by next
+   * downloads from the same server. Response bodies (plain or chunked) are
+   * streamed in fixed-size chunks directly to the destination. Failed
+   * downloads are retried after a delay that doubles with every attempt.
+   * Files are written with a temporary extension and renamed only when
+   * complete, so an interrupted download never leaves a truncated file
+   * behind. Interrupted files are resumed with HTTP range requests
+   * conditional on the validator of the response that created the temporary
+   * file, so a part of a resource modified in the meantime is never extended
+   * with the new data. If condor2nav::CHttpCache is provided, resources
+   * downloaded before are requested conditionally and not transferred again
+   * if not modified.
+   */
+  class CDownloader : CNonCopyable {
+  public:
+    /**
+     * @brief Scheduler configuration.
+     */
+    struct TConfig {
+      unsigned concurrency;                           ///< @brief The maximum number of downloads running at the same time.
+      unsigned hostConnections;                       ///< @brief The maximum number of connections to one server.
+      unsigned retries;                               ///< @brief The number of retries of a failed download.
+      unsigned backoff;                               ///< @brief The delay before the first retry in milliseconds.
+    };
+
+    /**
+     * @brief Download completion callback.
+     *
+     * @param index The index of the download in the order of Add() calls.
+     * @param error Download error (nullptr on success).
+     */
+    using FDone = std::function<void(size_t index, std::exception_ptr error)>;
+
+    static const TConfig DEFAULT_CONFIG;              ///< @brief Default scheduler configuration.
+    static const char *PART_EXTENSION;                ///< @brief The extension of a file being downloaded.
+    static const char *VALIDATOR_EXTENSION;           ///< @brief The extension appended to the part file name for its HTTP validator.
+    static const unsigned ABORT_POLL_INTERVAL = 100;  ///< @brief Abort functor polling interval in milliseconds.
+
+  private:
+    class CAttempt;
+
+    /**
+     * @brief Download request.
+     */
+    struct TRequest {
+      std::string server;                             ///< @brief Server name (optionally followed by ":port").
+      std::string url;                                ///< @brief The path to the file on the server.
+      std::string fileName;                           ///< @brief Local file name.
+      std::string *buffer;                            ///< @brief The buffer to download to instead of the file.
+      unsigned timeout;                               ///< @brief Single attempt timeout in seconds.
+    };
+
+    const TConfig _config;                            ///< @brief Scheduler configuration.
+    CHttpCache *_cache;                               ///< @brief HTTP validators cache (nullptr if not used).
+    std::vector<TRequest> _requests;                  ///< @brief Downloads to run.
+
+  public:
+    explicit CDownloader(const TConfig &config = DEFAULT_CONFIG, CHttpCache *cache = nullptr);
+    size_t Add(const std::string &server, const bfs::path &url, const bfs::path &fileName, unsigned timeout = 30);
+    size_t Add(const std::string &server, const bfs::path &url, std::string &buffer, unsigned timeout = 30);
+    std::vector<std::exception_ptr> Run(const std::function<bool()> &abort, const FDone &done = FDone());
+  };
+
+}
+
+#endif /* __DOWNLOADER_H__ */
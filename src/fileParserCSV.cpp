@@ -1,197 +1,358 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
- * @file fileParserCSV.cpp
- *
- * @brief Implements the condor2nav::CFileParserCSV class. 
- */
-
-#include "fileParserCSV.h"
-#include "istream.h"
-#include "ostream.h"
-#include "tools.h"
-#include "traitsNoCase.h"
-#include <string>
-
-
-namespace {
-
-  /**
-  * @brief Parses the line as CSV (Comma Separated Values).
-  *
-  * Method parses the line as CSV (Comma Separated Values).
-  *
-  * @param line            The line to parse.
-  *
-  * @return Parsed values.
-  */
-  std::vector<std::string> LineParseCSV(const std::string &line)
-  {
-    using namespace condor2nav;
-    std::vector<std::string> values;
-    bool insideQuote = false;
-    size_t pos = 0, newValuePos = 0;
-    do {
-      auto posOld = pos;
-      if(insideQuote) {
-        pos = line.find_first_of("\"", posOld);
-        insideQuote = false;
-      }
-      else {
-        pos = line.find_first_of(",\"", posOld);
-        if(pos != std::string::npos && line[pos] == '\"') {
-          insideQuote = true;
-        }
-        else {
-          auto len = (pos != std::string::npos) ? (pos - newValuePos) : pos;
-          auto value = line.substr(newValuePos, len);
-          Trim(value);
-          if(!value.empty() && value[0] == '\"')
-            // remove quotes
-            value = value.substr(1, value.size() - 2);
-          values.emplace_back(std::move(value));
-          if(pos != std::string::npos)
-            newValuePos = pos + 1;
-        }
-      }
-      if(pos != std::string::npos)
-        pos++;
-    }
-    while(pos != std::string::npos);
-
-    return values;
-  }
-
-}
-
-/**
- * @brief Class constructor.
- *
- * condor2nav::CFileParserCSV class constructor.
- *
- * @param filePath The path of the CSV file to parse.
- */
-condor2nav::CFileParserCSV::CFileParserCSV(bfs::path filePath) :
-  _filePath{std::move(filePath)}
-{
-  // open CSV file
-  CIStream inputStream{filePath};
-
-  // parse all lines
-  std::string line;
-  while(inputStream.GetLine(line)) {
-    if(line.empty())
-      continue;
-    _rowsList.emplace_back(LineParseCSV(line));
-  }
-  if(_rowsList.front().size() <= 1)
-    throw EOperationFailed{"ERROR: File '" + filePath.string() + "' does not look like a CSV File!!"};
-}
-
-
-/**
- * @brief Returns requested row.
- *
- * Method returns the values from one row specified by the value in specified column.
- *
- * @param value  The value to use for searching.
- * @param column The column index to be used for value comparison.
- * @param nocase Specifies if a search should be case sensitive.
- *
- * @exception std Thrown when requested row is not found.
- *
- * @return Requested row.
- */
-auto condor2nav::CFileParserCSV::Row(const std::string &value, unsigned column /* = 0 */, bool nocase /* = false */) const -> const CStringArray &
-{
-  auto nonConst = const_cast<CFileParserCSV *>(this);
-  return nonConst->Row(value, column, nocase);
-}
-
-
-/**
- * @brief Returns requested row.
- *
- * Method returns the values from one row specified by the value in specified column.
- *
- * @param value  The value to use for searching.
- * @param column The column index to be used for value comparison.
- * @param nocase Specifies if a search should be case sensitive.
- *
- * @exception std Thrown when requested row is not found.
- *
- * @return Requested row.
- */
-auto condor2nav::CFileParserCSV::Row(const std::string &value, unsigned column /* = 0 */, bool nocase /* = false */) -> CStringArray &
-{
-  for(auto &row : _rowsList)
-    if(row.at(column) == value || (nocase && row[column].c_str() == CStringNoCase{value.c_str()}))
-      return row;
-  throw EOperationFailed{"ERROR: Couldn't find value '" + value + "' in column '" + Convert(column) + "' of CSV file '" + Path().string() + "'!!!"};
-}
-
-
-/**
- * @brief Returns all rows.
- *
- * Method returns all rows parsed from a CSV file.
- *
- * @return Rows.
- */
-auto condor2nav::CFileParserCSV::Rows() const -> const CRowsList &
-{
-  return _rowsList;
-}
-
-
-/**
- * @brief Returns all rows.
- *
- * Method returns all rows parsed from a CSV file.
- *
- * @return Rows.
- */
-auto condor2nav::CFileParserCSV::Rows() -> CRowsList &
-{
-  return _rowsList;
-}
-
-
-/**
-* @brief Dumps class data to the file.
-*
-* Method dumps class data to the file in the same format as input file has.
-*
-* @param filePath Path of the file to create (empty means overwrite input file).
-*/
-void condor2nav::CFileParserCSV::Dump(const bfs::path &filePath /* = "" */) const
-{
-  COStream ostream{filePath.empty() ? Path() : filePath};
-  for(const auto &row : _rowsList) {
-    for(size_t i = 0; i < row.size(); ++i) {
-      if(i)
-        ostream << ",";
-      ostream << row[i];
-    }
-    ostream << std::endl;
-  }
-}
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file fileParserCSV.cpp
+ *
+ * @brief Implements the condor2nav::CFileParserCSV class. 
+ */
+
+#include "fileParserCSV.h"
+#include "ostream.h"
+#include "tools.h"
+#include <string>
+#include <algorithm>
+
+
+/**
+ * @brief Hash index of one CSV column.
+ *
+ * condor2nav::CFileParserCSV::CColumnIndex maps column values to the ascending
+ * list of rows having that value in the column. Rows that could have been
+ * modified are marked as dirty and moved to the proper list before next lookup.
+ */
+template<typename Traits>
+class condor2nav::CFileParserCSV::CColumnIndex : CNonCopyable {
+  using CRowIndices = std::vector<size_t>;
+  using CTable = CHashTable<CRowIndices, Traits>;
+
+  const unsigned _column;                             ///< @brief Indexed column.
+  CTable _table;                                      ///< @brief Column value -> ascending list of rows.
+  std::vector<typename CTable::TEntry *> _rowEntries; ///< @brief Table entry each row is listed in (nullptr for too short rows).
+  std::vector<size_t> _dirtyRows;                     ///< @brief Rows to reindex before next lookup.
+
+  void Repair(const CRowsList &rows);
+
+public:
+  CColumnIndex(const CRowsList &rows, unsigned column);
+  void RowModified(size_t row) { _dirtyRows.push_back(row); }
+  size_t Find(const CRowsList &rows, boost::string_ref value);
+};
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CFileParserCSV::CColumnIndex class constructor.
+ *
+ * @param rows   Rows to index.
+ * @param column The column to index.
+ */
+template<typename Traits>
+condor2nav::CFileParserCSV::CColumnIndex<Traits>::CColumnIndex(const CRowsList &rows, unsigned column) :
+  _column{column}
+{
+  _rowEntries.reserve(rows.size());
+  for(size_t i=0; i<rows.size(); ++i) {
+    typename CTable::TEntry *entry = nullptr;
+    if(_column < rows[i].size()) {
+      entry = _table.Insert(rows[i][_column]).first;
+      entry->value.push_back(i);
+    }
+    _rowEntries.push_back(entry);
+  }
+}
+
+
+/**
+ * @brief Reindexes modified rows.
+ *
+ * Method moves all dirty rows to the lists matching their current values.
+ *
+ * @param rows Indexed rows.
+ */
+template<typename Traits>
+void condor2nav::CFileParserCSV::CColumnIndex<Traits>::Repair(const CRowsList &rows)
+{
+  for(auto row : _dirtyRows) {
+    auto &entry = _rowEntries[row];
+    const std::string *value = _column < rows[row].size() ? &rows[row][_column] : nullptr;
+    if(entry && value && Traits::Equal(entry->key, *value))
+      continue;
+
+    if(entry) {
+      auto &list = entry->value;
+      list.erase(std::lower_bound(list.begin(), list.end(), row));
+      entry = nullptr;
+    }
+    if(value) {
+      entry = _table.Insert(*value).first;
+      auto &list = entry->value;
+      list.insert(std::lower_bound(list.begin(), list.end(), row), row);
+    }
+  }
+  _dirtyRows.clear();
+}
+
+
+/**
+ * @brief Finds the row with specified value.
+ *
+ * @param rows  Indexed rows.
+ * @param value The value to find.
+ *
+ * @return The index of the first row with specified value or std::string::npos if not found.
+ */
+template<typename Traits>
+size_t condor2nav::CFileParserCSV::CColumnIndex<Traits>::Find(const CRowsList &rows, boost::string_ref value)
+{
+  Repair(rows);
+  auto list = _table.Find(value);
+  return list && !list->empty() ? list->front() : std::string::npos;
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CFileParserCSV::CCursor class constructor.
+ *
+ * @param filePath The path of the CSV file to read.
+ */
+condor2nav::CFileParserCSV::CCursor::CCursor(const bfs::path &filePath) :
+  _stream{filePath}
+{
+}
+
+
+/**
+ * @brief Moves to the next row.
+ *
+ * Method parses the next not empty line of the file. Fields of previous row
+ * are no longer valid after the call.
+ *
+ * @return false if there are no more rows in the file.
+ */
+bool condor2nav::CFileParserCSV::CCursor::Next()
+{
+  boost::string_ref line;
+  while(_stream.GetLine(line)) {
+    if(line.empty())
+      continue;
+    CSVTokenize(line, _fields);
+    return true;
+  }
+  _fields.clear();
+  return false;
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CFileParserCSV class constructor.
+ *
+ * @param filePath The path of the CSV file to parse.
+ */
+condor2nav::CFileParserCSV::CFileParserCSV(bfs::path filePath) :
+  _filePath{std::move(filePath)}
+{
+  // parse all rows
+  CCursor cursor{Path()};
+  while(cursor.Next())
+    _rowsList.emplace_back(CStringArray(cursor.Fields().begin(), cursor.Fields().end()));
+  if(_rowsList.front().size() <= 1)
+    throw EOperationFailed{"ERROR: File '" + Path().string() + "' does not look like a CSV File!!"};
+}
+
+
+/**
+ * @brief Returns requested row.
+ *
+ * Method reads the CSV file only up to the first row that has specified value
+ * in specified column. No other rows are stored in memory. The file is
+ * validated the same way as in the class constructor.
+ *
+ * @param filePath The path of the CSV file to read.
+ * @param value    The value to use for searching.
+ * @param column   The column index to be used for value comparison.
+ * @param nocase   Specifies if a search should be case sensitive.
+ *
+ * @exception std Thrown when requested row is not found.
+ *
+ * @return Requested row.
+ */
+auto condor2nav::CFileParserCSV::RowFind(const bfs::path &filePath, boost::string_ref value, unsigned column /* = 0 */, bool nocase /* = false */) -> CStringArray
+{
+  CCursor cursor{filePath};
+  for(bool first = true; cursor.Next(); first = false) {
+    const auto &fields = cursor.Fields();
+    if(first && fields.size() <= 1)
+      throw EOperationFailed{"ERROR: File '" + filePath.string() + "' does not look like a CSV File!!"};
+    if(column < fields.size() && (nocase ? CHashTraitsNoCase::Equal(fields[column], value) : fields[column] == value))
+      return CStringArray(fields.begin(), fields.end());
+  }
+  throw EOperationFailed{"ERROR: Couldn't find value '" + value.to_string() + "' in column '" + Convert(column) + "' of CSV file '" + filePath.string() + "'!!!"};
+}
+
+
+/**
+ * @brief Class destructor.
+ *
+ * condor2nav::CFileParserCSV class destructor.
+ */
+condor2nav::CFileParserCSV::~CFileParserCSV()
+{
+}
+
+
+/**
+ * @brief Returns the index of requested row.
+ *
+ * Method returns the index of the first row that has specified value in specified
+ * column. Column index is created on first use.
+ *
+ * @param value  The value to use for searching.
+ * @param column The column index to be used for value comparison.
+ * @param nocase Specifies if a search should be case sensitive.
+ *
+ * @exception std Thrown when requested row is not found.
+ *
+ * @return Requested row index.
+ */
+size_t condor2nav::CFileParserCSV::RowIndex(boost::string_ref value, unsigned column, bool nocase) const
+{
+  size_t row;
+  if(nocase) {
+    if(_indexesNoCase.size() <= column)
+      _indexesNoCase.resize(column + 1);
+    if(!_indexesNoCase[column])
+      _indexesNoCase[column] = std::make_unique<CIndexNoCase>(_rowsList, column);
+    row = _indexesNoCase[column]->Find(_rowsList, value);
+  }
+  else {
+    if(_indexes.size() <= column)
+      _indexes.resize(column + 1);
+    if(!_indexes[column])
+      _indexes[column] = std::make_unique<CIndex>(_rowsList, column);
+    row = _indexes[column]->Find(_rowsList, value);
+  }
+  if(row == std::string::npos)
+    throw EOperationFailed{"ERROR: Couldn't find value '" + value.to_string() + "' in column '" + Convert(column) + "' of CSV file '" + Path().string() + "'!!!"};
+  return row;
+}
+
+
+/**
+ * @brief Returns requested row.
+ *
+ * Method returns the values from one row specified by the value in specified column.
+ *
+ * @param value  The value to use for searching.
+ * @param column The column index to be used for value comparison.
+ * @param nocase Specifies if a search should be case sensitive.
+ *
+ * @exception std Thrown when requested row is not found.
+ *
+ * @return Requested row.
+ */
+auto condor2nav::CFileParserCSV::Row(boost::string_ref value, unsigned column /* = 0 */, bool nocase /* = false */) const -> const CStringArray &
+{
+  return _rowsList[RowIndex(value, column, nocase)];
+}
+
+
+/**
+ * @brief Returns requested row.
+ *
+ * Method returns the values from one row specified by the value in specified column.
+ *
+ * @param value  The value to use for searching.
+ * @param column The column index to be used for value comparison.
+ * @param nocase Specifies if a search should be case sensitive.
+ *
+ * @exception std Thrown when requested row is not found.
+ *
+ * @return Requested row.
+ */
+auto condor2nav::CFileParserCSV::Row(boost::string_ref value, unsigned column /* = 0 */, bool nocase /* = false */) -> CStringArray &
+{
+  auto row = RowIndex(value, column, nocase);
+
+  // returned row may be modified so it has to be reindexed
+  for(auto &index : _indexes)
+    if(index)
+      index->RowModified(row);
+  for(auto &index : _indexesNoCase)
+    if(index)
+      index->RowModified(row);
+  return _rowsList[row];
+}
+
+
+/**
+ * @brief Returns all rows.
+ *
+ * Method returns all rows parsed from a CSV file.
+ *
+ * @return Rows.
+ */
+auto condor2nav::CFileParserCSV::Rows() const -> const CRowsList &
+{
+  return _rowsList;
+}
+
+
+/**
+ * @brief Returns all rows.
+ *
+ * Method returns all rows parsed from a CSV file. As rows may be modified
+ * all column indexes are dropped.
+ *
+ * @return Rows.
+ */
+auto condor2nav::CFileParserCSV::Rows() -> CRowsList &
+{
+  _indexes.clear();
+  _indexesNoCase.clear();
+  return _rowsList;
+}
+
+
+/**
+* @brief Dumps class data to the file.
+*
+* Method dumps class data to the file in the same format as input file has.
+*
+* @param filePath Path of the file to create (empty means overwrite input file).
+*/
+void condor2nav::CFileParserCSV::Dump(const bfs::path &filePath /* = "" */) const
+{
+  COStream ostream{filePath.empty() ? Path() : filePath};
+  for(const auto &row : _rowsList) {
+    for(size_t i = 0; i < row.size(); ++i) {
+      if(i)
+        ostream << ",";
+      ostream << row[i];
+    }
+    ostream << std::endl;
+  }
+}
@@ -1,39 +1,39 @@
-//{{NO_DEPENDENCIES}}
-// Microsoft Visual C++ generated include file.
-// Used by condor2nav-gui.rc
-//
-#define IDC_MYICON                      2
-#define IDD_CONDOR2NAV_DIALOG           102
-#define IDD_ABOUTBOX                    103
-#define IDM_ABOUT                       104
-#define IDM_EXIT                        105
-#define IDI_CONDOR2NAV                  107
-#define IDC_CONDOR2NAV                  109
-#define IDR_MAINFRAME                   128
-#define IDD_MAIN_DIALOG                 129
-#define IDC_TRANSLATE_BUTTON            1000
-#define IDC_AAT_OFF_RADIO               1001
-#define IDC_AAT_ON_RADIO                1002
-#define IDC_FPL_DEFAULT_RADIO           1005
-#define IDC_FPL_LAST_RACE_RADIO         1006
-#define IDC_FPL_OTHER_RADIO             1007
-#define IDC_FPL_SELECT_BUTTON           1008
-#define IDC_FPL_PATH_EDIT               1009
-#define IDC_TRANSLATE_PROGRESS          1010
-#define IDC_AAT_TIME_COMBO              1012
-#define IDC_RICHEDIT22                  1014
-#define IDC_LOG_RICHEDIT2               1014
-#define IDC_AAT_STATIC                  1015
-#define IDC_STATIC                      -1
-
-// Next default values for new objects
-// 
-#ifdef APSTUDIO_INVOKED
-#ifndef APSTUDIO_READONLY_SYMBOLS
-#define _APS_NO_MFC                     1
-#define _APS_NEXT_RESOURCE_VALUE        131
-#define _APS_NEXT_COMMAND_VALUE         32773
-#define _APS_NEXT_CONTROL_VALUE         1016
-#define _APS_NEXT_SYMED_VALUE           110
-#endif
-#endif
+//{{NO_DEPENDENCIES}}
+// Microsoft Visual C++ generated include file.
+// Used by condor2nav-gui.rc
+//
+#define IDC_MYICON                      2
+#define IDD_CONDOR2NAV_DIALOG           102
+#define IDD_ABOUTBOX                    103
+#define IDM_ABOUT                       104
+#define IDM_EXIT                        105
+#define IDI_CONDOR2NAV                  107
+#define IDC_CONDOR2NAV                  109
+#define IDR_MAINFRAME                   128
+#define IDD_MAIN_DIALOG                 129
+#define IDC_TRANSLATE_BUTTON            1000
+#define IDC_AAT_OFF_RADIO               1001
+#define IDC_AAT_ON_RADIO                1002
+#define IDC_FPL_DEFAULT_RADIO           1005
+#define IDC_FPL_LAST_RACE_RADIO         1006
+#define IDC_FPL_OTHER_RADIO             1007
+#define IDC_FPL_SELECT_BUTTON           1008
+#define IDC_FPL_PATH_EDIT               1009
+#define IDC_TRANSLATE_PROGRESS          1010
+#define IDC_AAT_TIME_COMBO              1012
+#define IDC_RICHEDIT22                  1014
+#define IDC_LOG_RICHEDIT2               1014
+#define IDC_AAT_STATIC                  1015
+#define IDC_STATIC                      -1
+
+// Next default values for new objects
+// 
+#ifdef APSTUDIO_INVOKED
+#ifndef APSTUDIO_READONLY_SYMBOLS
+#define _APS_NO_MFC                     1
+#define _APS_NEXT_RESOURCE_VALUE        131
+#define _APS_NEXT_COMMAND_VALUE         32773
+#define _APS_NEXT_CONTROL_VALUE         1016
+#define _APS_NEXT_SYMED_VALUE           110
+#endif
+#endif
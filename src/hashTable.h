@@ -0,0 +1,325 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file hashTable.h
+ *
+ * @brief String keyed open-addressing hash table.
+ */
+
+#ifndef __HASHTABLE_H__
+#define __HASHTABLE_H__
+
+#include "nonCopyable.h"
+#include "traitsNoCase.h"
+#include <boost/utility/string_ref.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <deque>
+#include <vector>
+
+namespace condor2nav {
+
+  /**
+   * @brief FNV-1a hash of the key.
+   *
+   * @param key The key to hash. Every character is passed through Traits::Fold() first.
+   *
+   * @return Hash of the key.
+   */
+  template<typename Traits>
+  size_t HashFNV1a(boost::string_ref key)
+  {
+    size_t hash = sizeof(size_t) == 8 ? static_cast<size_t>(14695981039346656037ULL) : 2166136261U;
+    const size_t prime = sizeof(size_t) == 8 ? static_cast<size_t>(1099511628211ULL) : 16777619U;
+    for(auto c : key) {
+      hash ^= Traits::Fold(c);
+      hash *= prime;
+    }
+    return hash;
+  }
+
+
+  /**
+   * @brief Streaming XXH64 hash.
+   *
+   * condor2nav::CHashXXH64 calculates 64-bit xxHash of data provided in many
+   * parts. The result does not depend on the way the data is split.
+   */
+  class CHashXXH64 {
+    static const uint64_t PRIME1 = 11400714785074694791ULL;
+    static const uint64_t PRIME2 = 14029467366897019727ULL;
+    static const uint64_t PRIME3 = 1609587929392839161ULL;
+    static const uint64_t PRIME4 = 9650029242287828579ULL;
+    static const uint64_t PRIME5 = 2870177450012600261ULL;
+
+    uint64_t _acc[4];                                 ///< @brief Stripe accumulators.
+    uint64_t _total;                                  ///< @brief The number of bytes hashed so far.
+    unsigned char _tail[32];                          ///< @brief Bytes not forming a complete stripe yet.
+    unsigned _tailSize;                               ///< @brief The number of bytes in _tail.
+    const uint64_t _seed;                             ///< @brief Hash seed.
+
+    static uint64_t Rotl(uint64_t value, unsigned bits) { return (value << bits) | (value >> (64 - bits)); }
+    static uint64_t Read64(const unsigned char *data)   { uint64_t value; memcpy(&value, data, sizeof(value)); return value; }
+    static uint32_t Read32(const unsigned char *data)   { uint32_t value; memcpy(&value, data, sizeof(value)); return value; }
+    static uint64_t Round(uint64_t acc, uint64_t input) { return Rotl(acc + input * PRIME2, 31) * PRIME1; }
+    static uint64_t Merge(uint64_t acc, uint64_t value) { return (acc ^ Round(0, value)) * PRIME1 + PRIME4; }
+
+    void Stripe(const unsigned char *data)
+    {
+      for(unsigned i=0; i<4; i++)
+        _acc[i] = Round(_acc[i], Read64(data + i * 8));
+    }
+
+  public:
+    explicit CHashXXH64(uint64_t seed = 0) :
+      _total{0}, _tailSize{0}, _seed{seed}
+    {
+      _acc[0] = seed + PRIME1 + PRIME2;
+      _acc[1] = seed + PRIME2;
+      _acc[2] = seed;
+      _acc[3] = seed - PRIME1;
+    }
+
+    /**
+     * @brief Adds data to the hash.
+     *
+     * @param data Data to hash.
+     */
+    void Update(boost::string_ref data)
+    {
+      auto ptr = reinterpret_cast<const unsigned char *>(data.data());
+      auto end = ptr + data.size();
+      _total += data.size();
+      if(_tailSize) {
+        const size_t size = std::min<size_t>(sizeof(_tail) - _tailSize, end - ptr);
+        memcpy(_tail + _tailSize, ptr, size);
+        _tailSize += static_cast<unsigned>(size);
+        ptr += size;
+        if(_tailSize < sizeof(_tail))
+          return;
+        Stripe(_tail);
+        _tailSize = 0;
+      }
+      for(; end - ptr >= static_cast<ptrdiff_t>(sizeof(_tail)); ptr += sizeof(_tail))
+        Stripe(ptr);
+      memcpy(_tail, ptr, end - ptr);
+      _tailSize = static_cast<unsigned>(end - ptr);
+    }
+
+    /**
+     * @brief Returns the hash of all the data provided so far.
+     *
+     * @return XXH64 hash value.
+     */
+    uint64_t Digest() const
+    {
+      uint64_t hash;
+      if(_total >= sizeof(_tail)) {
+        hash = Rotl(_acc[0], 1) + Rotl(_acc[1], 7) + Rotl(_acc[2], 12) + Rotl(_acc[3], 18);
+        for(unsigned i=0; i<4; i++)
+          hash = Merge(hash, _acc[i]);
+      }
+      else {
+        hash = _seed + PRIME5;
+      }
+      hash += _total;
+
+      const unsigned char *ptr = _tail;
+      const unsigned char *end = _tail + _tailSize;
+      for(; end - ptr >= 8; ptr += 8)
+        hash = Rotl(hash ^ Round(0, Read64(ptr)), 27) * PRIME1 + PRIME4;
+      if(end - ptr >= 4) {
+        hash = Rotl(hash ^ (Read32(ptr) * PRIME1), 23) * PRIME2 + PRIME3;
+        ptr += 4;
+      }
+      for(; ptr < end; ptr++)
+        hash = Rotl(hash ^ (*ptr * PRIME5), 11) * PRIME1;
+
+      hash ^= hash >> 33;
+      hash *= PRIME2;
+      hash ^= hash >> 29;
+      hash *= PRIME3;
+      hash ^= hash >> 32;
+      return hash;
+    }
+  };
+
+
+  /**
+   * @brief Case sensitive key traits for condor2nav::CHashTable.
+   */
+  struct CHashTraits {
+    static unsigned char Fold(char c) { return static_cast<unsigned char>(c); }
+    static size_t Hash(boost::string_ref key) { return HashFNV1a<CHashTraits>(key); }
+    static bool Equal(boost::string_ref key1, boost::string_ref key2) { return key1 == key2; }
+  };
+
+
+  /**
+   * @brief Case-insensitive key traits for condor2nav::CHashTable.
+   */
+  struct CHashTraitsNoCase {
+    static unsigned char Fold(char c) { return static_cast<unsigned char>(ToUpper(c)); }
+    static size_t Hash(boost::string_ref key) { return HashFNV1a<CHashTraitsNoCase>(key); }
+    static bool Equal(boost::string_ref key1, boost::string_ref key2)
+    {
+      if(key1.size() != key2.size())
+        return false;
+      for(size_t i=0; i<key1.size(); ++i)
+        if(Fold(key1[i]) != Fold(key2[i]))
+          return false;
+      return true;
+    }
+  };
+
+
+  /**
+   * @brief String keyed open-addressing hash table.
+   *
+   * condor2nav::CHashTable is a hash table dedicated to string keys. Entries are
+   * stored in insertion order in a std::deque so references to them are never
+   * invalidated by an insertion. The lookup is done with linear probing over a
+   * power of 2 sized index that caches the hash of every key, so a string is
+   * compared only when hashes are equal. All lookups take boost::string_ref so
+   * callers do not need to construct std::string temporaries.
+   *
+   * @note T does not have to be copyable or movable.
+   */
+  template<typename T, typename Traits = CHashTraits>
+  class CHashTable : CNonCopyable {
+  public:
+    /**
+     * @brief Hash table entry.
+     */
+    struct TEntry {
+      const std::string key;                          ///< @brief Entry key.
+      T value;                                        ///< @brief Entry value.
+      explicit TEntry(std::string k) : key{std::move(k)}, value{} {}
+    };
+    using CEntries = std::deque<TEntry>;              ///< @brief Entries in insertion order.
+    using const_iterator = typename CEntries::const_iterator;
+
+  private:
+    /**
+     * @brief Hash index slot.
+     */
+    struct TSlot {
+      size_t hash;                                    ///< @brief Cached hash of the key.
+      size_t entry;                                   ///< @brief Index of the entry + 1 (0 means empty slot).
+    };
+    using CSlots = std::vector<TSlot>;
+
+    static const size_t MIN_CAPACITY = 16;           ///< @brief Initial size of the hash index.
+
+    CEntries _entries;                               ///< @brief Entries storage.
+    CSlots _slots;                                   ///< @brief Hash index.
+
+    size_t Probe(boost::string_ref key, size_t hash) const
+    {
+      const size_t mask = _slots.size() - 1;
+      for(size_t i = hash & mask;; i = (i + 1) & mask) {
+        const TSlot &slot = _slots[i];
+        if(!slot.entry || (slot.hash == hash && Traits::Equal(_entries[slot.entry - 1].key, key)))
+          return i;
+      }
+    }
+
+    void Rehash(size_t capacity)
+    {
+      CSlots slots(capacity, TSlot{0, 0});
+      const size_t mask = capacity - 1;
+      for(const auto &slot : _slots) {
+        if(slot.entry) {
+          size_t i = slot.hash & mask;
+          while(slots[i].entry)
+            i = (i + 1) & mask;
+          slots[i] = slot;
+        }
+      }
+      _slots.swap(slots);
+    }
+
+  public:
+    CHashTable() {}
+
+    size_t Size() const { return _entries.size(); }
+    bool Empty() const { return _entries.empty(); }
+    const_iterator begin() const { return _entries.begin(); }
+    const_iterator end() const { return _entries.end(); }
+
+    /**
+     * @brief Finds the value for the key.
+     *
+     * @param key The key to find.
+     *
+     * @return Pointer to the value or nullptr if the key is not found.
+     */
+    const T *Find(boost::string_ref key) const
+    {
+      if(_entries.empty())
+        return nullptr;
+      const TSlot &slot = _slots[Probe(key, Traits::Hash(key))];
+      return slot.entry ? &_entries[slot.entry - 1].value : nullptr;
+    }
+
+    /**
+     * @brief Finds the value for the key.
+     *
+     * @param key The key to find.
+     *
+     * @return Pointer to the value or nullptr if the key is not found.
+     */
+    T *Find(boost::string_ref key)
+    {
+      return const_cast<T *>(static_cast<const CHashTable *>(this)->Find(key));
+    }
+
+    /**
+     * @brief Inserts a default constructed value for the key if not present.
+     *
+     * @param key The key to insert.
+     *
+     * @return The pair of pointer to the entry and the flag set to true if
+     *         a new entry was created.
+     */
+    std::pair<TEntry *, bool> Insert(boost::string_ref key)
+    {
+      if((_entries.size() + 1) * 2 > _slots.size())
+        Rehash(_slots.empty() ? MIN_CAPACITY : _slots.size() * 2);
+      const size_t hash = Traits::Hash(key);
+      TSlot &slot = _slots[Probe(key, hash)];
+      if(slot.entry)
+        return std::make_pair(&_entries[slot.entry - 1], false);
+      _entries.emplace_back(key.to_string());
+      slot.hash = hash;
+      slot.entry = _entries.size();
+      return std::make_pair(&_entries.back(), true);
+    }
+
+    T &operator[](boost::string_ref key) { return Insert(key).first->value; }
+  };
+
+}
+
+#endif /* __HASHTABLE_H__ */
@@ -0,0 +1,224 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file httpCache.cpp
+ *
+ * @brief Implements the condor2nav::CHttpCache class.
+ *
+ * Index file contains one line per resource with tab separated fields:
+ * <key> <ETag> <Last-Modified> <body file path>
+ *
+ * Bodies stored in the cache directory are named after XXH64 hash of the key
+ * and start with the key line, so a hash collision is detected on read.
+ */
+
+#include "httpCache.h"
+#include "hashTable.h"
+#include "istream.h"
+#include "vfs.h"
+#include <boost/filesystem.hpp>
+#include <sstream>
+
+const char *condor2nav::CHttpCache::INDEX_FILE_NAME = "index.txt";
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CHttpCache class constructor. Reads the index file if it
+ * exists. Malformed lines are ignored.
+ *
+ * @param dir Cache directory.
+ */
+condor2nav::CHttpCache::CHttpCache(const bfs::path &dir) :
+  _dir{dir}, _modified{false}
+{
+  const auto indexPath = _dir / INDEX_FILE_NAME;
+  if(!bfs::exists(indexPath))
+    return;
+
+  CIStream index{indexPath};
+  std::string line;
+  while(index.GetLine(line)) {
+    std::istringstream stream{line};
+    std::string key;
+    TEntry entry;
+    if(std::getline(stream, key, '\t') && std::getline(stream, entry.etag, '\t') &&
+       std::getline(stream, entry.lastModified, '\t') && std::getline(stream, entry.body) && !entry.body.empty())
+      _entries[key] = entry;
+  }
+}
+
+
+/**
+ * @brief Finds cached resource.
+ *
+ * @param key The server and the path of the resource.
+ *
+ * @return Cached resource or nullptr if not cached or its body does not exist anymore.
+ */
+auto condor2nav::CHttpCache::Find(const std::string &key) const -> const TEntry *
+{
+  auto it = _entries.find(key);
+  if(it == _entries.end() || !FileExists(it->second.body))
+    return nullptr;
+  return &it->second;
+}
+
+
+/**
+ * @brief Reads the body of the resource stored in the cache directory.
+ *
+ * @param key  The server and the path of the resource.
+ * @param body The buffer to read the body to.
+ *
+ * @return true if the body was read, false if it is not cached, is not readable or belongs to another resource.
+ */
+bool condor2nav::CHttpCache::BodyRead(const std::string &key, std::string &body) const
+{
+  const TEntry *entry = Find(key);
+  if(!entry)
+    return false;
+  std::string data;
+  try {
+    data = CVfs::Instance(entry->body).Read(entry->body);
+  }
+  catch(const EOperationFailed &) {
+    return false;
+  }
+  if(data.compare(0, key.size(), key) != 0 || data.size() <= key.size() || data[key.size()] != '\n')
+    return false;
+  body = data.substr(key.size() + 1);
+  return true;
+}
+
+
+/**
+ * @brief Stores validators of the resource downloaded to the file.
+ *
+ * @param key          The server and the path of the resource.
+ * @param etag         ETag header value.
+ * @param lastModified Last-Modified header value.
+ * @param fileName     The file with the resource body.
+ */
+void condor2nav::CHttpCache::FileStore(const std::string &key, const std::string &etag, const std::string &lastModified, const bfs::path &fileName)
+{
+  if(etag.empty() && lastModified.empty())
+    return Remove(key);
+  const TEntry entry = { etag, lastModified, fileName.string() };
+  _entries[key] = entry;
+  _modified = true;
+}
+
+
+/**
+ * @brief Stores validators and the body of the resource downloaded to memory.
+ *
+ * @param key          The server and the path of the resource.
+ * @param etag         ETag header value.
+ * @param lastModified Last-Modified header value.
+ * @param body         The resource body.
+ */
+void condor2nav::CHttpCache::BodyStore(const std::string &key, const std::string &etag, const std::string &lastModified, const std::string &body)
+{
+  if(etag.empty() && lastModified.empty())
+    return Remove(key);
+
+  CHashXXH64 hash;
+  hash.Update(key);
+  std::ostringstream name;
+  name << std::hex << hash.Digest() << ".body";
+  const auto path = _dir / name.str();
+
+  // the body of the resource with the same hash is overwritten
+  for(auto it = _entries.begin(); it != _entries.end();) {
+    if(it->first != key && it->second.body == path.string())
+      it = _entries.erase(it);
+    else
+      ++it;
+  }
+
+  DirectoryCreate(_dir);
+  CVfs::Instance(path).Write(path, { key, "\n", body });
+  FileStore(key, etag, lastModified, path);
+}
+
+
+/**
+ * @brief Removes the resource from the cache.
+ *
+ * Bodies of resources downloaded to files are not removed.
+ *
+ * @param key The server and the path of the resource.
+ */
+void condor2nav::CHttpCache::Remove(const std::string &key)
+{
+  auto it = _entries.find(key);
+  if(it == _entries.end())
+    return;
+  if(bfs::path{it->second.body}.parent_path() == _dir) {
+    boost::system::error_code ignored;
+    bfs::remove(it->second.body, ignored);
+  }
+  _entries.erase(it);
+  _modified = true;
+}
+
+
+/**
+ * @brief Writes the index file if it was modified.
+ *
+ * The index is written to a temporary file that replaces the old one, so
+ * an interrupted write never leaves a truncated index behind.
+ */
+void condor2nav::CHttpCache::Dump()
+{
+  if(!_modified)
+    return;
+  std::ostringstream stream;
+  for(auto &entry : _entries)
+    stream << entry.first << "\t" << entry.second.etag << "\t" << entry.second.lastModified << "\t" << entry.second.body << "\n";
+  const std::string data = stream.str();
+  const auto indexPath = _dir / INDEX_FILE_NAME;
+  DirectoryCreate(_dir);
+  auto &vfs = CVfs::Instance(indexPath);
+  if(vfs.ReplaceSupported()) {
+    const bfs::path tmp{indexPath.string() + ".tmp"};
+    try {
+      vfs.Write(tmp, { data });
+      vfs.Replace(tmp, indexPath);
+    }
+    catch(...) {
+      try {
+        vfs.Remove(tmp);
+      }
+      catch(...) {
+        // keep the original error
+      }
+      throw;
+    }
+  }
+  else {
+    vfs.Write(indexPath, { data });
+  }
+  _modified = false;
+}
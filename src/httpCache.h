@@ -0,0 +1,79 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file httpCache.h
+ *
+ * @brief Declares the condor2nav::CHttpCache class.
+ */
+
+#ifndef __HTTPCACHE_H__
+#define __HTTPCACHE_H__
+
+#include "nonCopyable.h"
+#include "boostfwd.h"
+#include <map>
+#include <string>
+#include <boost/filesystem/path.hpp>
+
+namespace condor2nav {
+
+  /**
+   * @brief HTTP validators cache.
+   *
+   * condor2nav::CHttpCache remembers ETag and Last-Modified validators of
+   * downloaded resources so they may be requested conditionally next time.
+   * Validators are stored in a small index file in the cache directory.
+   * Resources downloaded to memory have their bodies stored in the cache
+   * directory too, tagged with their keys. Bodies of resources downloaded to files are the files
+   * themselves, so they are valid only as long as the files exist.
+   */
+  class CHttpCache : CNonCopyable {
+  public:
+    /**
+     * @brief Cached resource.
+     */
+    struct TEntry {
+      std::string etag;                               ///< @brief ETag header value.
+      std::string lastModified;                       ///< @brief Last-Modified header value.
+      std::string body;                               ///< @brief The path of the file with the resource body.
+    };
+
+    static const char *INDEX_FILE_NAME;               ///< @brief The name of the index file in the cache directory.
+
+  private:
+    const bfs::path _dir;                             ///< @brief Cache directory.
+    std::map<std::string, TEntry> _entries;           ///< @brief Cached resources (the key is the server and the path).
+    bool _modified;                                   ///< @brief Set when the index has to be written.
+
+  public:
+    explicit CHttpCache(const bfs::path &dir);
+    const TEntry *Find(const std::string &key) const;
+    bool BodyRead(const std::string &key, std::string &body) const;
+    void FileStore(const std::string &key, const std::string &etag, const std::string &lastModified, const bfs::path &fileName);
+    void BodyStore(const std::string &key, const std::string &etag, const std::string &lastModified, const std::string &body);
+    void Remove(const std::string &key);
+    void Dump();
+  };
+
+}
+
+#endif /* __HTTPCACHE_H__ */
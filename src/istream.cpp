@@ -1,101 +1,224 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
- * @file istream.cpp
- *
- * @brief Implements the IStream wrapper class. 
- */
-
-#include "istream.h"
-#include <algorithm>
-#include <boost/asio/ip/tcp.hpp>
-#include "activeSync.h"   // has to be included after boost/asio
-#include <boost/filesystem/fstream.hpp>
-
-
-/**
- * @brief Class constructor.
- *
- * condor2nav::CIStream class constructor.
- *
- * @param fileName The name of the file to read.
- */
-condor2nav::CIStream::CIStream(const bfs::path &fileName)
-{
-  switch(PathType(fileName)) {
-  case TPathType::LOCAL:
-    {
-      bfs::fstream stream{fileName, std::ios_base::in};
-      if(!stream)
-        throw EOperationFailed{"ERROR: Couldn't open file '" + fileName.string() + "' for reading!!!"};
-      _buffer << stream.rdbuf();
-    }
-    break;
-
-  case TPathType::ACTIVE_SYNC:
-    _buffer.str(CActiveSync::Instance().Read(fileName));
-    break;
-  }
-}
-
-
-condor2nav::CIStream::CIStream(const std::string &server, const bfs::path &url, unsigned timeout /* = 30 */)
-{
-  boost::asio::ip::tcp::iostream http;
-  http.expires_from_now(boost::posix_time::seconds(timeout));
-
-  // establish a connection to the server.
-  http.connect(server, "http");
-  if(!http)
-    throw EOperationFailed{"ERROR: Unable to connect to: '" + server + url.generic_string() + "', error: " + http.error().message()};
-
-  // Send the request. We specify the "Connection: close" header so that the
-  // server will close the socket after transmitting the response. This will
-  // allow us to treat all data up until the EOF as the content.
-  http << "GET " << url.generic_string() << " HTTP/1.0\r\n";
-  http << "Host: " << server << "\r\n";
-  http << "Accept: */*\r\n";
-  http << "Connection: close\r\n\r\n";
-
-  // Check that response is OK.
-  std::string http_version;
-  http >> http_version;
-  unsigned int status_code;
-  http >> status_code;
-  std::string status_message;
-  std::getline(http, status_message);
-  if(!http || http_version.substr(0, 5) != "HTTP/")
-    throw EOperationFailed{"ERROR: Invalid response from: '" + server + url.generic_string() + "'"};
-  if(status_code != 200)
-    throw EOperationFailed{"ERROR: '" + server + url.generic_string() + "' returned a response with status code: " + Convert(status_code)};
-
-  // Process the response headers, which are terminated by a blank line.
-  std::string header;
-  while(std::getline(http, header) && header != "\r")
-    ;
-
-  // Write the remaining data to internal buffer
-  _buffer << http.rdbuf();
-
-  if(http.error() == boost::asio::error::operation_aborted)
-    throw EOperationFailed{"ERROR: Download timeout (" + Convert(timeout) + " seconds) exceeded!"};
-}
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file istream.cpp
+ *
+ * @brief Implements the IStream wrapper class. 
+ */
+
+#include "istream.h"
+#include "downloader.h"
+#include "tools.h"
+#include "vfs.h"
+#include <algorithm>
+#include <iterator>
+#include <boost/filesystem.hpp>
+
+
+/**
+ * @brief Read-only memory mapped file.
+ */
+class condor2nav::CIStream::CMappedFile : CNonCopyable {
+  struct CViewDeleter {
+    void operator()(const char *view) const { ::UnmapViewOfFile(view); }
+  };
+
+  CHandleRes _file;                                   ///< @brief File handle.
+  CHandleRes _mapping;                                ///< @brief File mapping handle.
+  std::unique_ptr<const char, CViewDeleter> _view;    ///< @brief Mapped view of the file.
+  size_t _size;                                       ///< @brief File size.
+
+public:
+  explicit CMappedFile(const bfs::path &fileName);
+  boost::string_ref Data() const { return boost::string_ref{_view.get(), _size}; }
+};
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CIStream::CMappedFile class constructor. Maps the whole file
+ * into the process address space.
+ *
+ * @param fileName The name of the file to map.
+ */
+condor2nav::CIStream::CMappedFile::CMappedFile(const bfs::path &fileName) :
+  _size{0}
+{
+  HANDLE file = ::CreateFile(fileName.string().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+    throw EOperationFailed{"ERROR: Couldn't open file '" + fileName.string() + "' for reading!!!"};
+  _file.reset(file);
+
+  LARGE_INTEGER size;
+  if(!::GetFileSizeEx(file, &size))
+    throw EOperationFailed{"ERROR: Couldn't obtain the size of '" + fileName.string() + "' file!!!"};
+  _size = static_cast<size_t>(size.QuadPart);
+
+  // empty files cannot be mapped
+  if(_size) {
+    _mapping.reset(::CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr));
+    if(!_mapping)
+      throw EOperationFailed{"ERROR: Couldn't map file '" + fileName.string() + "' for reading!!!"};
+    _view.reset(static_cast<const char *>(::MapViewOfFile(_mapping.get(), FILE_MAP_READ, 0, 0, 0)));
+    if(!_view)
+      throw EOperationFailed{"ERROR: Couldn't map file '" + fileName.string() + "' for reading!!!"};
+  }
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CIStream class constructor.
+ *
+ * @param fileName The name of the file to read.
+ */
+condor2nav::CIStream::CIStream(const bfs::path &fileName) :
+  _pos{0}, _good{true}
+{
+  auto &vfs = CVfs::Instance(fileName);
+  if(vfs.Type() == TPathType::LOCAL) {
+    _file = std::make_unique<CMappedFile>(fileName);
+    _data = _file->Data();
+  }
+  else {
+    _buffer = vfs.Read(fileName);
+    _data = _buffer;
+  }
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CIStream class constructor.
+ *
+ * @param server  The server from which to download the data.
+ * @param url     The path on the server to the data.
+ * @param timeout Download timeout in seconds.
+ * @param cache   HTTP cache used to avoid downloading not modified data again (nullptr if not used).
+ */
+condor2nav::CIStream::CIStream(const std::string &server, const bfs::path &url, unsigned timeout /* = 30 */, CHttpCache *cache /* = nullptr */) :
+  _pos{0}, _good{true}
+{
+  // fail fast - the data is small and the caller reports the error
+  const CDownloader::TConfig config = { 1, 1, 0, 0 };
+  CDownloader downloader{config, cache};
+  downloader.Add(server, url, _buffer, timeout);
+  const auto errors = downloader.Run(std::function<bool()>());
+  if(errors.front())
+    std::rethrow_exception(errors.front());
+  _data = _buffer;
+}
+
+
+/**
+ * @brief Class destructor.
+ *
+ * condor2nav::CIStream class destructor.
+ */
+condor2nav::CIStream::~CIStream()
+{
+}
+
+
+/**
+ * @brief Reads next line.
+ *
+ * Method provides the view of the next line of the data. Line endings (both
+ * LF and CRLF) are not part of the line. The view is valid as long as the
+ * stream exists.
+ *
+ * @param [out] line The view of the line (empty if there is no more data).
+ *
+ * @return The stream that evaluates to false if there was no more data to read.
+ */
+condor2nav::CIStream &condor2nav::CIStream::GetLine(boost::string_ref &line)
+{
+  if(_pos >= _data.size()) {
+    _good = false;
+    line.clear();
+    return *this;
+  }
+
+  const char *begin = _data.data() + _pos;
+  const char *end = _data.data() + _data.size();
+  const char *eol = std::find(begin, end, '\n');
+  _pos += (eol - begin) + (eol != end ? 1 : 0);
+  if(eol != begin && *(eol - 1) == '\r')
+    --eol;
+  line = boost::string_ref{begin, static_cast<size_t>(eol - begin)};
+  return *this;
+}
+
+
+/**
+ * @brief Reads next line.
+ *
+ * Method copies the next line of the data to the provided string. Line endings
+ * (both LF and CRLF) are not part of the line.
+ *
+ * @param [out] line The line read (empty if there is no more data).
+ *
+ * @return The stream that evaluates to false if there was no more data to read.
+ */
+condor2nav::CIStream &condor2nav::CIStream::GetLine(std::string &line)
+{
+  boost::string_ref view;
+  GetLine(view);
+  line.assign(view.begin(), view.end());
+  return *this;
+}
+
+
+/**
+ * @brief Writes not yet read data to the output stream.
+ *
+ * Function writes all not yet read data to the output stream. Local text files
+ * have their CRLF line endings replaced with LF ones the same way as it is done
+ * for files read with text mode streams. Downloaded data is written untouched.
+ *
+ * @param out The stream to write to.
+ * @param in  The stream to read from.
+ *
+ * @return The output stream.
+ */
+std::ostream &condor2nav::operator<<(std::ostream &out, CIStream &in)
+{
+  boost::string_ref data = in._data.substr(std::min(in._pos, in._data.size()));
+  if(in._file) {
+    const char *begin = data.data(), *end = data.data() + data.size();
+    for(const char *it = begin; it != end; ++it) {
+      if(*it == '\r' && it + 1 != end && *(it + 1) == '\n') {
+        out.write(begin, it - begin);
+        begin = it + 1;
+      }
+    }
+    out.write(begin, end - begin);
+  }
+  else {
+    out.write(data.data(), data.size());
+  }
+  in._pos = in._data.size();
+  return out;
+}
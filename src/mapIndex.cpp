@@ -0,0 +1,136 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file mapIndex.cpp
+ *
+ * @brief Implements the condor2nav::CMapIndex class.
+ */
+
+#include "mapIndex.h"
+#include <algorithm>
+#include <cmath>
+
+
+/**
+ * @brief Groups items into parent nodes.
+ *
+ * Items are sorted by the longitude of their centers and split into vertical
+ * slices. Items of every slice are sorted by the latitude of their centers
+ * and grouped by condor2nav::CMapIndex::NODE_SIZE into parent nodes.
+ *
+ * @param items   Entries or nodes to group (reordered in place).
+ * @param base    The position of the first item in its container after packing.
+ * @param parents Created parent nodes.
+ */
+template<typename T>
+void condor2nav::CMapIndex::Pack(std::vector<T> &items, unsigned base, std::vector<TNode> &parents)
+{
+  const size_t count = items.size();
+  const size_t nodes = (count + NODE_SIZE - 1) / NODE_SIZE;
+  const size_t sliceSize = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(nodes)))) * NODE_SIZE;
+
+  std::sort(items.begin(), items.end(), [](const T &l, const T &r) { return l.box.lonMin + l.box.lonMax < r.box.lonMin + r.box.lonMax; });
+  for(size_t i=0; i<count; i+=sliceSize)
+    std::sort(items.begin() + i, items.begin() + std::min(count, i + sliceSize),
+              [](const T &l, const T &r) { return l.box.latMin + l.box.latMax < r.box.latMin + r.box.latMax; });
+
+  for(size_t i=0; i<count; i+=NODE_SIZE) {
+    const size_t end = std::min(count, i + NODE_SIZE);
+    TNode node = { items[i].box, items[i].index, base + static_cast<unsigned>(i), base + static_cast<unsigned>(end) };
+    for(size_t j=i+1; j<end; j++) {
+      node.box.lonMin = std::min(node.box.lonMin, items[j].box.lonMin);
+      node.box.lonMax = std::max(node.box.lonMax, items[j].box.lonMax);
+      node.box.latMin = std::min(node.box.latMin, items[j].box.latMin);
+      node.box.latMax = std::max(node.box.latMax, items[j].box.latMax);
+      node.index = std::min(node.index, items[j].index);
+    }
+    parents.push_back(node);
+  }
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CMapIndex class constructor. Builds the tree bottom-up.
+ *
+ * @param boxes Bounding boxes of maps in the order of priority.
+ */
+condor2nav::CMapIndex::CMapIndex(const std::vector<TBox> &boxes) :
+  _leaves{0}
+{
+  _entries.reserve(boxes.size());
+  for(unsigned i=0; i<boxes.size(); i++) {
+    const TEntry entry = { boxes[i], i };
+    _entries.push_back(entry);
+  }
+  if(_entries.empty())
+    return;
+
+  std::vector<TNode> level;
+  Pack(_entries, 0, level);
+  _leaves = static_cast<unsigned>(level.size());
+  while(level.size() > 1) {
+    std::vector<TNode> parents;
+    Pack(level, static_cast<unsigned>(_nodes.size()), parents);
+    _nodes.insert(_nodes.end(), level.begin(), level.end());
+    level.swap(parents);
+  }
+  _nodes.push_back(level.front());
+}
+
+
+/**
+ * @brief Finds the map containing the area.
+ *
+ * @param area The area that has to be inside of the map.
+ *
+ * @return The lowest index of the map fully containing the area or
+ *         condor2nav::CMapIndex::NOT_FOUND.
+ */
+size_t condor2nav::CMapIndex::Find(const TBox &area) const
+{
+  size_t best = NOT_FOUND;
+  if(_nodes.empty())
+    return best;
+
+  // the tree of 2^32 entries has 8 levels, so at most 8 * (NODE_SIZE - 1) + 1 nodes wait on the stack
+  unsigned stack[8 * NODE_SIZE];
+  size_t size = 0;
+  stack[size++] = static_cast<unsigned>(_nodes.size() - 1);
+  while(size) {
+    const unsigned id = stack[--size];
+    const TNode &node = _nodes[id];
+    if(node.index >= best || !node.box.Contains(area))
+      continue;
+    if(id < _leaves) {
+      for(unsigned i=node.begin; i<node.end; i++)
+        if(_entries[i].index < best && _entries[i].box.Contains(area))
+          best = _entries[i].index;
+    }
+    else {
+      for(unsigned i=node.begin; i<node.end; i++)
+        stack[size++] = i;
+    }
+  }
+  return best;
+}
@@ -0,0 +1,103 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file mapIndex.h
+ *
+ * @brief Declares the condor2nav::CMapIndex class.
+ */
+
+#ifndef __MAPINDEX_H__
+#define __MAPINDEX_H__
+
+#include "nonCopyable.h"
+#include <vector>
+
+namespace condor2nav {
+
+  /**
+   * @brief Spatial index of maps areas.
+   *
+   * condor2nav::CMapIndex is a static R-tree of maps bounding boxes packed
+   * with Sort-Tile-Recursive algorithm. Maps are identified by their index
+   * in the array provided to the constructor, which is also their priority
+   * (i.e. maps sorted by scale). The index answers which map of the lowest
+   * index fully contains given area. Subtrees whose bounding box does not
+   * contain the area or whose maps all have worse priority than the best map
+   * found so far are not visited.
+   */
+  class CMapIndex : CNonCopyable {
+  public:
+    /**
+     * @brief Geographic bounding box.
+     */
+    struct TBox {
+      double lonMin;                                  ///< @brief Western border.
+      double lonMax;                                  ///< @brief Eastern border.
+      double latMin;                                  ///< @brief Southern border.
+      double latMax;                                  ///< @brief Northern border.
+
+      bool Contains(const TBox &other) const
+      {
+        return other.lonMin >= lonMin && other.lonMax <= lonMax && other.latMin >= latMin && other.latMax <= latMax;
+      }
+    };
+
+    static const unsigned NODE_SIZE = 16;             ///< @brief The maximum number of children of a tree node.
+    static const size_t NOT_FOUND = static_cast<size_t>(-1);  ///< @brief Returned when no map contains the area.
+
+  private:
+    /**
+     * @brief Tree node.
+     *
+     * Children of a leaf are entries, children of other nodes are nodes.
+     */
+    struct TNode {
+      TBox box;                                       ///< @brief Bounding box of all children.
+      unsigned index;                                 ///< @brief The lowest map index in the subtree.
+      unsigned begin;                                 ///< @brief The first child.
+      unsigned end;                                   ///< @brief One past the last child.
+    };
+
+    /**
+     * @brief Map entry.
+     */
+    struct TEntry {
+      TBox box;                                       ///< @brief Map bounding box.
+      unsigned index;                                 ///< @brief Map index.
+    };
+
+    std::vector<TEntry> _entries;                     ///< @brief Maps in the order of leaves.
+    std::vector<TNode> _nodes;                        ///< @brief Tree nodes (leaves first, root last).
+    unsigned _leaves;                                 ///< @brief The number of leaves.
+
+    template<typename T>
+    static void Pack(std::vector<T> &items, unsigned base, std::vector<TNode> &parents);
+
+  public:
+    explicit CMapIndex(const std::vector<TBox> &boxes);
+    size_t Size() const { return _entries.size(); }
+    size_t Find(const TBox &area) const;
+  };
+
+}
+
+#endif /* __MAPINDEX_H__ */
@@ -0,0 +1,506 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file naviConWorkers.cpp
+ *
+ * @brief Implements the condor2nav::CNaviConWorkers class.
+ *
+ * Every message (both request and reply) is a TMessage header followed by
+ * 'size' bytes of payload:
+ * - INIT request: NaviCon.dll path and terrain file path (both '\0' terminated)
+ * - CONVERT request: num x coordinates followed by num y coordinates (floats)
+ * - CONVERT reply: num latitudes followed by num longitudes (doubles)
+ * - failed request reply: error message
+ */
+
+#include "naviConWorkers.h"
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace {
+
+  // NaviCon.dll interface
+  using FNaviConInit = int(WINAPI*)(const char *trnFile);
+  using FXYToLon = float(WINAPI*)(float X, float Y);
+  using FXYToLat = float(WINAPI*)(float X, float Y);
+
+  /**
+   * @brief Message types.
+   */
+  enum TMessageType : uint32_t {
+    MESSAGE_INIT,                                    ///< @brief Initialize NaviCon.dll with terrain file.
+    MESSAGE_CONVERT,                                 ///< @brief Convert a batch of points.
+    MESSAGE_OK,                                      ///< @brief Request processed.
+    MESSAGE_ERROR                                    ///< @brief Request failed.
+  };
+
+  /**
+   * @brief Message header.
+   */
+  struct TMessage {
+    uint32_t type;                                   ///< @brief Message type (TMessageType).
+    uint32_t size;                                   ///< @brief Payload size.
+  };
+
+
+  /**
+   * @brief Reads the data from the pipe.
+   *
+   * @param pipe The pipe to read from.
+   * @param data The buffer to fill.
+   * @param size The number of bytes to read.
+   *
+   * @return false if the pipe was closed.
+   */
+  bool PipeRead(HANDLE pipe, void *data, size_t size)
+  {
+    auto buffer = static_cast<char *>(data);
+    while(size) {
+      DWORD read = 0;
+      if(!::ReadFile(pipe, buffer, static_cast<DWORD>(size), &read, nullptr) || !read)
+        return false;
+      buffer += read;
+      size -= read;
+    }
+    return true;
+  }
+
+
+  /**
+   * @brief Writes the data to the pipe.
+   *
+   * @param pipe The pipe to write to.
+   * @param data The data to write.
+   * @param size The number of bytes to write.
+   *
+   * @return false if the pipe was closed.
+   */
+  bool PipeWrite(HANDLE pipe, const void *data, size_t size)
+  {
+    auto buffer = static_cast<const char *>(data);
+    while(size) {
+      DWORD written = 0;
+      if(!::WriteFile(pipe, buffer, static_cast<DWORD>(size), &written, nullptr) || !written)
+        return false;
+      buffer += written;
+      size -= written;
+    }
+    return true;
+  }
+
+
+  /**
+   * @brief Reads the message from the pipe.
+   *
+   * @param pipe          The pipe to read from.
+   * @param [out] type    Message type.
+   * @param [out] payload Message payload.
+   *
+   * @return false if the pipe was closed.
+   */
+  bool MessageRead(HANDLE pipe, uint32_t &type, std::vector<char> &payload)
+  {
+    TMessage header;
+    if(!PipeRead(pipe, &header, sizeof(header)))
+      return false;
+    type = header.type;
+    payload.resize(header.size);
+    return PipeRead(pipe, payload.data(), payload.size());
+  }
+
+
+  /**
+   * @brief Writes the message to the pipe.
+   *
+   * @param pipe    The pipe to write to.
+   * @param type    Message type.
+   * @param payload Message payload.
+   * @param size    Payload size.
+   *
+   * @return false if the pipe was closed.
+   */
+  bool MessageWrite(HANDLE pipe, uint32_t type, const void *payload, size_t size)
+  {
+    const TMessage header = { type, static_cast<uint32_t>(size) };
+    return PipeWrite(pipe, &header, sizeof(header)) && PipeWrite(pipe, payload, size);
+  }
+
+
+  /**
+   * @brief NaviCon.dll loaded by the worker process.
+   */
+  class CNaviCon : condor2nav::CNonCopyable {
+    condor2nav::CLibraryRes _lib;                    ///< @brief DLL instance.
+    std::string _dllPath;                            ///< @brief DLL path.
+    FNaviConInit _naviConInit;
+    FXYToLon _xyToLon;
+    FXYToLat _xyToLat;
+
+    template<typename SYMBOL_TYPE>
+    void Symbol(const char *name, SYMBOL_TYPE &out)
+    {
+      out = reinterpret_cast<SYMBOL_TYPE>(::GetProcAddress(_lib.get(), name));
+      if(!out)
+        throw condor2nav::EOperationFailed{"ERROR: Couldn't map " + std::string{name} + "() from '" + _dllPath + "'!!!"};
+    }
+
+  public:
+    CNaviCon() : _naviConInit{nullptr}, _xyToLon{nullptr}, _xyToLat{nullptr} {}
+
+    void Init(const std::string &dllPath, const std::string &trnPath)
+    {
+      if(dllPath != _dllPath) {
+        _dllPath.clear();
+        _lib.reset(::LoadLibrary(dllPath.c_str()));
+        if(!_lib)
+          throw condor2nav::EOperationFailed{"ERROR: Couldn't open '" + dllPath + "'!!!"};
+        _dllPath = dllPath;
+        Symbol("NaviConInit", _naviConInit);
+        Symbol("XYToLon", _xyToLon);
+        Symbol("XYToLat", _xyToLat);
+      }
+      _naviConInit(trnPath.c_str());
+    }
+
+    void LatLon(const float x[], const float y[], size_t num, double latitude[], double longitude[]) const
+    {
+      if(!_lib)
+        throw condor2nav::EOperationFailed{"ERROR: NaviCon.dll worker not initialized!!!"};
+      for(size_t i=0; i<num; i++) {
+        latitude[i] = _xyToLat(x[i], y[i]);
+        longitude[i] = _xyToLon(x[i], y[i]);
+      }
+    }
+  };
+
+}
+
+
+const char *condor2nav::CNaviConWorkers::WORKER_OPTION = "--navicon-worker";
+
+
+/**
+ * @brief Runs the worker.
+ *
+ * Function is the main loop of the worker process. It processes requests
+ * until the requests pipe is closed by the client.
+ *
+ * @param request The pipe to read requests from.
+ * @param reply   The pipe to write replies to.
+ *
+ * @return Worker process exit code.
+ */
+int condor2nav::CNaviConWorkers::Serve(HANDLE request, HANDLE reply)
+{
+  CNaviCon naviCon;
+  uint32_t type;
+  std::vector<char> payload;
+  std::vector<double> result;
+  while(MessageRead(request, type, payload)) {
+    bool written;
+    try {
+      switch(type) {
+      case MESSAGE_INIT:
+        {
+          const auto dllEnd = std::find(payload.begin(), payload.end(), '\0');
+          const auto trnEnd = std::find(dllEnd + (dllEnd != payload.end() ? 1 : 0), payload.end(), '\0');
+          if(trnEnd == payload.end())
+            throw EOperationFailed{"ERROR: Invalid NaviCon.dll worker request!!!"};
+          naviCon.Init(std::string(payload.begin(), dllEnd), std::string(dllEnd + 1, trnEnd));
+          written = MessageWrite(reply, MESSAGE_OK, nullptr, 0);
+        }
+        break;
+
+      case MESSAGE_CONVERT:
+        {
+          const size_t num = payload.size() / (2 * sizeof(float));
+          std::vector<float> xy(num * 2);
+          memcpy(xy.data(), payload.data(), xy.size() * sizeof(float));
+          result.resize(num * 2);
+          naviCon.LatLon(xy.data(), xy.data() + num, num, result.data(), result.data() + num);
+          written = MessageWrite(reply, MESSAGE_OK, result.data(), result.size() * sizeof(double));
+        }
+        break;
+
+      default:
+        throw EOperationFailed{"ERROR: Invalid NaviCon.dll worker request!!!"};
+      }
+    }
+    catch(const std::exception &ex) {
+      const std::string msg = ex.what();
+      written = MessageWrite(reply, MESSAGE_ERROR, msg.data(), msg.size());
+    }
+    if(!written)
+      return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * @brief Spawns worker processes.
+ *
+ * Function runs @p num worker processes connected with anonymous pipes to
+ * their standard input and output.
+ *
+ * @param workerExe The path to the executable that runs the worker when called with WORKER_OPTION.
+ * @param num       The number of workers to spawn.
+ *
+ * @exception EOperationFailed Thrown when worker process could not be created.
+ *
+ * @return Workers pool.
+ */
+std::unique_ptr<condor2nav::CNaviConWorkers> condor2nav::CNaviConWorkers::Spawn(const bfs::path &workerExe, unsigned num)
+{
+  std::vector<std::unique_ptr<CWorker>> workers;
+  for(unsigned i=0; i<num; i++) {
+    SECURITY_ATTRIBUTES sa;
+    sa.nLength = sizeof(sa);
+    sa.lpSecurityDescriptor = nullptr;
+    sa.bInheritHandle = TRUE;
+
+    // child ends are inherited, parent ends are not
+    HANDLE requestRead, requestWrite, replyRead, replyWrite;
+    if(!::CreatePipe(&requestRead, &requestWrite, &sa, 0))
+      throw EOperationFailed{"ERROR: Couldn't create NaviCon.dll worker pipe (" + Convert(GetLastError()) + ")!!!"};
+    CHandleRes requestChild{requestRead}, requestParent{requestWrite};
+    if(!::CreatePipe(&replyRead, &replyWrite, &sa, 0))
+      throw EOperationFailed{"ERROR: Couldn't create NaviCon.dll worker pipe (" + Convert(GetLastError()) + ")!!!"};
+    CHandleRes replyParent{replyRead}, replyChild{replyWrite};
+    ::SetHandleInformation(requestWrite, HANDLE_FLAG_INHERIT, 0);
+    ::SetHandleInformation(replyRead, HANDLE_FLAG_INHERIT, 0);
+
+    STARTUPINFO si;
+    ZeroMemory(&si, sizeof(si));
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = requestRead;
+    si.hStdOutput = replyWrite;
+    si.hStdError = ::GetStdHandle(STD_ERROR_HANDLE);
+
+    PROCESS_INFORMATION pi;
+    std::string cmdLine = "\"" + workerExe.string() + "\" " + WORKER_OPTION;
+    if(!::CreateProcess(nullptr, &cmdLine[0], nullptr, nullptr, TRUE, CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi))
+      throw EOperationFailed{"ERROR: Couldn't run NaviCon.dll worker '" + workerExe.string() + "' (" + Convert(GetLastError()) + ")!!!"};
+    ::CloseHandle(pi.hThread);
+    workers.push_back(std::make_unique<CWorker>(requestParent.release(), replyParent.release(), pi.hProcess));
+  }
+  return std::make_unique<CNaviConWorkers>(std::move(workers));
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CNaviConWorkers::CWorker class constructor.
+ *
+ * @param request The pipe to write requests to (ownership is taken).
+ * @param reply   The pipe to read replies from (ownership is taken).
+ * @param process Worker process handle (ownership is taken).
+ */
+condor2nav::CNaviConWorkers::CWorker::CWorker(HANDLE request, HANDLE reply, HANDLE process /* = nullptr */) :
+  _process{process}, _request{request}, _reply{reply}
+{
+}
+
+
+/**
+ * @brief Class destructor.
+ *
+ * condor2nav::CNaviConWorkers::CWorker class destructor. Closing the requests
+ * pipe makes the worker process exit.
+ */
+condor2nav::CNaviConWorkers::CWorker::~CWorker()
+{
+  _request.reset();
+  if(_process)
+    ::WaitForSingleObject(_process.get(), 5000);
+}
+
+
+/**
+ * @brief Sends the request to the worker and waits for the reply.
+ *
+ * @param type        Request type.
+ * @param request     Request payload.
+ * @param [out] reply Reply payload.
+ *
+ * @exception EOperationFailed Thrown when the worker failed or terminated.
+ */
+void condor2nav::CNaviConWorkers::CWorker::Call(uint32_t type, const std::vector<char> &request, std::vector<char> &reply)
+{
+  uint32_t replyType;
+  if(!MessageWrite(_request.get(), type, request.data(), request.size()) || !MessageRead(_reply.get(), replyType, reply)) {
+    _trn.clear();
+    throw EOperationFailed{"ERROR: NaviCon.dll worker process terminated unexpectedly!!!"};
+  }
+  if(replyType != MESSAGE_OK) {
+    _trn.clear();
+    throw EOperationFailed{std::string(reply.begin(), reply.end())};
+  }
+}
+
+
+/**
+ * @brief Initializes the worker with the terrain file.
+ *
+ * @param dllPath The path to NaviCon.dll.
+ * @param trnPath The path to the terrain file.
+ */
+void condor2nav::CNaviConWorkers::CWorker::Init(const bfs::path &dllPath, const bfs::path &trnPath)
+{
+  const auto dll = dllPath.string(), trn = trnPath.string();
+  std::vector<char> request, reply;
+  request.reserve(dll.size() + trn.size() + 2);
+  request.insert(request.end(), dll.c_str(), dll.c_str() + dll.size() + 1);
+  request.insert(request.end(), trn.c_str(), trn.c_str() + trn.size() + 1);
+  _trn.clear();
+  Call(MESSAGE_INIT, request, reply);
+  _trn = trn;
+}
+
+
+/**
+ * @brief Converts an array of Condor coordinates to latitudes and longitudes.
+ *
+ * @param x               The array of x coordinates.
+ * @param y               The array of y coordinates.
+ * @param num             The number of points to convert.
+ * @param [out] latitude  The array of converted latitudes.
+ * @param [out] longitude The array of converted longitudes.
+ */
+void condor2nav::CNaviConWorkers::CWorker::LatLon(const float x[], const float y[], size_t num, double latitude[], double longitude[])
+{
+  std::vector<char> request(num * 2 * sizeof(float)), reply;
+  memcpy(request.data(), x, num * sizeof(float));
+  memcpy(request.data() + num * sizeof(float), y, num * sizeof(float));
+  Call(MESSAGE_CONVERT, request, reply);
+  if(reply.size() != num * 2 * sizeof(double))
+    throw EOperationFailed{"ERROR: Invalid NaviCon.dll worker reply!!!"};
+  memcpy(latitude, reply.data(), num * sizeof(double));
+  memcpy(longitude, reply.data() + num * sizeof(double), num * sizeof(double));
+}
+
+
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CNaviConWorkers class constructor.
+ *
+ * @param workers Connections to worker processes.
+ */
+condor2nav::CNaviConWorkers::CNaviConWorkers(std::vector<std::unique_ptr<CWorker>> workers) :
+  _workers(std::move(workers)), _busy(_workers.size(), 0), _lastUse(_workers.size(), 0), _tick{0}
+{
+  if(_workers.empty())
+    throw EOperationFailed{"ERROR: No NaviCon.dll workers provided!!!"};
+}
+
+
+/**
+ * @brief Acquires a worker for the terrain.
+ *
+ * Method waits for a free worker. Worker already initialized with the terrain
+ * is preferred. Otherwise the least recently used one is returned.
+ *
+ * @param trn The path to the terrain file.
+ *
+ * @return The index of acquired worker.
+ */
+size_t condor2nav::CNaviConWorkers::Acquire(const std::string &trn)
+{
+  std::unique_lock<std::mutex> lock{_mutex};
+  for(;;) {
+    size_t best = _workers.size();
+    for(size_t i=0; i<_workers.size(); i++) {
+      if(_busy[i])
+        continue;
+      if(_workers[i]->Trn() == trn) {
+        best = i;
+        break;
+      }
+      if(best == _workers.size() || _lastUse[i] < _lastUse[best])
+        best = i;
+    }
+    if(best != _workers.size()) {
+      _busy[best] = 1;
+      return best;
+    }
+    _slotFree.wait(lock);
+  }
+}
+
+
+/**
+ * @brief Releases the worker.
+ *
+ * @param slot The index of the worker.
+ */
+void condor2nav::CNaviConWorkers::Release(size_t slot)
+{
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _busy[slot] = 0;
+    _lastUse[slot] = ++_tick;
+  }
+  _slotFree.notify_one();
+}
+
+
+/**
+ * @brief Converts an array of Condor coordinates to latitudes and longitudes.
+ *
+ * Method sends the whole batch to one worker. It is safe to call it from many
+ * threads at once.
+ *
+ * @param dllPath         The path to NaviCon.dll.
+ * @param trnPath         The path to the terrain file.
+ * @param x               The array of x coordinates.
+ * @param y               The array of y coordinates.
+ * @param num             The number of points to convert.
+ * @param [out] latitude  The array of converted latitudes.
+ * @param [out] longitude The array of converted longitudes.
+ *
+ * @exception EOperationFailed Thrown when the worker failed.
+ */
+void condor2nav::CNaviConWorkers::LatLon(const bfs::path &dllPath, const bfs::path &trnPath,
+                                         const float x[], const float y[], size_t num, double latitude[], double longitude[])
+{
+  const auto trn = trnPath.string();
+  const size_t slot = Acquire(trn);
+  try {
+    CWorker &worker = *_workers[slot];
+    if(worker.Trn() != trn)
+      worker.Init(dllPath, trnPath);
+    worker.LatLon(x, y, num, latitude, longitude);
+  }
+  catch(...) {
+    Release(slot);
+    throw;
+  }
+  Release(slot);
+}
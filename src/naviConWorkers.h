@@ -0,0 +1,102 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file naviConWorkers.h
+ *
+ * @brief Declares the condor2nav::CNaviConWorkers class.
+ */
+
+#ifndef __NAVICONWORKERS_H__
+#define __NAVICONWORKERS_H__
+
+#include "nonCopyable.h"
+#include "tools.h"
+#include "boostfwd.h"
+#include <windows.h>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace condor2nav {
+
+  /**
+   * @brief Pool of NaviCon.dll worker processes.
+   *
+   * NaviCon.dll keeps its state in global variables so it can be initialized
+   * only with one terrain per process and cannot be used from several threads
+   * at once. condor2nav::CNaviConWorkers runs the library in helper processes
+   * instead. Every worker owns its own instance of the library and converts
+   * batches of points sent over a pair of pipes. Workers remember the terrain
+   * they were initialized with so the requests for the same landscape go to the
+   * same worker if possible. Requests for different landscapes are processed in
+   * parallel by different workers.
+   */
+  class CNaviConWorkers : CNonCopyable {
+  public:
+    /**
+     * @brief Client side of the connection to one worker.
+     */
+    class CWorker : CNonCopyable {
+      CHandleRes _process;                          ///< @brief Worker process handle (nullptr if not owned).
+      CHandleRes _request;                          ///< @brief Requests pipe write end.
+      CHandleRes _reply;                            ///< @brief Replies pipe read end.
+      std::string _trn;                             ///< @brief The terrain file the worker is initialized with.
+
+      void Call(uint32_t type, const std::vector<char> &request, std::vector<char> &reply);
+
+    public:
+      CWorker(HANDLE request, HANDLE reply, HANDLE process = nullptr);
+      ~CWorker();
+      const std::string &Trn() const { return _trn; }
+      void Init(const bfs::path &dllPath, const bfs::path &trnPath);
+      void LatLon(const float x[], const float y[], size_t num, double latitude[], double longitude[]);
+    };
+
+  private:
+    std::mutex _mutex;                              ///< @brief Workers state access synchronization.
+    std::condition_variable _slotFree;              ///< @brief Signaled when a worker finishes its request.
+    std::vector<std::unique_ptr<CWorker>> _workers; ///< @brief Workers.
+    std::vector<char> _busy;                        ///< @brief Nonzero if the worker is processing a request.
+    std::vector<uint64_t> _lastUse;                 ///< @brief Last use counter value of every worker.
+    uint64_t _tick;                                 ///< @brief Use counter.
+
+    size_t Acquire(const std::string &trn);
+    void Release(size_t slot);
+
+  public:
+    static const char *WORKER_OPTION;               ///< @brief Command line option running the worker process.
+
+    static int Serve(HANDLE request, HANDLE reply);
+    static std::unique_ptr<CNaviConWorkers> Spawn(const bfs::path &workerExe, unsigned num);
+
+    explicit CNaviConWorkers(std::vector<std::unique_ptr<CWorker>> workers);
+    size_t Size() const { return _workers.size(); }
+    void LatLon(const bfs::path &dllPath, const bfs::path &trnPath,
+                const float x[], const float y[], size_t num, double latitude[], double longitude[]);
+  };
+
+}
+
+#endif /* __NAVICONWORKERS_H__ */
@@ -1,103 +1,438 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
- * @file ostream.cpp
- *
- * @brief Implements the OStream wrapper class. 
- */
-
-#include "ostream.h"
-#include "activeSync.h"
-#include <algorithm>
-#include <boost/filesystem/fstream.hpp>
-
-
-/**
- * @brief Class constructor.
- *
- * condor2nav::COStream class constructor.
- *
- * @param fileName The name of the file to create.
- */
-condor2nav::COStream::COStream(bfs::path fileName) :
-  _pathList{{std::move(fileName)}}
-{
-}
-
-
-/**
- * @brief Class constructor.
- *
- * condor2nav::COStream class constructor.
- *
- * @param pathList The list of files to create.
- */
-condor2nav::COStream::COStream(CPathList pathList) :
-  _pathList{std::move(pathList)}
-{
-}
-
-
-/**
- * @brief Class destructor.
- *
- * condor2nav::COStream class destructor. Writes local buffer to
- * a file.
- */
-condor2nav::COStream::~COStream()
-{
-  if(_buffer.str().size()) {
-    for(auto &path : _pathList) {
-      switch(PathType(path)) {
-      case TPathType::LOCAL:
-        {
-          bfs::ofstream stream{path, std::ios_base::out | std::ios_base::binary};
-          if(!stream)
-            throw EOperationFailed{"ERROR: Couldn't open file '" + path.string() + "' for writing!!!"};
-          stream << _buffer.str();
-        }
-        break;
-
-      case TPathType::ACTIVE_SYNC:
-        CActiveSync::Instance().Write(path, _buffer.str());
-        break;
-      }
-    }
-  }
-}
-
-
-/**
-* @brief Writes binary buffer to a stream.
-*
-* Method writes binary buffer to a stream.
-*
-* @param buffer Buffer data.
-* @param num Buffer size.
-*
-* @return Stream instance.
-*/
-condor2nav::COStream &condor2nav::COStream::Write(const char *buffer, std::streamsize num)
-{
-  _buffer.write(buffer, num);
-  return *this;
-}
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file ostream.cpp
+ *
+ * @brief Implements the OStream wrapper class. 
+ */
+
+#include "ostream.h"
+#include "archive.h"
+#include "outputManifest.h"
+#include "vfs.h"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <boost/filesystem.hpp>
+
+
+/**
+ * @brief Chunked output buffer.
+ *
+ * Stream buffer that stores the data in a list of CHUNK_SIZE chunks. Chunks
+ * are never reallocated so the data is written only once into the buffer.
+ */
+class condor2nav::COStream::CChunkBuffer : public std::streambuf {
+  std::vector<std::unique_ptr<char[]>> _chunks;       ///< @brief Allocated chunks (the last one is being filled).
+
+  void ChunkAdd()
+  {
+    _chunks.push_back(std::unique_ptr<char[]>{new char[CHUNK_SIZE]});
+    char *chunk = _chunks.back().get();
+    setp(chunk, chunk + CHUNK_SIZE);
+  }
+
+protected:
+  int_type overflow(int_type ch) override
+  {
+    if(traits_type::eq_int_type(ch, traits_type::eof()))
+      return traits_type::not_eof(ch);
+    ChunkAdd();
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+  }
+
+  std::streamsize xsputn(const char *data, std::streamsize num) override
+  {
+    std::streamsize left = num;
+    while(left) {
+      if(pptr() == epptr())
+        ChunkAdd();
+      const auto size = std::min<std::streamsize>(left, epptr() - pptr());
+      memcpy(pptr(), data, static_cast<size_t>(size));
+      pbump(static_cast<int>(size));
+      data += size;
+      left -= size;
+    }
+    return num;
+  }
+
+public:
+  /**
+   * @brief Returns views of all the chunks.
+   *
+   * @return Chunk views (the last one may be partially filled).
+   */
+  std::vector<boost::string_ref> Buffers() const
+  {
+    std::vector<boost::string_ref> buffers;
+    buffers.reserve(_chunks.size());
+    for(size_t i=0; i<_chunks.size(); i++) {
+      const size_t size = i + 1 < _chunks.size() ? CHUNK_SIZE : static_cast<size_t>(pptr() - _chunks[i].get());
+      if(size)
+        buffers.emplace_back(_chunks[i].get(), size);
+    }
+    return buffers;
+  }
+};
+
+
+namespace {
+
+  __declspec(thread) condor2nav::COStream::CTransaction *currentTransaction;   ///< @brief Transaction active in the current thread.
+
+  /**
+   * @brief Returns the size of the data.
+   *
+   * @param buffers The data.
+   *
+   * @return The number of bytes in all buffers.
+   */
+  uint64_t Size(const std::vector<boost::string_ref> &buffers)
+  {
+    uint64_t size = 0;
+    for(auto &buffer : buffers)
+      size += buffer.size();
+    return size;
+  }
+
+
+  /**
+   * @brief Writes buffers to the file.
+   *
+   * Writing is skipped if the file already has the same content.
+   *
+   * @param path    The path of the file to write.
+   * @param buffers The data to write.
+   * @param size    The size of the data.
+   * @param hash    The hash of the data.
+   */
+  void FileWrite(const bfs::path &path, const std::vector<boost::string_ref> &buffers, uint64_t size, uint64_t hash)
+  {
+    using namespace condor2nav;
+    auto &manifest = COutputManifest::Instance();
+    auto &vfs = CVfs::Instance(path);
+    if(manifest.Unchanged(vfs, path, size, hash))
+      return;
+
+    vfs.Write(path, buffers);
+    manifest.Written(vfs, path, size, hash);
+  }
+
+}
+
+
+/**
+ * @brief Returns active transaction.
+ *
+ * @return The transaction active in the current thread or nullptr.
+ */
+condor2nav::COStream::CTransaction *condor2nav::COStream::CTransaction::Current()
+{
+  return currentTransaction;
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::COStream::CTransaction class constructor. Makes the transaction
+ * active in the current thread until it is destroyed.
+ */
+condor2nav::COStream::CTransaction::CTransaction() :
+  _previous{currentTransaction}
+{
+  currentTransaction = this;
+}
+
+
+/**
+ * @brief Class destructor.
+ *
+ * condor2nav::COStream::CTransaction class destructor. Data not committed
+ * is dropped.
+ */
+condor2nav::COStream::CTransaction::~CTransaction()
+{
+  currentTransaction = _previous;
+}
+
+
+/**
+ * @brief Adds stream data to the transaction.
+ *
+ * @param pathList The list of destination files.
+ * @param chunks   Stream data.
+ */
+void condor2nav::COStream::CTransaction::Append(const CPathList &pathList, std::shared_ptr<const CChunkBuffer> chunks)
+{
+  for(auto &path : pathList)
+    _files[path.string()].push_back(chunks);
+}
+
+
+/**
+ * @brief Writes all the files of the transaction.
+ *
+ * Files are processed in the order of their paths. If the file system
+ * supports replacing files (local and in-memory ones), files are written
+ * to temporary files first and replace the final ones only after all the
+ * files were written successfully. Files being replaced are moved to backup
+ * files in the same operation, so if any replace fails the files already
+ * replaced are restored. ActiveSync files are written one after another
+ * within the same RAPI connection and are recorded in the manifest only after
+ * all of them were written so that the writes queued in
+ * condor2nav::CActiveSync::CBatch are not flushed one by one. They are written
+ * in place so the commit is only best-effort for them: files written before
+ * a failure are not restored. Files with unchanged content are skipped.
+ *
+ * @exception EOperationFailed Thrown when a file cannot be written.
+ */
+void condor2nav::COStream::CTransaction::Commit()
+{
+  struct TRename {
+    CVfs *vfs;
+    bfs::path tmp;
+    bfs::path path;
+    bfs::path backup;                            // empty if there is no file to replace
+    uint64_t size;
+    uint64_t hash;
+  };
+  std::vector<TRename> renames;
+  std::vector<TRename> written;
+  size_t replaced = 0;
+  auto &manifest = COutputManifest::Instance();
+  try {
+    for(auto &file : _files) {
+      const bfs::path path{file.first};
+      std::vector<boost::string_ref> buffers;
+      for(auto &part : file.second) {
+        auto partBuffers = part->Buffers();
+        buffers.insert(buffers.end(), partBuffers.begin(), partBuffers.end());
+      }
+      const uint64_t size = ::Size(buffers);
+      const uint64_t hash = COutputManifest::Hash(buffers);
+      auto &vfs = CVfs::Instance(path);
+      if(manifest.Unchanged(vfs, path, size, hash))
+        continue;
+
+      if(vfs.ReplaceSupported()) {
+        const TRename rename = { &vfs, path.string() + ".tmp", path, bfs::path{}, size, hash };
+        vfs.Write(rename.tmp, buffers);
+        renames.push_back(rename);
+      }
+      else {
+        vfs.Write(path, buffers);
+        const TRename write = { &vfs, bfs::path{}, path, bfs::path{}, size, hash };
+        written.push_back(write);
+      }
+    }
+
+    for(auto &write : written)
+      manifest.Written(*write.vfs, write.path, write.size, write.hash);
+
+    for(; replaced<renames.size(); replaced++) {
+      auto &rename = renames[replaced];
+      if(rename.vfs->Exists(rename.path)) {
+        const bfs::path backup{rename.path.string() + ".bak"};
+        rename.vfs->Replace(rename.tmp, rename.path, backup);
+        rename.backup = backup;
+      }
+      else {
+        rename.vfs->Replace(rename.tmp, rename.path);
+      }
+    }
+  }
+  catch(...) {
+    for(size_t i=0; i<renames.size(); i++) {
+      auto &rename = renames[i];
+      try {
+        if(i < replaced) {
+          // restore the previous content (backup is kept if that fails)
+          if(rename.backup.empty())
+            rename.vfs->Remove(rename.path);
+          else
+            rename.vfs->Replace(rename.backup, rename.path);
+        }
+        else {
+          rename.vfs->Remove(rename.tmp);
+        }
+      }
+      catch(...) {
+        // keep the original error
+      }
+    }
+    throw;
+  }
+
+  for(auto &rename : renames) {
+    manifest.Written(*rename.vfs, rename.path, rename.size, rename.hash);
+    if(!rename.backup.empty()) {
+      try {
+        rename.vfs->Remove(rename.backup);
+      }
+      catch(...) {
+        // files are already committed
+      }
+    }
+  }
+  _files.clear();
+}
+
+
+/**
+ * @brief Writes all the files of the transaction to one archive.
+ *
+ * Files are stored in a ZIP or TAR archive (selected by the archive file
+ * extension) in the order of their paths. Entries names are relative to
+ * @p root or, for files outside of it, are their full paths without the root
+ * name. The whole archive is written with one write and replaces the old one
+ * only after it was written successfully. The archive is not written if its
+ * content did not change.
+ *
+ * @param archivePath The path of the archive file.
+ * @param root        The directory entries names are relative to.
+ *
+ * @exception EOperationFailed Thrown when the archive cannot be written.
+ */
+void condor2nav::COStream::CTransaction::Commit(const bfs::path &archivePath, const bfs::path &root)
+{
+  CArchive archive{CArchive::Format(archivePath), std::time(nullptr)};
+  const auto rootStr = root.generic_string();
+  for(auto &file : _files) {
+    const bfs::path path{file.first};
+    std::vector<boost::string_ref> buffers;
+    for(auto &part : file.second) {
+      auto partBuffers = part->Buffers();
+      buffers.insert(buffers.end(), partBuffers.begin(), partBuffers.end());
+    }
+
+    auto name = path.generic_string();
+    if(!rootStr.empty() && name.size() > rootStr.size() && name.compare(0, rootStr.size(), rootStr) == 0 &&
+       (name[rootStr.size()] == '/' || rootStr.back() == '/'))
+      name.erase(0, rootStr.size() + (rootStr.back() == '/' ? 0 : 1));
+    else
+      name = path.relative_path().generic_string();
+    archive.Add(std::move(name), std::move(buffers));
+  }
+
+  const auto buffers = archive.Buffers();
+  const uint64_t size = ::Size(buffers);
+  const uint64_t hash = archive.ContentHash();
+  auto &manifest = COutputManifest::Instance();
+  auto &vfs = CVfs::Instance(archivePath);
+  if(!manifest.Unchanged(vfs, archivePath, size, hash)) {
+    if(vfs.ReplaceSupported()) {
+      const bfs::path tmp{archivePath.string() + ".tmp"};
+      try {
+        vfs.Write(tmp, buffers);
+        vfs.Replace(tmp, archivePath);
+      }
+      catch(...) {
+        try {
+          vfs.Remove(tmp);
+        }
+        catch(...) {
+          // keep the original error
+        }
+        throw;
+      }
+    }
+    else {
+      vfs.Write(archivePath, buffers);
+    }
+    manifest.Written(vfs, archivePath, size, hash);
+  }
+  _files.clear();
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::COStream class constructor.
+ *
+ * @param fileName The name of the file to create.
+ */
+condor2nav::COStream::COStream(bfs::path fileName) :
+  _chunks{std::make_unique<CChunkBuffer>()}, _stream{_chunks.get()},
+  _pathList{{std::move(fileName)}}
+{
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::COStream class constructor.
+ *
+ * @param pathList The list of files to create.
+ */
+condor2nav::COStream::COStream(CPathList pathList) :
+  _chunks{std::make_unique<CChunkBuffer>()}, _stream{_chunks.get()},
+  _pathList{std::move(pathList)}
+{
+}
+
+
+/**
+ * @brief Class destructor.
+ *
+ * condor2nav::COStream class destructor. Writes local buffer to
+ * all the destination files that do not already have the same content.
+ * If a transaction is active the buffer is passed to the transaction instead.
+ */
+condor2nav::COStream::~COStream()
+{
+  const auto buffers = _chunks->Buffers();
+  if(buffers.empty())
+    return;
+
+  if(currentTransaction) {
+    currentTransaction->Append(_pathList, std::move(_chunks));
+    return;
+  }
+
+  const uint64_t size = ::Size(buffers);
+  const uint64_t hash = COutputManifest::Hash(buffers);
+
+  for(auto &path : _pathList)
+    FileWrite(path, buffers, size, hash);
+}
+
+
+/**
+* @brief Writes binary buffer to a stream.
+*
+* Method writes binary buffer to a stream.
+*
+* @param buffer Buffer data.
+* @param num Buffer size.
+*
+* @return Stream instance.
+*/
+condor2nav::COStream &condor2nav::COStream::Write(const char *buffer, std::streamsize num)
+{
+  _stream.write(buffer, num);
+  return *this;
+}
@@ -1,96 +1,135 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
- * @file ostream.h
- *
- * @brief Declares the OStream wrapper class. 
- */
-
-#ifndef __OSTREAM_H__
-#define __OSTREAM_H__
-
-#include "nonCopyable.h"
-#include "boostfwd.h"
-#include <sstream>
-#include <vector>
-
-namespace condor2nav {
-
-  /**
-   * @brief Output stream wrapper
-   *
-   * condor2nav::COStream class is a wrapper for different stream types.
-   */
-  class COStream : CNonCopyable {
-  public:
-    using CPathList = std::vector<bfs::path>;
-
-  private:
-    std::stringstream _buffer;            ///< @brief Buffer with file data. 
-    CPathList _pathList;
-
-  public:
-    explicit COStream(bfs::path fileName);
-    explicit COStream(CPathList pathList);
-    ~COStream();
-    COStream &Write(const char *buffer, std::streamsize num);
-
-    void Dump(const bfs::path &fileName);
-
-    /**
-     * @brief Writes new data to a stream. 
-     *
-     * Function writes new data to a stream.
-     *
-     * @param stream Stream to use. 
-     * @param obj Data to write. 
-     *
-     * @return Stream instance.
-     */
-    template<class T>
-    friend COStream &operator<<(COStream &stream, const T &obj)
-    {
-      stream._buffer << obj;
-      return stream;
-    }
-
-    /**
-     * @brief Writes functor (e.g. std::endl) to a stream.
-     *
-     * Method writes functor (e.g. std::endl) to a stream.
-     *
-     * @param stream Stream to use. 
-     * @param f Functor to write. 
-     *
-     * @return Stream instance.
-     */
-    friend COStream &operator<<(COStream &stream, std::ostream &(*f)(std::ostream &))
-    {
-      stream._buffer << f;
-      return stream;
-    }
-  };
-
-}
-
-
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file ostream.h
+ *
+ * @brief Declares the OStream wrapper class. 
+ */
+
+#ifndef __OSTREAM_H__
+#define __OSTREAM_H__
+
+#include "nonCopyable.h"
+#include "boostfwd.h"
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace condor2nav {
+
+  /**
+   * @brief Output stream wrapper
+   *
+   * condor2nav::COStream class is a wrapper for different stream types.
+   * Data is collected in a list of fixed size chunks so it is never
+   * reallocated nor copied when the stream is flushed. All the destination
+   * files are written from the same chunks, or the chunks are passed to the
+   * active condor2nav::COStream::CTransaction.
+   */
+  class COStream : CNonCopyable {
+  public:
+    using CPathList = std::vector<bfs::path>;
+    static const size_t CHUNK_SIZE = 64 * 1024;  ///< @brief The size of one buffer chunk.
+
+  private:
+    class CChunkBuffer;
+
+  public:
+    /**
+     * @brief Output transaction.
+     *
+     * While condor2nav::COStream::CTransaction exists all the streams destroyed
+     * in its scope by the same thread pass their buffers to the transaction
+     * instead of writing files. Streams destroyed by other threads are not
+     * affected. Data of streams with the same destination is appended. Files are
+     * written only by condor2nav::COStream::CTransaction::Commit() in one pass
+     * sorted by the path. If the transaction is destroyed without a commit
+     * nothing is written.
+     */
+    class CTransaction : CNonCopyable {
+      using CParts = std::vector<std::shared_ptr<const CChunkBuffer>>;
+
+      std::map<std::string, CParts> _files;      ///< @brief Content of every destination file.
+      CTransaction *_previous;                   ///< @brief Transaction active before this one.
+
+    public:
+      static CTransaction *Current();
+
+      CTransaction();
+      ~CTransaction();
+      void Append(const CPathList &pathList, std::shared_ptr<const CChunkBuffer> chunks);
+      size_t Size() const { return _files.size(); }
+      void Commit();
+      void Commit(const bfs::path &archivePath, const bfs::path &root);
+    };
+
+  private:
+    std::unique_ptr<CChunkBuffer> _chunks;       ///< @brief Buffer with file data.
+    std::ostream _stream;                        ///< @brief Formatting stream writing to the buffer.
+    CPathList _pathList;                         ///< @brief Destination files.
+
+  public:
+    explicit COStream(bfs::path fileName);
+    explicit COStream(CPathList pathList);
+    ~COStream();
+    COStream &Write(const char *buffer, std::streamsize num);
+
+    /**
+     * @brief Writes new data to a stream. 
+     *
+     * Function writes new data to a stream.
+     *
+     * @param stream Stream to use. 
+     * @param obj Data to write. 
+     *
+     * @return Stream instance.
+     */
+    template<class T>
+    friend COStream &operator<<(COStream &stream, const T &obj)
+    {
+      stream._stream << obj;
+      return stream;
+    }
+
+    /**
+     * @brief Writes functor (e.g. std::endl) to a stream.
+     *
+     * Method writes functor (e.g. std::endl) to a stream.
+     *
+     * @param stream Stream to use. 
+     * @param f Functor to write. 
+     *
+     * @return Stream instance.
+     */
+    friend COStream &operator<<(COStream &stream, std::ostream &(*f)(std::ostream &))
+    {
+      stream._stream << f;
+      return stream;
+    }
+  };
+
+}
+
+
 #endif /* __OSTREAM_H__ */
\ No newline at end of file
@@ -0,0 +1,212 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file outputManifest.cpp
+ *
+ * @brief Implements the condor2nav::COutputManifest class.
+ *
+ * Manifest file contains one line per destination file:
+ * <hash> <size> <time> <path>
+ */
+
+#include "outputManifest.h"
+#include "hashTable.h"
+#include "istream.h"
+#include "tools.h"
+#include "vfs.h"
+#include <boost/filesystem/fstream.hpp>
+#include <iomanip>
+
+
+const bfs::path condor2nav::COutputManifest::MANIFEST_PATH = bfs::path{"data"} / "Cache" / "Outputs.manifest";
+
+
+/**
+ * @brief Returns the manifest used by all output streams.
+ *
+ * @return The manifest instance.
+ */
+condor2nav::COutputManifest &condor2nav::COutputManifest::Instance()
+{
+  static COutputManifest instance{MANIFEST_PATH};
+  return instance;
+}
+
+
+/**
+ * @brief Calculates the hash of the data.
+ *
+ * @param buffers The data to hash.
+ *
+ * @return XXH64 hash of the data.
+ */
+uint64_t condor2nav::COutputManifest::Hash(const std::vector<boost::string_ref> &buffers)
+{
+  CHashXXH64 hash;
+  for(auto &buffer : buffers)
+    hash.Update(buffer);
+  return hash.Digest();
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::COutputManifest class constructor. Loads the manifest file
+ * if it exists. Malformed lines are ignored.
+ *
+ * @param path The path of the manifest file.
+ */
+condor2nav::COutputManifest::COutputManifest(const bfs::path &path) :
+  _path{path}, _stats(), _modified{false}
+{
+  if(!bfs::exists(_path))
+    return;
+  try {
+    CIStream stream{_path};
+    std::string line;
+    while(stream.GetLine(line)) {
+      std::istringstream str{line};
+      TEntry entry;
+      std::string dest;
+      str >> std::hex >> entry.hash >> std::dec >> entry.size >> entry.time;
+      str.ignore(1);
+      if(str && std::getline(str, dest) && !dest.empty())
+        _entries[dest] = entry;
+    }
+  }
+  catch(const Exception &) {
+    // start with an empty manifest
+  }
+}
+
+
+/**
+ * @brief Checks if the file has to be written.
+ *
+ * Method checks if the destination file already has the same content. The file
+ * must also still have the size and the last write time recorded in the
+ * manifest. If the content changed the destination entry is removed until the
+ * file is written again.
+ *
+ * @param vfs  The file system of the destination file.
+ * @param dest The path of the destination file.
+ * @param size The size of the new content.
+ * @param hash The hash of the new content.
+ *
+ * @return true if writing the file may be skipped.
+ */
+bool condor2nav::COutputManifest::Unchanged(const CVfs &vfs, const bfs::path &dest, uint64_t size, uint64_t hash)
+{
+  TEntry entry;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto it = _entries.find(dest.string());
+    if(it == _entries.end())
+      return false;
+    entry = it->second;
+    if(entry.size != size || entry.hash != hash) {
+      _entries.erase(it);
+      _modified = true;
+      return false;
+    }
+  }
+
+  CVfs::TStat stat;
+  const bool unchanged = vfs.Stat(dest, stat) && !stat.directory && stat.size == size && stat.time == entry.time;
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  if(unchanged) {
+    _stats.filesSkipped++;
+    _stats.bytesSkipped += size;
+  }
+  else {
+    _entries.erase(dest.string());
+    _modified = true;
+  }
+  return unchanged;
+}
+
+
+/**
+ * @brief Records the file written.
+ *
+ * @param vfs  The file system of the destination file.
+ * @param dest The path of the destination file.
+ * @param size The size of the content written.
+ * @param hash The hash of the content written.
+ */
+void condor2nav::COutputManifest::Written(const CVfs &vfs, const bfs::path &dest, uint64_t size, uint64_t hash)
+{
+  CVfs::TStat stat;
+  const TEntry entry = { size, hash, vfs.Stat(dest, stat) ? stat.time : -1 };
+  std::lock_guard<std::mutex> lock{_mutex};
+  _entries[dest.string()] = entry;
+  _stats.filesWritten++;
+  _stats.bytesWritten += size;
+  _modified = true;
+}
+
+
+/**
+ * @brief Stores the manifest in a file.
+ *
+ * @exception EOperationFailed Thrown when the manifest file cannot be written.
+ */
+void condor2nav::COutputManifest::Save()
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  if(!_modified)
+    return;
+
+  boost::system::error_code ec;
+  bfs::create_directories(_path.parent_path(), ec);
+  bfs::ofstream stream{_path, std::ios_base::out | std::ios_base::binary};
+  if(!stream)
+    throw EOperationFailed{"ERROR: Couldn't open file '" + _path.string() + "' for writing!!!"};
+  for(auto &entry : _entries)
+    stream << std::hex << std::setw(16) << std::setfill('0') << entry.second.hash << std::dec << std::setfill(' ')
+           << " " << entry.second.size << " " << entry.second.time << " " << entry.first << "\n";
+  _modified = false;
+}
+
+
+/**
+ * @brief Returns write statistics.
+ *
+ * @return Statistics collected since the last condor2nav::COutputManifest::StatsReset() call.
+ */
+condor2nav::COutputManifest::TStats condor2nav::COutputManifest::Stats() const
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _stats;
+}
+
+
+/**
+ * @brief Clears write statistics.
+ */
+void condor2nav::COutputManifest::StatsReset()
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  _stats = TStats();
+}
@@ -0,0 +1,98 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file outputManifest.h
+ *
+ * @brief Declares the condor2nav::COutputManifest class.
+ */
+
+#ifndef __OUTPUTMANIFEST_H__
+#define __OUTPUTMANIFEST_H__
+
+#include "nonCopyable.h"
+#include "boostfwd.h"
+#include <boost/filesystem.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace condor2nav {
+
+  class CVfs;
+
+  /**
+   * @brief Manifest of generated output files.
+   *
+   * condor2nav::COutputManifest remembers the size and the XXH64 hash of every
+   * file written by condor2nav::COStream. When the same content is about to be
+   * written again to a destination that was not modified since then, the write
+   * is skipped. It matters mostly for files written to the PDA over ActiveSync.
+   */
+  class COutputManifest : CNonCopyable {
+  public:
+    /**
+     * @brief Write statistics.
+     */
+    struct TStats {
+      unsigned filesWritten;                          ///< @brief The number of files written.
+      uint64_t bytesWritten;                          ///< @brief The number of bytes written.
+      unsigned filesSkipped;                          ///< @brief The number of unchanged files not written.
+      uint64_t bytesSkipped;                          ///< @brief The number of bytes not written.
+    };
+
+  private:
+    /**
+     * @brief Destination file entry.
+     */
+    struct TEntry {
+      uint64_t size;                                  ///< @brief File size.
+      uint64_t hash;                                  ///< @brief File content hash.
+      int64_t time;                                   ///< @brief File last write time.
+    };
+
+    mutable std::mutex _mutex;                        ///< @brief Manifest access synchronization.
+    const bfs::path _path;                            ///< @brief The path of the manifest file.
+    std::map<std::string, TEntry> _entries;           ///< @brief Destination files entries.
+    TStats _stats;                                    ///< @brief Write statistics.
+    bool _modified;                                   ///< @brief true if the manifest was modified since loaded.
+
+  public:
+    static const bfs::path MANIFEST_PATH;             ///< @brief Default manifest file path.
+
+    static COutputManifest &Instance();
+    static uint64_t Hash(const std::vector<boost::string_ref> &buffers);
+
+    explicit COutputManifest(const bfs::path &path);
+
+    bool Unchanged(const CVfs &vfs, const bfs::path &dest, uint64_t size, uint64_t hash);
+    void Written(const CVfs &vfs, const bfs::path &dest, uint64_t size, uint64_t hash);
+    void Save();
+    TStats Stats() const;
+    void StatsReset();
+  };
+
+}
+
+#endif /* __OUTPUTMANIFEST_H__ */
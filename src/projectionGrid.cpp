@@ -0,0 +1,292 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file projectionGrid.cpp
+ *
+ * @brief Implements the condor2nav::CProjectionGrid class.
+ *
+ * Grid file layout (little endian):
+ * - TFileHeader
+ * - rows * cols nodes, each being a pair of doubles (latitude, longitude)
+ */
+
+#include "projectionGrid.h"
+#include "istream.h"
+#include "ostream.h"
+#include "exception.h"
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <intrin.h>
+#include <emmintrin.h>
+
+
+namespace {
+
+  const char GRID_MAGIC[8] = { 'C', '2', 'N', 'G', 'R', 'I', 'D', '\0' };   ///< @brief Grid file identifier.
+  const uint32_t GRID_VERSION = 1;                                           ///< @brief Grid file format version.
+
+  /**
+   * @brief Grid file header.
+   */
+  struct TFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t cols;
+    uint32_t rows;
+    float maxX;
+    float maxY;
+    uint32_t reserved;
+    uint64_t trnSize;
+    int64_t trnTime;
+  };
+
+
+  /**
+   * @brief Returns the index of the grid cell for the coordinate.
+   *
+   * Points outside of the grid use the nearest border cell so they are extrapolated.
+   *
+   * @param pos   The coordinate in grid steps.
+   * @param nodes The number of grid nodes along that axis.
+   *
+   * @return The index of the first node of the cell.
+   */
+  unsigned Cell(double pos, unsigned nodes)
+  {
+    return static_cast<unsigned>(std::min(std::max(pos, 0.0), nodes - 2.0));
+  }
+
+
+  /**
+   * @brief Detects the best interpolation supported by the CPU.
+   *
+   * @return The best interpolation.
+   */
+  condor2nav::CProjectionGrid::TInterpolation Detect()
+  {
+    using TInterpolation = condor2nav::CProjectionGrid::TInterpolation;
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 1)
+      return TInterpolation::SCALAR;
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) ? TInterpolation::SSE2 : TInterpolation::SCALAR;
+  }
+
+  const condor2nav::CProjectionGrid::TInterpolation bestInterpolation = Detect();   ///< @brief The best interpolation supported by the CPU.
+
+}
+
+
+/**
+ * @brief Returns the stamp of the terrain file.
+ *
+ * @param trnPath The path to landscape terrain file.
+ *
+ * @return Terrain file stamp.
+ */
+condor2nav::CProjectionGrid::TStamp condor2nav::CProjectionGrid::Stamp(const bfs::path &trnPath)
+{
+  TStamp stamp;
+  stamp.size = bfs::file_size(trnPath);
+  stamp.time = bfs::last_write_time(trnPath);
+  return stamp;
+}
+
+
+/**
+ * @brief Returns the best interpolation.
+ *
+ * Function returns the fastest interpolation implementation supported by the CPU.
+ *
+ * @return The best interpolation.
+ */
+condor2nav::CProjectionGrid::TInterpolation condor2nav::CProjectionGrid::InterpolationBest()
+{
+  return bestInterpolation;
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CProjectionGrid class constructor that loads the grid from a file.
+ *
+ * @param path The path of the grid file.
+ *
+ * @exception EOperationFailed Thrown when grid file is invalid.
+ */
+condor2nav::CProjectionGrid::CProjectionGrid(const bfs::path &path)
+{
+  CIStream stream{path};
+  const auto data = stream.Data();
+
+  TFileHeader header;
+  if(data.size() < sizeof(header))
+    throw EOperationFailed{"ERROR: Invalid projection grid file '" + path.string() + "'!!!"};
+  memcpy(&header, data.data(), sizeof(header));
+  if(memcmp(header.magic, GRID_MAGIC, sizeof(GRID_MAGIC)) || header.version != GRID_VERSION ||
+     header.cols < 2 || header.rows < 2 ||
+     data.size() != sizeof(header) + static_cast<size_t>(header.cols) * header.rows * 2 * sizeof(double))
+    throw EOperationFailed{"ERROR: Invalid projection grid file '" + path.string() + "'!!!"};
+
+  _stamp.size = header.trnSize;
+  _stamp.time = header.trnTime;
+  _cols = header.cols;
+  _rows = header.rows;
+  _maxX = header.maxX;
+  _maxY = header.maxY;
+  _nodes.resize(static_cast<size_t>(_cols) * _rows * 2);
+  memcpy(_nodes.data(), data.data() + sizeof(header), _nodes.size() * sizeof(double));
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CProjectionGrid class constructor that samples the projection
+ * in every node of the grid.
+ *
+ * @param stamp   Terrain file stamp.
+ * @param maxX    Landscape size along X axis.
+ * @param maxY    Landscape size along Y axis.
+ * @param step    Requested distance between grid nodes.
+ * @param xyToLat Converts Condor coordinates to latitude.
+ * @param xyToLon Converts Condor coordinates to longitude.
+ */
+condor2nav::CProjectionGrid::CProjectionGrid(const TStamp &stamp, float maxX, float maxY, float step,
+                                             const FConvert &xyToLat, const FConvert &xyToLon) :
+  _stamp(stamp),
+  _cols{std::max(static_cast<unsigned>(std::ceil(maxX / step)) + 1, 2u)},
+  _rows{std::max(static_cast<unsigned>(std::ceil(maxY / step)) + 1, 2u)},
+  _maxX{maxX}, _maxY{maxY}
+{
+  _nodes.reserve(static_cast<size_t>(_cols) * _rows * 2);
+  for(unsigned r=0; r<_rows; r++) {
+    const auto y = static_cast<float>(static_cast<double>(_maxY) * r / (_rows - 1));
+    for(unsigned c=0; c<_cols; c++) {
+      const auto x = static_cast<float>(static_cast<double>(_maxX) * c / (_cols - 1));
+      _nodes.push_back(xyToLat(x, y));
+      _nodes.push_back(xyToLon(x, y));
+    }
+  }
+}
+
+
+/**
+ * @brief Dumps the grid to a file.
+ *
+ * @param path The path of the grid file.
+ */
+void condor2nav::CProjectionGrid::Dump(const bfs::path &path) const
+{
+  TFileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, GRID_MAGIC, sizeof(GRID_MAGIC));
+  header.version = GRID_VERSION;
+  header.cols = _cols;
+  header.rows = _rows;
+  header.maxX = _maxX;
+  header.maxY = _maxY;
+  header.trnSize = _stamp.size;
+  header.trnTime = _stamp.time;
+
+  COStream stream{path};
+  stream.Write(reinterpret_cast<const char *>(&header), sizeof(header));
+  stream.Write(reinterpret_cast<const char *>(_nodes.data()), _nodes.size() * sizeof(double));
+}
+
+
+/**
+ * @brief Converts an array of Condor coordinates to latitudes and longitudes.
+ *
+ * Method interpolates coordinates using the fastest implementation supported by the CPU.
+ *
+ * @param x               The array of x coordinates.
+ * @param y               The array of y coordinates.
+ * @param num             The number of points to convert.
+ * @param [out] latitude  The array of converted latitudes.
+ * @param [out] longitude The array of converted longitudes.
+ */
+void condor2nav::CProjectionGrid::LatLon(const float x[], const float y[], size_t num, double latitude[], double longitude[]) const
+{
+  LatLon(x, y, num, latitude, longitude, bestInterpolation);
+}
+
+
+/**
+ * @brief Converts an array of Condor coordinates to latitudes and longitudes.
+ *
+ * Method does bilinear interpolation of 4 nodes surrounding every point. SSE2
+ * implementation interpolates latitude and longitude at once as every node
+ * stores them next to each other. Both implementations provide the same results.
+ *
+ * @param x               The array of x coordinates.
+ * @param y               The array of y coordinates.
+ * @param num             The number of points to convert.
+ * @param [out] latitude  The array of converted latitudes.
+ * @param [out] longitude The array of converted longitudes.
+ * @param interpolation   The implementation to use (has to be supported by the CPU).
+ */
+void condor2nav::CProjectionGrid::LatLon(const float x[], const float y[], size_t num, double latitude[], double longitude[],
+                                         TInterpolation interpolation) const
+{
+  const double scaleX = (_cols - 1) / static_cast<double>(_maxX);
+  const double scaleY = (_rows - 1) / static_cast<double>(_maxY);
+  const size_t rowSize = static_cast<size_t>(_cols) * 2;
+
+  for(size_t i=0; i<num; i++) {
+    const double posX = x[i] * scaleX;
+    const double posY = y[i] * scaleY;
+    const unsigned cellX = Cell(posX, _cols);
+    const unsigned cellY = Cell(posY, _rows);
+    const double tx = posX - cellX;
+    const double ty = posY - cellY;
+    const double *n00 = &_nodes[cellY * rowSize + cellX * 2];
+    const double *n10 = n00 + rowSize;
+
+    if(interpolation == TInterpolation::SSE2) {
+      const __m128d vtx = _mm_set1_pd(tx);
+      const __m128d v00 = _mm_loadu_pd(n00);
+      const __m128d v01 = _mm_loadu_pd(n00 + 2);
+      const __m128d v10 = _mm_loadu_pd(n10);
+      const __m128d v11 = _mm_loadu_pd(n10 + 2);
+      const __m128d top = _mm_add_pd(v00, _mm_mul_pd(_mm_sub_pd(v01, v00), vtx));
+      const __m128d bottom = _mm_add_pd(v10, _mm_mul_pd(_mm_sub_pd(v11, v10), vtx));
+      const __m128d result = _mm_add_pd(top, _mm_mul_pd(_mm_sub_pd(bottom, top), _mm_set1_pd(ty)));
+      _mm_storel_pd(&latitude[i], result);
+      _mm_storeh_pd(&longitude[i], result);
+    }
+    else {
+      double result[2];
+      for(unsigned j=0; j<2; j++) {
+        const double top = n00[j] + (n00[j + 2] - n00[j]) * tx;
+        const double bottom = n10[j] + (n10[j + 2] - n10[j]) * tx;
+        result[j] = top + (bottom - top) * ty;
+      }
+      latitude[i] = result[0];
+      longitude[i] = result[1];
+    }
+  }
+}
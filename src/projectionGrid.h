@@ -0,0 +1,99 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file projectionGrid.h
+ *
+ * @brief Declares the condor2nav::CProjectionGrid class.
+ */
+
+#ifndef __PROJECTIONGRID_H__
+#define __PROJECTIONGRID_H__
+
+#include "nonCopyable.h"
+#include "boostfwd.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace condor2nav {
+
+  /**
+   * @brief Condor landscape projection grid.
+   *
+   * condor2nav::CProjectionGrid stores latitudes and longitudes sampled in the
+   * nodes of a regular grid covering the whole Condor landscape. Coordinates of
+   * any other point are obtained with bilinear interpolation of the nearest nodes,
+   * so converting does not need NaviCon.dll. Grids are sampled once per landscape
+   * and stored in a binary file together with the stamp of the terrain file
+   * used to create them.
+   */
+  class CProjectionGrid : CNonCopyable {
+  public:
+    /**
+     * @brief Converts Condor coordinates to latitude or longitude.
+     */
+    using FConvert = std::function<double(float x, float y)>;
+
+    /**
+     * @brief Landscape terrain file stamp used to detect outdated grids.
+     */
+    struct TStamp {
+      uint64_t size;                                  ///< @brief Terrain file size.
+      int64_t time;                                   ///< @brief Terrain file last write time.
+      bool operator==(const TStamp &other) const { return size == other.size && time == other.time; }
+    };
+
+    /**
+     * @brief Interpolation implementations
+     */
+    enum class TInterpolation {
+      SCALAR,                                         ///< @brief Plain C++ implementation.
+      SSE2                                            ///< @brief Latitude and longitude interpolated in one SSE2 vector.
+    };
+
+  private:
+    TStamp _stamp;                                    ///< @brief Terrain file stamp.
+    unsigned _cols;                                   ///< @brief The number of grid nodes along X axis.
+    unsigned _rows;                                   ///< @brief The number of grid nodes along Y axis.
+    float _maxX;                                      ///< @brief Landscape size along X axis.
+    float _maxY;                                      ///< @brief Landscape size along Y axis.
+    std::vector<double> _nodes;                       ///< @brief Interleaved latitude and longitude of every node (row major).
+
+  public:
+    static TStamp Stamp(const bfs::path &trnPath);
+    static TInterpolation InterpolationBest();
+
+    explicit CProjectionGrid(const bfs::path &path);
+    CProjectionGrid(const TStamp &stamp, float maxX, float maxY, float step, const FConvert &xyToLat, const FConvert &xyToLon);
+
+    const TStamp &Stamp() const { return _stamp; }
+    unsigned Cols() const       { return _cols; }
+    unsigned Rows() const       { return _rows; }
+
+    void Dump(const bfs::path &path) const;
+    void LatLon(const float x[], const float y[], size_t num, double latitude[], double longitude[]) const;
+    void LatLon(const float x[], const float y[], size_t num, double latitude[], double longitude[], TInterpolation interpolation) const;
+  };
+
+}
+
+#endif /* __PROJECTIONGRID_H__ */
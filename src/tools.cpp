@@ -1,301 +1,465 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
- * @file tools.cpp
- *
- * @brief Implements common tools. 
- */
-
-#include "tools.h"
-#include "istream.h"
-#include "activeSync.h"
-#include <boost/filesystem.hpp>
-#include <boost/filesystem/fstream.hpp>
-#include <iomanip>
-#include <vector>
-#include <algorithm>
-#include <windows.h>
-
-
-
-namespace {
-
-  const double PI = 3.1415923865;
-
-}
-
-
-/**
- * @brief Removes leading and trailing white spaces from string.
- *
- * Method removes leading and trailing white spaces from given string.
- *
- * @param [in,out] str The string to cut.
- *
- * @return Cut string.
- */
-void condor2nav::Trim(std::string &str)
-{
-  if(str != "") {
-    const size_t pos1 = str.find_first_not_of(" \t\r");
-    const size_t pos2 = str.find_last_not_of(" \t\r");
-    str = str.substr(pos1, pos2 - pos1 + 1);
-  }
-}
-
-
-namespace {
-
-  template<typename T>
-  std::string Coord2DDMMFFImpl(T coord)
-  {
-    double absValue = coord.value;
-    if(coord.value < 0)
-      absValue = -absValue;
-    const unsigned deg = static_cast<unsigned>(absValue);
-    const double min = (absValue - deg) * 60;
-    std::stringstream stream;
-    stream.setf(std::ios::fixed, std::ios::floatfield);
-    stream.setf(std::ios::showpoint);
-    stream.precision(3);
-    stream << std::setfill('0') << std::setw(T::degStrLength) << deg << ":" << std::setw(6) << min << coord.Sign();
-    return stream.str();
-  }
-
-}
-
-/**
- * @brief Converts longitude coordinate.
- *
- * Method converts longitude coordinate from DD.FF to DD:MM.FF format.
- *
- * @param coord     The coordinate value to convert. 
- *
- * @return Converted coordinate string.
- */
-std::string condor2nav::Coord2DDMMFF(TLongitude coord)
-{
-  return Coord2DDMMFFImpl(coord);
-}
-
-/**
-* @brief Converts latitude coordinate to string.
-*
-* Method converts latitude coordinate from DD.FF to DD:MM.FF format.
-*
-* @param coord     The coordinate value to convert.
-*
-* @return Converted coordinate string.
-*/
-std::string condor2nav::Coord2DDMMFF(TLatitude coord)
-{
-  return Coord2DDMMFFImpl(coord);
-}
-
-
-namespace {
-
-  template<typename T>
-  std::string Coord2DDMMSSImpl(T coord)
-  {
-    double absValue = coord.value;
-    if(coord.value < 0)
-      absValue = -absValue;
-    const unsigned deg = static_cast<unsigned>(absValue);
-    const unsigned min = static_cast<unsigned>((absValue - deg) * 60);
-    const unsigned sec = static_cast<unsigned>(((absValue - deg) * 60 - min) * 60);
-    std::stringstream stream;
-    stream << std::setfill('0') << std::setw(T::degStrLength) << deg << ":" << std::setw(2) << min << ":" << std::setw(2) << sec << coord.Sign();
-    return stream.str();
-  }
-
-}
-
-/**
- * @brief Converts longitude coordinate to string.
- *
- * Method converts longitude coordinate from DD.FF to DD:MM::SS format.
- *
- * @param coord     The coordinate value to convert. 
- *
- * @return Converted coordinate string.
- */
-std::string condor2nav::Coord2DDMMSS(TLongitude coord)
-{
-  return Coord2DDMMSSImpl(coord);
-}
-
-/**
-* @brief Converts latitude coordinate to string.
-*
-* Method converts latitude coordinate from DD.FF to DD:MM::SS format.
-*
-* @param coord     The coordinate value to convert.
-*
-* @return Converted coordinate string.
-*/
-std::string condor2nav::Coord2DDMMSS(TLatitude coord)
-{
-  return Coord2DDMMSSImpl(coord);
-}
-
-
-/**
-* @brief Checks inner rectangle is spaced inside outer area.
-*
-* Method checks inner rectangle is spaced inside outer area.
-*
-* @return True if rectangle is inside area.
-*/
-bool condor2nav::InsideArea(TLongitude outerLonMin, TLongitude outerLonMax, TLatitude outerLatMin, TLatitude outerLatMax,
-                            TLongitude innerLonMin, TLongitude innerLonMax, TLatitude innerLatMin, TLatitude innerLatMax)
-{
-  return innerLonMin.value >= outerLonMin.value && innerLonMax.value <= outerLonMax.value &&
-    innerLatMin.value >= outerLatMin.value && innerLatMax.value <= outerLatMax.value;
-}
-
-
-/**
- * @brief Converts the speed units.
- *
- * Function converts the speed units from km/h to m/s.
- *
- * @param value The speed value to convert.
- *
- * @return Converted speed.
- */
-int condor2nav::KmH2MS(int value)
-{
-  return static_cast<int>((value * 10.0 / 36) + 0.5);
-}
-
-
-/**
- * @brief Converts angle described in degrees to radians
- *
- * Method converts angle described in degrees to radians.
- *
- * @param angle     Angle to convert. 
- *
- * @return Converted angle.
- */
-double condor2nav::Deg2Rad(double angle)
-{
-  return angle * PI / 180 ;
-}
-
-
-/**
- * @brief Converts angle described in radians to degrees
- *
- * Method converts angle described in radians to degrees.
- *
- * @param angle     Angle to convert. 
- *
- * @return Converted angle.
- */
-double condor2nav::Rad2Deg(double angle)
-{
-  return angle * 180 / PI;
-}
-
-
-/** 
- * @brief Creates specified directory
- * 
- * Function creates given directory recursively.
- * 
- * @param dirName Directory name to created.
- *
- * @exception std::runtime_error Operation did not succeed
- */
-void condor2nav::DirectoryCreate(const bfs::path &dirName)
-{
-  bool activeSync = false;
-  const std::string str = dirName.string();
-  if(str.size() > 2 && str[0] == '\\' && str[1] != '\\')
-    activeSync = true;
-
-  if(!dirName.empty()) {
-    if(!activeSync) {
-      bfs::create_directories(dirName);
-    }
-    else {
-      auto path = dirName;
-      std::vector<bfs::path> dirs;
-      while(path.parent_path() != "\\") {
-        dirs.emplace_back(path);
-        path = path.parent_path();
-      }
-      auto &activeSync = CActiveSync::Instance();
-      std::for_each(dirs.crbegin(), dirs.crend(),
-                    [&](const bfs::path &d){ activeSync.DirectoryCreate(d); });
-    }
-  }
-}
-
-
-/** 
- * @brief Checks if file exists in current directory
- * 
- * Function checks if specified file exists.
- * 
- * @param fileName File name to search for
- * 
- * @return Check status
- */
-bool condor2nav::FileExists(const bfs::path &fileName) 
-{
-  bool activeSync = false;
-  const auto str = fileName.string();
-  if(str.size() > 2 && str[0] == '\\' && str[1] != '\\')
-    activeSync = true;
-
-  if(activeSync)
-    return CActiveSync::Instance().FileExists(fileName);
-  else
-    return bfs::exists(fileName);
-}
-
-
-void condor2nav::Download(const std::string &server, const bfs::path &url, const bfs::path &fileName, unsigned timeout /* = 30 */)
-{
-  DirectoryCreate(fileName.parent_path());
-  bfs::ofstream out{fileName, std::ios_base::out | std::ios_base::binary};
-  CIStream in{server, url.generic_string(), timeout};
-  out << in;
-}
-
-
-/**
-* @brief Returns file type.
-*
-* Determinates file type based on its name.
-*/
-condor2nav::TPathType condor2nav::PathType(const bfs::path &fileName)
-{
-  std::string str{fileName.string()};
-  if(str.size() > 2 && str[0] == '\\' && str[1] != '\\')
-    return TPathType::ACTIVE_SYNC;
-  else
-    return TPathType::LOCAL;
-}
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file tools.cpp
+ *
+ * @brief Implements common tools. 
+ */
+
+#include "tools.h"
+#include "nonCopyable.h"
+#include "vfs.h"
+#include <boost/filesystem.hpp>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <clocale>
+#include <windows.h>
+
+
+
+namespace {
+
+  const double PI = 3.1415923865;
+
+}
+
+
+namespace {
+
+  /**
+   * @brief "C" locale used for locale independent conversions.
+   */
+  class CLocaleC : condor2nav::CNonCopyable {
+    _locale_t _locale;
+  public:
+    CLocaleC() : _locale{::_create_locale(LC_NUMERIC, "C")} {}
+    ~CLocaleC() { ::_free_locale(_locale); }
+    operator _locale_t() const { return _locale; }
+  };
+
+  const CLocaleC localeC;
+
+  bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r'; }
+
+  /**
+   * @brief Writes decimal digits of the value.
+   *
+   * @param end   The end of the buffer to write to (digits are written backwards).
+   * @param value The value to write.
+   *
+   * @return The beginning of written digits.
+   */
+  char *DigitsWrite(char *end, unsigned long long value)
+  {
+    do {
+      *--end = static_cast<char>('0' + value % 10);
+      value /= 10;
+    }
+    while(value);
+    return end;
+  }
+
+}
+
+
+/**
+ * @brief Converts string to an integer.
+ *
+ * Function converts provided string to an integer the same way as STL streams
+ * do in "C" locale: leading white spaces are skipped, conversion stops on the
+ * first character that is not a digit and a string with no characters to convert
+ * gives 0. The sign and the magnitude are returned separately so the caller
+ * may check the range of its type.
+ *
+ * @param str             The string to convert.
+ * @param [out] negative  true if the number has '-' sign.
+ * @param [out] magnitude Absolute value of the number.
+ *
+ * @return false if the string does not start with a number or the number does
+ *         not fit in 64 bits.
+ */
+bool condor2nav::StringToInteger(boost::string_ref str, bool &negative, unsigned long long &magnitude)
+{
+  size_t i = 0;
+  while(i < str.size() && IsSpace(str[i]))
+    ++i;
+
+  negative = false;
+  if(i < str.size() && (str[i] == '+' || str[i] == '-'))
+    negative = str[i++] == '-';
+
+  const unsigned long long max = static_cast<unsigned long long>(-1);
+  const size_t digitsPos = i;
+  magnitude = 0;
+  for(; i < str.size() && str[i] >= '0' && str[i] <= '9'; ++i) {
+    const unsigned digit = str[i] - '0';
+    if(magnitude > (max - digit) / 10)
+      return false;
+    magnitude = magnitude * 10 + digit;
+  }
+
+  if(i == digitsPos) {
+    negative = false;
+    return i == str.size();
+  }
+  return true;
+}
+
+
+/**
+ * @brief Converts string to a floating point value.
+ *
+ * Function converts provided string to a floating point value in "C" locale
+ * the same way as STL streams do. Leading white spaces are skipped, conversion
+ * stops on the first character that cannot be a part of a decimal number and
+ * a string with no characters to convert gives 0. Special values (i.e. "inf",
+ * "nan") and hexadecimal numbers are not accepted.
+ *
+ * @param str         The string to convert.
+ * @param [out] value Converted value.
+ *
+ * @return false if the string does not start with a number or the number is
+ *         out of the range of double.
+ */
+bool condor2nav::StringToDouble(boost::string_ref str, double &value)
+{
+  auto digits = [&](size_t i) -> size_t { while(i < str.size() && str[i] >= '0' && str[i] <= '9') ++i; return i; };
+
+  // find the decimal number: [sign] digits [. digits] [e [sign] digits]
+  size_t begin = 0;
+  while(begin < str.size() && IsSpace(str[begin]))
+    ++begin;
+  size_t end = begin;
+  if(end < str.size() && (str[end] == '+' || str[end] == '-'))
+    ++end;
+  const size_t intPos = end;
+  end = digits(end);
+  size_t mantissaDigits = end - intPos;
+  if(end < str.size() && str[end] == '.') {
+    const size_t fracEnd = digits(end + 1);
+    mantissaDigits += fracEnd - end - 1;
+    end = fracEnd;
+  }
+  if(!mantissaDigits) {
+    value = 0;
+    return begin == str.size();
+  }
+  if(end < str.size() && (str[end] == 'e' || str[end] == 'E')) {
+    size_t expPos = end + 1;
+    if(expPos < str.size() && (str[expPos] == '+' || str[expPos] == '-'))
+      ++expPos;
+    const size_t expEnd = digits(expPos);
+    if(expEnd != expPos)
+      end = expEnd;
+  }
+
+  char buffer[64];
+  std::string longStr;
+  const char *number;
+  const size_t size = end - begin;
+  if(size < sizeof(buffer)) {
+    std::copy(str.begin() + begin, str.begin() + end, buffer);
+    buffer[size] = '\0';
+    number = buffer;
+  }
+  else {
+    longStr = str.substr(begin, size).to_string();
+    number = longStr.c_str();
+  }
+
+  value = ::_strtod_l(number, nullptr, localeC);
+  return value != HUGE_VAL && value != -HUGE_VAL;
+}
+
+
+/**
+ * @brief Converts an integer to string.
+ *
+ * @param value The value to convert.
+ *
+ * @return The string with decimal representation of the value.
+ */
+std::string condor2nav::IntegerToString(long long value)
+{
+  char buffer[24];
+  char *end = buffer + sizeof(buffer);
+  char *begin = DigitsWrite(end, value < 0 ? 0 - static_cast<unsigned long long>(value) : value);
+  if(value < 0)
+    *--begin = '-';
+  return std::string(begin, end);
+}
+
+
+/**
+ * @brief Converts an unsigned integer to string.
+ *
+ * @param value The value to convert.
+ *
+ * @return The string with decimal representation of the value.
+ */
+std::string condor2nav::IntegerToString(unsigned long long value)
+{
+  char buffer[24];
+  char *end = buffer + sizeof(buffer);
+  return std::string(DigitsWrite(end, value), end);
+}
+
+
+/**
+ * @brief Converts a floating point value to string.
+ *
+ * Function converts provided value to string in "C" locale with the same
+ * format that is used by STL streams by default ("%g").
+ *
+ * @param value The value to convert.
+ *
+ * @return The string describing the value.
+ */
+std::string condor2nav::DoubleToString(double value)
+{
+  char buffer[32];
+  ::_sprintf_s_l(buffer, sizeof(buffer), "%g", localeC, value);
+  return buffer;
+}
+
+
+/**
+ * @brief Removes leading and trailing white spaces from string.
+ *
+ * Method removes leading and trailing white spaces from given string.
+ *
+ * @param [in,out] str The string to cut.
+ *
+ * @return Cut string.
+ */
+void condor2nav::Trim(std::string &str)
+{
+  if(str != "") {
+    const size_t pos1 = str.find_first_not_of(" \t\r");
+    const size_t pos2 = str.find_last_not_of(" \t\r");
+    str = str.substr(pos1, pos2 - pos1 + 1);
+  }
+}
+
+
+/**
+ * @brief Removes leading and trailing white spaces from string view.
+ *
+ * Method narrows given string view so it does not contain leading and trailing
+ * white spaces. No characters are copied.
+ *
+ * @param [in,out] str The string view to cut.
+ */
+void condor2nav::Trim(boost::string_ref &str)
+{
+  while(!str.empty() && (str.front() == ' ' || str.front() == '\t' || str.front() == '\r'))
+    str.remove_prefix(1);
+  while(!str.empty() && (str.back() == ' ' || str.back() == '\t' || str.back() == '\r'))
+    str.remove_suffix(1);
+}
+
+
+namespace {
+
+  template<typename T>
+  std::string Coord2DDMMFFImpl(T coord)
+  {
+    double absValue = coord.value;
+    if(coord.value < 0)
+      absValue = -absValue;
+    const unsigned deg = static_cast<unsigned>(absValue);
+    const double min = (absValue - deg) * 60;
+    std::stringstream stream;
+    stream.setf(std::ios::fixed, std::ios::floatfield);
+    stream.setf(std::ios::showpoint);
+    stream.precision(3);
+    stream << std::setfill('0') << std::setw(T::degStrLength) << deg << ":" << std::setw(6) << min << coord.Sign();
+    return stream.str();
+  }
+
+}
+
+/**
+ * @brief Converts longitude coordinate.
+ *
+ * Method converts longitude coordinate from DD.FF to DD:MM.FF format.
+ *
+ * @param coord     The coordinate value to convert. 
+ *
+ * @return Converted coordinate string.
+ */
+std::string condor2nav::Coord2DDMMFF(TLongitude coord)
+{
+  return Coord2DDMMFFImpl(coord);
+}
+
+/**
+* @brief Converts latitude coordinate to string.
+*
+* Method converts latitude coordinate from DD.FF to DD:MM.FF format.
+*
+* @param coord     The coordinate value to convert.
+*
+* @return Converted coordinate string.
+*/
+std::string condor2nav::Coord2DDMMFF(TLatitude coord)
+{
+  return Coord2DDMMFFImpl(coord);
+}
+
+
+namespace {
+
+  template<typename T>
+  std::string Coord2DDMMSSImpl(T coord)
+  {
+    double absValue = coord.value;
+    if(coord.value < 0)
+      absValue = -absValue;
+    const unsigned deg = static_cast<unsigned>(absValue);
+    const unsigned min = static_cast<unsigned>((absValue - deg) * 60);
+    const unsigned sec = static_cast<unsigned>(((absValue - deg) * 60 - min) * 60);
+    std::stringstream stream;
+    stream << std::setfill('0') << std::setw(T::degStrLength) << deg << ":" << std::setw(2) << min << ":" << std::setw(2) << sec << coord.Sign();
+    return stream.str();
+  }
+
+}
+
+/**
+ * @brief Converts longitude coordinate to string.
+ *
+ * Method converts longitude coordinate from DD.FF to DD:MM::SS format.
+ *
+ * @param coord     The coordinate value to convert. 
+ *
+ * @return Converted coordinate string.
+ */
+std::string condor2nav::Coord2DDMMSS(TLongitude coord)
+{
+  return Coord2DDMMSSImpl(coord);
+}
+
+/**
+* @brief Converts latitude coordinate to string.
+*
+* Method converts latitude coordinate from DD.FF to DD:MM::SS format.
+*
+* @param coord     The coordinate value to convert.
+*
+* @return Converted coordinate string.
+*/
+std::string condor2nav::Coord2DDMMSS(TLatitude coord)
+{
+  return Coord2DDMMSSImpl(coord);
+}
+
+
+/**
+ * @brief Converts the speed units.
+ *
+ * Function converts the speed units from km/h to m/s.
+ *
+ * @param value The speed value to convert.
+ *
+ * @return Converted speed.
+ */
+int condor2nav::KmH2MS(int value)
+{
+  return static_cast<int>((value * 10.0 / 36) + 0.5);
+}
+
+
+/**
+ * @brief Converts angle described in degrees to radians
+ *
+ * Method converts angle described in degrees to radians.
+ *
+ * @param angle     Angle to convert. 
+ *
+ * @return Converted angle.
+ */
+double condor2nav::Deg2Rad(double angle)
+{
+  return angle * PI / 180 ;
+}
+
+
+/**
+ * @brief Converts angle described in radians to degrees
+ *
+ * Method converts angle described in radians to degrees.
+ *
+ * @param angle     Angle to convert. 
+ *
+ * @return Converted angle.
+ */
+double condor2nav::Rad2Deg(double angle)
+{
+  return angle * 180 / PI;
+}
+
+
+/** 
+ * @brief Creates specified directory
+ * 
+ * Function creates given directory recursively.
+ * 
+ * @param dirName Directory name to created.
+ *
+ * @exception std::runtime_error Operation did not succeed
+ */
+void condor2nav::DirectoryCreate(const bfs::path &dirName)
+{
+  if(!dirName.empty())
+    CVfs::Instance(dirName).DirectoryCreate(dirName);
+}
+
+
+/** 
+ * @brief Checks if file exists in current directory
+ * 
+ * Function checks if specified file exists.
+ * 
+ * @param fileName File name to search for
+ * 
+ * @return Check status
+ */
+bool condor2nav::FileExists(const bfs::path &fileName) 
+{
+  return CVfs::Instance(fileName).Exists(fileName);
+}
+
+
+/**
+* @brief Returns file type.
+*
+* Determinates file type based on the scheme of its name.
+*/
+condor2nav::TPathType condor2nav::PathType(const bfs::path &fileName)
+{
+  return CVfs::Instance(fileName).Type();
+}
@@ -1,148 +1,252 @@
-//
-// This file is part of Condor2Nav file formats translator.
-//
-// Copyright (C) 2009-2012 Mateusz Pusz
-//
-// Condor2Nav is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// Condor2Nav is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
-//
-// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
-//
-
-/**
- * @file src/tools.h
- *
- * @brief Declares common tools. 
- */
-
-#ifndef __TOOLS_H__
-#define __TOOLS_H__
-
-#include "exception.h"
-#include "boostfwd.h"
-#include <sstream>
-#include <memory>
-#include <Windows.h>
-
-
-namespace condor2nav {
-
-  /**
-   * @brief Deleter for HModule
-   */
-  struct CLibraryDeleter {
-    typedef HMODULE pointer;
-    void operator()(HMODULE hmod) const { ::FreeLibrary(hmod); }
-  };
-  using CLibraryRes = std::unique_ptr<HMODULE, CLibraryDeleter>;
-
-  // conversions
-  template<class T>
-  T Convert(const std::string &str);
-  template<class T>
-  std::string Convert(const T &val);
-
-  void Trim(std::string &str);
-
-  struct TLongitude {
-    static const int degStrLength = 3;
-    double value;
-    explicit TLongitude(double v) : value{v} {}
-    char Sign() const { return value < 0 ? 'W' : 'E'; }
-  };
-
-  struct TLatitude {
-    static const int degStrLength = 2;
-    double value;
-    explicit TLatitude(double v) : value{v} {}
-    char Sign() const { return value < 0 ? 'S' : 'N'; }
-  };
-
-  std::string Coord2DDMMFF(TLongitude coord);
-  std::string Coord2DDMMFF(TLatitude coord);
-  std::string Coord2DDMMSS(TLongitude coord);
-  std::string Coord2DDMMSS(TLatitude coord);
-
-  bool InsideArea(TLongitude outerLonMin, TLongitude outerLonMax, TLatitude outerLatMin, TLatitude outerLatMax,
-                  TLongitude innerLonMin, TLongitude innerLonMax, TLatitude innerLatMin, TLatitude innerLatMax);
-
-  int KmH2MS(int value);
-
-  double Deg2Rad(double angle);
-  double Rad2Deg(double angle);
-
-  // disk operations
-  void DirectoryCreate(const bfs::path &dirName);
-  bool FileExists(const bfs::path &fileName);
-  void Download(const std::string &server, const bfs::path &url, const bfs::path &fileName, unsigned timeout = 30);
-
-  /*
-   * @brief Stream types
-   */
-  enum class TPathType {
-    LOCAL,                              ///< @brief Local path. 
-    ACTIVE_SYNC                         ///< @brief ActiveSync (remote device) path. 
-  };
-  TPathType PathType(const bfs::path &fileName);
-
-}
-
-
-/**
- * @brief Converts string to specific type.
- *
- * Function converts provided string to specified type. The convertion
- * is being done using STL streams so the output type have to provide
- * the means to initialize itself from the stream.
- *
- * @param str The string to convert.
- *
- * @exception std Thrown when operation failed.
- *
- * @return The data of specified type.
- */
-template<class T>
-T condor2nav::Convert(const std::string &str)
-{
-  T value;
-  std::stringstream stream{str};
-  stream >> value;
-  if(stream.fail() && !stream.eof())
-    throw EOperationFailed{"Cannot convert '" + str + "' to requested type!!!"};
-  return value;
-}
-
-
-/**
- * @brief Converts any type to a string.
- *
- * Function converts provided data to a string. The convertion
- * is being done using STL streams so the input type have to provide
- * the means to convert itself into the stream.
- *
- * @param val The value to convert.
- *
- * @exception std Thrown when operation failed.
- *
- * @return The string describing provided data.
- */
-template<class T>
-std::string condor2nav::Convert(const T &val)
-{
-  std::stringstream stream;
-  stream << val;
-  return stream.str();
-}
-
-
-#endif /* __TOOLS_H__ */
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file src/tools.h
+ *
+ * @brief Declares common tools. 
+ */
+
+#ifndef __TOOLS_H__
+#define __TOOLS_H__
+
+#include "exception.h"
+#include "boostfwd.h"
+#include <sstream>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <boost/utility/string_ref.hpp>
+#include <Windows.h>
+
+
+namespace condor2nav {
+
+  /**
+   * @brief Deleter for HModule
+   */
+  struct CLibraryDeleter {
+    typedef HMODULE pointer;
+    void operator()(HMODULE hmod) const { ::FreeLibrary(hmod); }
+  };
+  using CLibraryRes = std::unique_ptr<HMODULE, CLibraryDeleter>;
+
+  /**
+   * @brief Deleter for kernel object HANDLE
+   */
+  struct CHandleDeleter {
+    typedef HANDLE pointer;
+    void operator()(HANDLE handle) const { ::CloseHandle(handle); }
+  };
+  using CHandleRes = std::unique_ptr<HANDLE, CHandleDeleter>;
+
+  // conversions
+  template<class T>
+  T Convert(boost::string_ref str);
+  template<class T>
+  std::string Convert(const T &val);
+
+  // locale independent conversions of arithmetic types used by Convert()
+  bool StringToInteger(boost::string_ref str, bool &negative, unsigned long long &magnitude);
+  bool StringToDouble(boost::string_ref str, double &value);
+  std::string IntegerToString(long long value);
+  std::string IntegerToString(unsigned long long value);
+  std::string DoubleToString(double value);
+
+  /**
+   * @brief Conversion method selector.
+   *
+   * Integers (apart of characters and bool that have their own stream formats)
+   * and floating point types are converted without STL streams.
+   */
+  template<class T>
+  struct CConvertMethod {
+    enum {
+      INTEGER = std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value &&
+                !std::is_same<T, signed char>::value && !std::is_same<T, unsigned char>::value && !std::is_same<T, wchar_t>::value,
+      FLOAT   = std::is_floating_point<T>::value
+    };
+    using type = std::integral_constant<int, INTEGER ? 1 : FLOAT ? 2 : 0>;
+  };
+
+  void Trim(std::string &str);
+  void Trim(boost::string_ref &str);
+
+  struct TLongitude {
+    static const int degStrLength = 3;
+    double value;
+    explicit TLongitude(double v) : value{v} {}
+    char Sign() const { return value < 0 ? 'W' : 'E'; }
+  };
+
+  struct TLatitude {
+    static const int degStrLength = 2;
+    double value;
+    explicit TLatitude(double v) : value{v} {}
+    char Sign() const { return value < 0 ? 'S' : 'N'; }
+  };
+
+  std::string Coord2DDMMFF(TLongitude coord);
+  std::string Coord2DDMMFF(TLatitude coord);
+  std::string Coord2DDMMSS(TLongitude coord);
+  std::string Coord2DDMMSS(TLatitude coord);
+
+  int KmH2MS(int value);
+
+  double Deg2Rad(double angle);
+  double Rad2Deg(double angle);
+
+  // disk operations
+  void DirectoryCreate(const bfs::path &dirName);
+  bool FileExists(const bfs::path &fileName);
+
+  /*
+   * @brief Stream types
+   */
+  enum class TPathType {
+    LOCAL,                              ///< @brief Local path. 
+    ACTIVE_SYNC,                        ///< @brief ActiveSync (remote device) path. 
+    MEMORY                              ///< @brief In-memory file system path.
+  };
+  TPathType PathType(const bfs::path &fileName);
+
+}
+
+
+namespace condor2nav {
+
+  /**
+   * @brief Converts string to a type using STL streams.
+   */
+  template<class T>
+  T ConvertString(boost::string_ref str, std::integral_constant<int, 0>)
+  {
+    T value;
+    std::stringstream stream{str.to_string()};
+    stream >> value;
+    if(stream.fail() && !stream.eof())
+      throw EOperationFailed{"Cannot convert '" + str.to_string() + "' to requested type!!!"};
+    return value;
+  }
+
+  /**
+   * @brief Converts string to an integer type.
+   *
+   * Values out of the range of @p T are not accepted. Negative values of
+   * unsigned types are returned in 2's complement as STL streams do.
+   */
+  template<class T>
+  T ConvertString(boost::string_ref str, std::integral_constant<int, 1>)
+  {
+    bool negative;
+    unsigned long long magnitude;
+    if(!StringToInteger(str, negative, magnitude) ||
+       magnitude > static_cast<unsigned long long>((std::numeric_limits<T>::max)()) + (negative && std::is_signed<T>::value ? 1 : 0))
+      throw EOperationFailed{"Cannot convert '" + str.to_string() + "' to requested type!!!"};
+    return static_cast<T>(negative ? 0 - magnitude : magnitude);
+  }
+
+  /**
+   * @brief Converts string to a floating point type.
+   */
+  template<class T>
+  T ConvertString(boost::string_ref str, std::integral_constant<int, 2>)
+  {
+    double value;
+    if(!StringToDouble(str, value))
+      throw EOperationFailed{"Cannot convert '" + str.to_string() + "' to requested type!!!"};
+    return static_cast<T>(value);
+  }
+
+  /**
+   * @brief Converts a type to string using STL streams.
+   */
+  template<class T>
+  std::string ConvertValue(const T &val, std::integral_constant<int, 0>)
+  {
+    std::stringstream stream;
+    stream << val;
+    return stream.str();
+  }
+
+  /**
+   * @brief Converts an integer type to string.
+   */
+  template<class T>
+  std::string ConvertValue(const T &val, std::integral_constant<int, 1>)
+  {
+    return std::is_signed<T>::value ? IntegerToString(static_cast<long long>(val)) : IntegerToString(static_cast<unsigned long long>(val));
+  }
+
+  /**
+   * @brief Converts a floating point type to string.
+   */
+  template<class T>
+  std::string ConvertValue(const T &val, std::integral_constant<int, 2>)
+  {
+    return DoubleToString(val);
+  }
+
+}
+
+
+/**
+ * @brief Converts string to specific type.
+ *
+ * Function converts provided string to specified type. Arithmetic types are
+ * converted in a locale independent way without any memory allocations.
+ * Other types are converted using STL streams so the output type have to provide
+ * the means to initialize itself from the stream.
+ *
+ * @param str The string to convert.
+ *
+ * @exception std Thrown when operation failed.
+ *
+ * @return The data of specified type.
+ */
+template<class T>
+T condor2nav::Convert(boost::string_ref str)
+{
+  return ConvertString<T>(str, typename CConvertMethod<T>::type{});
+}
+
+
+/**
+ * @brief Converts any type to a string.
+ *
+ * Function converts provided data to a string. Arithmetic types are converted
+ * in a locale independent way. Other types are converted using STL streams so
+ * the input type have to provide the means to convert itself into the stream.
+ *
+ * @param val The value to convert.
+ *
+ * @exception std Thrown when operation failed.
+ *
+ * @return The string describing provided data.
+ */
+template<class T>
+std::string condor2nav::Convert(const T &val)
+{
+  return ConvertValue(val, typename CConvertMethod<T>::type{});
+}
+
+
+#endif /* __TOOLS_H__ */
@@ -0,0 +1,286 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file transfer.cpp
+ *
+ * @brief Implements the condor2nav::CTransfer class.
+ */
+
+#include "transfer.h"
+#include "waitQueue.h"
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CTransfer::CFileSource class constructor.
+ *
+ * @param path The path of the file to read.
+ *
+ * @exception EOperationFailed Thrown when the file cannot be opened.
+ */
+condor2nav::CTransfer::CFileSource::CFileSource(const bfs::path &path) :
+  _path{path.string()}, _size{0}
+{
+  HANDLE file = ::CreateFile(_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+    throw EOperationFailed{"ERROR: Couldn't open file '" + _path + "' for reading!!!"};
+  _file.reset(file);
+
+  LARGE_INTEGER size;
+  if(!::GetFileSizeEx(file, &size))
+    throw EOperationFailed{"ERROR: Couldn't obtain the size of '" + _path + "' file!!!"};
+  _size = static_cast<uint64_t>(size.QuadPart);
+}
+
+
+/**
+ * @brief Reads next data chunk from the file.
+ *
+ * @param buffer The buffer to fill.
+ * @param size   The size of the buffer.
+ *
+ * @return The number of bytes read (0 at the end of file).
+ *
+ * @exception EOperationFailed Thrown when the file cannot be read.
+ */
+size_t condor2nav::CTransfer::CFileSource::Read(char *buffer, size_t size)
+{
+  DWORD numBytes;
+  if(!::ReadFile(_file.get(), buffer, static_cast<DWORD>(size), &numBytes, nullptr))
+    throw EOperationFailed{"ERROR: Reading file '" + _path + "'!!!"};
+  return numBytes;
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CTransfer::CFileSink class constructor.
+ *
+ * @param path   The path of the file to write.
+ * @param append If true the data is appended to an existing file.
+ *
+ * @exception EOperationFailed Thrown when the file cannot be created.
+ */
+condor2nav::CTransfer::CFileSink::CFileSink(const bfs::path &path, bool append /* = false */) :
+  _path{path.string()}
+{
+  HANDLE file = ::CreateFile(_path.c_str(), GENERIC_WRITE, 0, nullptr, append ? OPEN_ALWAYS : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+    throw EOperationFailed{"ERROR: Couldn't open file '" + _path + "' for writing!!!"};
+  _file.reset(file);
+
+  LARGE_INTEGER distance;
+  distance.QuadPart = 0;
+  if(append && !::SetFilePointerEx(file, distance, nullptr, FILE_END))
+    throw EOperationFailed{"ERROR: Couldn't open file '" + _path + "' for appending!!!"};
+}
+
+
+/**
+ * @brief Writes next data chunk to the file.
+ *
+ * @param data The data to write.
+ * @param size The size of the data.
+ *
+ * @exception EOperationFailed Thrown when the file cannot be written.
+ */
+void condor2nav::CTransfer::CFileSink::Write(const char *data, size_t size)
+{
+  DWORD numBytes;
+  if(!::WriteFile(_file.get(), data, static_cast<DWORD>(size), &numBytes, nullptr) || numBytes != size)
+    throw EOperationFailed{"ERROR: Writing file '" + _path + "'!!!"};
+}
+
+
+/**
+ * @brief Preallocates the file.
+ *
+ * Extends the file by @p size bytes from the current position, so the file
+ * system may allocate it in one contiguous block. The current position is
+ * not changed.
+ *
+ * @param size The number of bytes that are going to be written.
+ *
+ * @exception EOperationFailed Thrown when the file cannot be extended.
+ */
+void condor2nav::CTransfer::CFileSink::Reserve(uint64_t size)
+{
+  LARGE_INTEGER distance, pos;
+  distance.QuadPart = 0;
+  if(!::SetFilePointerEx(_file.get(), distance, &pos, FILE_CURRENT))
+    throw EOperationFailed{"ERROR: Couldn't preallocate file '" + _path + "'!!!"};
+  distance.QuadPart = pos.QuadPart + static_cast<LONGLONG>(size);
+  if(!::SetFilePointerEx(_file.get(), distance, nullptr, FILE_BEGIN) || !::SetEndOfFile(_file.get()) ||
+     !::SetFilePointerEx(_file.get(), pos, nullptr, FILE_BEGIN))
+    throw EOperationFailed{"ERROR: Couldn't preallocate file '" + _path + "'!!!"};
+}
+
+
+/**
+ * @brief Truncates the file at the current position.
+ *
+ * Removes the space reserved and not written.
+ *
+ * @exception EOperationFailed Thrown when the file cannot be truncated.
+ */
+void condor2nav::CTransfer::CFileSink::Truncate()
+{
+  if(!::SetEndOfFile(_file.get()))
+    throw EOperationFailed{"ERROR: Couldn't truncate file '" + _path + "'!!!"};
+}
+
+
+/**
+ * @brief Creates progress callback writing to the log.
+ *
+ * Returned callback logs the percentage of transferred data every time it
+ * crosses the next multiple of @p step.
+ *
+ * @param log  The logger to use.
+ * @param name The name of the transferred file.
+ * @param step Logging step in percents.
+ *
+ * @return Progress callback.
+ */
+condor2nav::CTransfer::FProgress condor2nav::CTransfer::ProgressLog(const CCondor2Nav::CLogger &log, const std::string &name, unsigned step /* = 10 */)
+{
+  auto logged = std::make_shared<unsigned>(0);
+  step = std::max(step, 1u);
+  return [&log, name, step, logged](uint64_t done, uint64_t total) {
+    const unsigned percent = total ? static_cast<unsigned>(done * 100 / total) : 100;
+    if(percent / step * step > *logged || (percent == 100 && *logged < 100)) {
+      *logged = percent == 100 ? 100 : percent / step * step;
+      log << name << ": " << *logged << "% (" << done << " / " << total << " bytes)" << std::endl;
+    }
+  };
+}
+
+
+/**
+ * @brief Class constructor.
+ *
+ * condor2nav::CTransfer class constructor.
+ *
+ * @param chunkSize The size of a transferred chunk.
+ */
+condor2nav::CTransfer::CTransfer(size_t chunkSize /* = CHUNK_SIZE */)
+{
+  _buffers[0].resize(chunkSize);
+  _buffers[1].resize(chunkSize);
+}
+
+
+/**
+ * @brief Transfers all the data from the source to the sink.
+ *
+ * Chunks are read by a separate thread into the free buffer while the other
+ * buffer is written to the sink. If @p overlap is false chunks are read and
+ * written one after another by the calling thread. Progress callback is
+ * called after every chunk written.
+ *
+ * @param src      Data source.
+ * @param dest     Data sink.
+ * @param progress Progress callback.
+ * @param overlap  Read the source in a separate thread.
+ *
+ * @return The number of bytes transferred.
+ *
+ * @exception EOperationFailed Thrown when reading or writing fails.
+ */
+uint64_t condor2nav::CTransfer::Run(CSource &src, CSink &dest, const FProgress &progress /* = FProgress() */, bool overlap /* = true */)
+{
+  struct TChunk {
+    unsigned buffer;                                  ///< @brief Filled buffer index.
+    size_t size;                                      ///< @brief The number of bytes in the buffer (0 at the end of data).
+    std::exception_ptr error;                         ///< @brief Read error.
+  };
+
+  const uint64_t total = src.Size();
+  uint64_t done = 0;
+  if(!overlap) {
+    auto &buffer = _buffers[0];
+    while(const size_t size = src.Read(buffer.data(), buffer.size())) {
+      dest.Write(buffer.data(), size);
+      done += size;
+      if(progress)
+        progress(done, total);
+    }
+    return done;
+  }
+
+  CWaitQueue<unsigned> freeBuffers;
+  CWaitQueue<TChunk> fullBuffers;
+  std::atomic<bool> abort{false};
+  freeBuffers.Push(0);
+  freeBuffers.Push(1);
+
+  std::thread reader{[&]{
+    try {
+      while(true) {
+        const unsigned index = freeBuffers.PopWait();
+        if(abort)
+          break;
+        auto &buffer = _buffers[index];
+        const TChunk chunk = { index, src.Read(buffer.data(), buffer.size()), nullptr };
+        fullBuffers.Push(chunk);
+        if(!chunk.size)
+          break;
+      }
+    }
+    catch(...) {
+      const TChunk chunk = { 0, 0, std::current_exception() };
+      fullBuffers.Push(chunk);
+    }
+  }};
+
+  try {
+    while(true) {
+      const TChunk chunk = fullBuffers.PopWait();
+      if(chunk.error)
+        std::rethrow_exception(chunk.error);
+      if(!chunk.size)
+        break;
+      dest.Write(_buffers[chunk.buffer].data(), chunk.size);
+      done += chunk.size;
+      if(progress)
+        progress(done, total);
+      freeBuffers.Push(chunk.buffer);
+    }
+  }
+  catch(...) {
+    // wake up and stop the reader
+    abort = true;
+    freeBuffers.Push(0);
+    reader.join();
+    throw;
+  }
+  reader.join();
+  return done;
+}
@@ -0,0 +1,150 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file transfer.h
+ *
+ * @brief Declares the condor2nav::CTransfer class.
+ */
+
+#ifndef __TRANSFER_H__
+#define __TRANSFER_H__
+
+#include "condor2nav.h"
+#include "nonCopyable.h"
+#include "tools.h"
+#include "boostfwd.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace condor2nav {
+
+  /**
+   * @brief Chunked streaming data transfer.
+   *
+   * condor2nav::CTransfer copies data from a source to a sink in chunks of
+   * a constant size so big files never have to fit in memory. Two reusable
+   * buffers are used: the next chunk is read from the source in a separate
+   * thread while the previous one is being written to the sink, so slow
+   * local disk reads overlap slow remote writes. Sources that may be used
+   * only from the calling thread (i.e. RAPI connection) are read without
+   * overlapping.
+   */
+  class CTransfer : CNonCopyable {
+  public:
+    /**
+     * @brief Progress callback.
+     *
+     * @param done  The number of bytes already transferred.
+     * @param total The number of bytes to transfer.
+     */
+    using FProgress = std::function<void(uint64_t done, uint64_t total)>;
+
+    /**
+     * @brief Data source.
+     */
+    class CSource : CNonCopyable {
+    public:
+      virtual ~CSource() {}
+
+      /**
+       * @brief Returns the number of bytes to transfer.
+       */
+      virtual uint64_t Size() const = 0;
+
+      /**
+       * @brief Reads next data chunk.
+       *
+       * @param buffer The buffer to fill.
+       * @param size   The size of the buffer.
+       *
+       * @return The number of bytes read (0 at the end of data).
+       */
+      virtual size_t Read(char *buffer, size_t size) = 0;
+    };
+
+    /**
+     * @brief Data sink.
+     */
+    class CSink : CNonCopyable {
+    public:
+      virtual ~CSink() {}
+
+      /**
+       * @brief Writes next data chunk.
+       *
+       * @param data The data to write.
+       * @param size The size of the data.
+       */
+      virtual void Write(const char *data, size_t size) = 0;
+
+      /**
+       * @brief Reserves space for the data that is going to be written.
+       *
+       * @param size The number of bytes that are going to be written.
+       */
+      virtual void Reserve(uint64_t size) {}
+    };
+
+    /**
+     * @brief Local file data source.
+     */
+    class CFileSource : public CSource {
+      const std::string _path;                        ///< @brief File path.
+      CHandleRes _file;                               ///< @brief File handle.
+      uint64_t _size;                                 ///< @brief File size.
+    public:
+      explicit CFileSource(const bfs::path &path);
+      uint64_t Size() const override { return _size; }
+      size_t Read(char *buffer, size_t size) override;
+    };
+
+    /**
+     * @brief Local file data sink.
+     */
+    class CFileSink : public CSink {
+      const std::string _path;                        ///< @brief File path.
+      CHandleRes _file;                               ///< @brief File handle.
+    public:
+      explicit CFileSink(const bfs::path &path, bool append = false);
+      void Write(const char *data, size_t size) override;
+      void Reserve(uint64_t size) override;
+      void Truncate();
+    };
+
+    static const size_t CHUNK_SIZE = 64 * 1024;       ///< @brief Default size of a transferred chunk.
+
+  private:
+    std::vector<char> _buffers[2];                    ///< @brief Reusable chunk buffers.
+
+  public:
+    static FProgress ProgressLog(const CCondor2Nav::CLogger &log, const std::string &name, unsigned step = 10);
+
+    explicit CTransfer(size_t chunkSize = CHUNK_SIZE);
+    size_t ChunkSize() const { return _buffers[0].size(); }
+    uint64_t Run(CSource &src, CSink &dest, const FProgress &progress = FProgress(), bool overlap = true);
+  };
+
+}
+
+#endif /* __TRANSFER_H__ */
@@ -0,0 +1,528 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file vfs.cpp
+ *
+ * @brief Implements the condor2nav::CVfs class hierarchy.
+ */
+
+#include "vfs.h"
+#include "activeSync.h"
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <algorithm>
+#include <cctype>
+#include <windows.h>
+
+
+const char *condor2nav::CVfs::SCHEME_LOCAL       = "file";
+const char *condor2nav::CVfs::SCHEME_ACTIVE_SYNC = "activesync";
+const char *condor2nav::CVfs::SCHEME_MEMORY      = "mem";
+
+
+namespace {
+
+  /**
+   * @brief Registered backends.
+   */
+  struct TRegistry {
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<condor2nav::CVfs>> backends;
+
+    TRegistry()
+    {
+      using namespace condor2nav;
+      backends[CVfs::SCHEME_LOCAL] = std::make_shared<CVfsLocal>();
+      backends[CVfs::SCHEME_ACTIVE_SYNC] = std::make_shared<CVfsActiveSync>();
+      backends[CVfs::SCHEME_MEMORY] = std::make_shared<CVfsMemory>();
+    }
+  };
+
+  TRegistry &Registry()
+  {
+    static TRegistry registry;
+    return registry;
+  }
+
+  /**
+   * @brief Returns the scheme name of the path.
+   *
+   * @param str Native path string.
+   *
+   * @return Scheme name.
+   */
+  template<typename String>
+  std::string SchemeParse(const String &str)
+  {
+    // ActiveSync paths start with a single backslash
+    if(str.size() > 2 && str[0] == '\\' && str[1] != '\\')
+      return condor2nav::CVfs::SCHEME_ACTIVE_SYNC;
+
+    // "scheme://" prefix (single letter is a drive name)
+    size_t i = 0;
+    while(i < str.size() && i < 16 && ((str[i] >= 'a' && str[i] <= 'z') || (str[i] >= 'A' && str[i] <= 'Z')))
+      i++;
+    if(i > 1 && i + 2 < str.size() && str[i] == ':' && str[i + 1] == '/' && str[i + 2] == '/') {
+      std::string scheme;
+      for(size_t j=0; j<i; j++)
+        scheme += static_cast<char>(std::tolower(static_cast<unsigned char>(str[j])));
+      return scheme;
+    }
+
+    return condor2nav::CVfs::SCHEME_LOCAL;
+  }
+
+  /**
+   * @brief Converts Windows file time to the number of seconds since epoch.
+   */
+  int64_t FileTime2Time(const FILETIME &time)
+  {
+    const int64_t ticks = (static_cast<int64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    return (ticks - 116444736000000000LL) / 10000000;
+  }
+
+}
+
+
+/**
+ * @brief Returns the scheme of the path.
+ *
+ * @param path The path to check.
+ *
+ * @return Scheme name.
+ */
+std::string condor2nav::CVfs::Scheme(const bfs::path &path)
+{
+  return SchemeParse(path.native());
+}
+
+
+/**
+ * @brief Returns the backend handling the path.
+ *
+ * @param path The path to handle.
+ *
+ * @return Registered backend.
+ *
+ * @exception EOperationFailed Thrown when the path scheme is not registered.
+ */
+condor2nav::CVfs &condor2nav::CVfs::Instance(const bfs::path &path)
+{
+  const auto scheme = Scheme(path);
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock{registry.mutex};
+  auto it = registry.backends.find(scheme);
+  if(it == registry.backends.end())
+    throw EOperationFailed{"ERROR: Unsupported path scheme '" + scheme + "' in '" + path.string() + "'!!!"};
+  return *it->second;
+}
+
+
+/**
+ * @brief Registers the backend for the scheme.
+ *
+ * Backend already registered for the scheme is replaced. Backends should be
+ * registered before the file operations start.
+ *
+ * @param scheme The name of the scheme.
+ * @param vfs    The backend.
+ */
+void condor2nav::CVfs::Register(const std::string &scheme, std::shared_ptr<CVfs> vfs)
+{
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock{registry.mutex};
+  registry.backends[scheme] = std::move(vfs);
+}
+
+
+/**
+ * @brief Unregisters the backend of the scheme.
+ *
+ * Paths with that scheme are not supported anymore until a new backend is
+ * registered for it.
+ *
+ * @param scheme The name of the scheme.
+ */
+void condor2nav::CVfs::Unregister(const std::string &scheme)
+{
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock{registry.mutex};
+  registry.backends.erase(scheme);
+}
+
+
+/**
+ * @brief Replaces the file with the other one in one operation.
+ *
+ * @exception EOperationFailed Always thrown as not supported by default.
+ */
+void condor2nav::CVfs::Replace(const bfs::path &src, const bfs::path &dest)
+{
+  throw EOperationFailed{"ERROR: Replacing '" + dest.string() + "' with '" + src.string() + "' is not supported!!!"};
+}
+
+
+/**
+ * @brief Replaces the existing file with the other one keeping a backup of it.
+ *
+ * By default the file is moved to the backup path and then replaced. If the
+ * second step fails the file is moved back.
+ *
+ * @exception EOperationFailed Thrown when the file cannot be replaced.
+ */
+void condor2nav::CVfs::Replace(const bfs::path &src, const bfs::path &dest, const bfs::path &backup)
+{
+  Replace(dest, backup);
+  try {
+    Replace(src, dest);
+  }
+  catch(...) {
+    try {
+      Replace(backup, dest);
+    }
+    catch(...) {
+      // keep the original error
+    }
+    throw;
+  }
+}
+
+
+/**
+ * @brief Copies a local file to the file system.
+ *
+ * Local file is read in chunks and written with one condor2nav::CVfs::Write() call.
+ *
+ * @param src      The path of the local file.
+ * @param dest     The path of the destination file.
+ * @param progress Progress callback.
+ *
+ * @return The number of bytes copied.
+ */
+uint64_t condor2nav::CVfs::Upload(const bfs::path &src, const bfs::path &dest, const CTransfer::FProgress &progress /* = CTransfer::FProgress() */)
+{
+  class CStringSink : public CTransfer::CSink {
+    std::string &_str;
+  public:
+    explicit CStringSink(std::string &str) : _str(str) {}
+    void Write(const char *data, size_t size) override { _str.append(data, size); }
+  };
+
+  CTransfer::CFileSource source{src};
+  std::string data;
+  data.reserve(static_cast<size_t>(source.Size()));
+  CStringSink sink{data};
+  CTransfer{}.Run(source, sink, progress);
+  Write(dest, { data });
+  return data.size();
+}
+
+
+
+/* ******************************** L O C A L ******************************** */
+
+std::string condor2nav::CVfsLocal::Read(const bfs::path &path) const
+{
+  bfs::ifstream stream{path, std::ios_base::in | std::ios_base::binary};
+  if(!stream)
+    throw EOperationFailed{"ERROR: Couldn't open file '" + path.string() + "' for reading!!!"};
+  std::ostringstream buffer;
+  buffer << stream.rdbuf();
+  return buffer.str();
+}
+
+
+void condor2nav::CVfsLocal::Write(const bfs::path &path, const std::vector<boost::string_ref> &buffers)
+{
+  HANDLE file = ::CreateFile(path.string().c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+    throw EOperationFailed{"ERROR: Couldn't open file '" + path.string() + "' for writing!!!"};
+  CHandleRes handle{file};
+  for(auto &buffer : buffers) {
+    const char *data = buffer.data();
+    size_t left = buffer.size();
+    while(left) {
+      DWORD written = 0;
+      if(!::WriteFile(file, data, static_cast<DWORD>(left), &written, nullptr) || !written)
+        throw EOperationFailed{"ERROR: Couldn't write file '" + path.string() + "'!!!"};
+      data += written;
+      left -= written;
+    }
+  }
+}
+
+
+bool condor2nav::CVfsLocal::Remove(const bfs::path &path)
+{
+  return bfs::remove(path);
+}
+
+
+void condor2nav::CVfsLocal::DirectoryCreate(const bfs::path &path)
+{
+  if(!path.empty())
+    bfs::create_directories(path);
+}
+
+
+bool condor2nav::CVfsLocal::Exists(const bfs::path &path) const
+{
+  return bfs::exists(path);
+}
+
+
+bool condor2nav::CVfsLocal::Stat(const bfs::path &path, TStat &stat) const
+{
+  boost::system::error_code ec;
+  const auto status = bfs::status(path, ec);
+  if(ec || !bfs::exists(status))
+    return false;
+  stat.directory = bfs::is_directory(status);
+  stat.size = stat.directory ? 0 : bfs::file_size(path, ec);
+  stat.time = static_cast<int64_t>(bfs::last_write_time(path, ec));
+  return !ec;
+}
+
+
+std::vector<bfs::path> condor2nav::CVfsLocal::List(const bfs::path &path) const
+{
+  std::vector<bfs::path> entries;
+  for(bfs::directory_iterator it{path}, end; it != end; ++it)
+    entries.push_back(it->path());
+  return entries;
+}
+
+
+void condor2nav::CVfsLocal::Replace(const bfs::path &src, const bfs::path &dest)
+{
+  boost::system::error_code ec;
+  bfs::rename(src, dest, ec);
+  if(ec)
+    throw EOperationFailed{"ERROR: Couldn't replace file '" + dest.string() + "'!!!"};
+}
+
+
+void condor2nav::CVfsLocal::Replace(const bfs::path &src, const bfs::path &dest, const bfs::path &backup)
+{
+  // the destination file exists under its name until the replacement is moved in
+  if(!::ReplaceFile(dest.string().c_str(), src.string().c_str(), backup.string().c_str(), REPLACEFILE_IGNORE_MERGE_ERRORS, nullptr, nullptr)) {
+    if(::GetLastError() == ERROR_UNABLE_TO_MOVE_REPLACEMENT_2) {
+      boost::system::error_code ignored;
+      bfs::rename(backup, dest, ignored);
+    }
+    throw EOperationFailed{"ERROR: Couldn't replace file '" + dest.string() + "'!!!"};
+  }
+}
+
+
+uint64_t condor2nav::CVfsLocal::Upload(const bfs::path &src, const bfs::path &dest, const CTransfer::FProgress &progress /* = CTransfer::FProgress() */)
+{
+  CTransfer::CFileSource source{src};
+  CTransfer::CFileSink sink{dest};
+  return CTransfer{}.Run(source, sink, progress);
+}
+
+
+
+/* ************************** A C T I V E   S Y N C ************************** */
+
+std::string condor2nav::CVfsActiveSync::Read(const bfs::path &path) const
+{
+  return CActiveSync::Instance().Read(path);
+}
+
+
+void condor2nav::CVfsActiveSync::Write(const bfs::path &path, const std::vector<boost::string_ref> &buffers)
+{
+  CActiveSync::Instance().Write(path, buffers);
+}
+
+
+bool condor2nav::CVfsActiveSync::Remove(const bfs::path &path)
+{
+  return CActiveSync::Instance().Remove(path);
+}
+
+
+void condor2nav::CVfsActiveSync::DirectoryCreate(const bfs::path &path)
+{
+  CActiveSync::Instance().DirectoryCreate(path);
+}
+
+
+bool condor2nav::CVfsActiveSync::Exists(const bfs::path &path) const
+{
+  return CActiveSync::Instance().FileExists(path);
+}
+
+
+bool condor2nav::CVfsActiveSync::Stat(const bfs::path &path, TStat &stat) const
+{
+  DWORD attributes;
+  FILETIME time;
+  if(!CActiveSync::Instance().Stat(path, attributes, stat.size, time))
+    return false;
+  stat.directory = (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+  stat.time = FileTime2Time(time);
+  return true;
+}
+
+
+std::vector<bfs::path> condor2nav::CVfsActiveSync::List(const bfs::path &path) const
+{
+  return CActiveSync::Instance().List(path);
+}
+
+
+uint64_t condor2nav::CVfsActiveSync::Upload(const bfs::path &src, const bfs::path &dest, const CTransfer::FProgress &progress /* = CTransfer::FProgress() */)
+{
+  return CActiveSync::Instance().Upload(src, dest, progress);
+}
+
+
+
+/* ******************************* M E M O R Y ******************************* */
+
+condor2nav::CVfsMemory::CVfsMemory() :
+  _tick{0}
+{
+}
+
+
+std::string condor2nav::CVfsMemory::Read(const bfs::path &path) const
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto it = _files.find(path.generic_string());
+  if(it == _files.end())
+    throw EOperationFailed{"ERROR: Couldn't open file '" + path.string() + "' for reading!!!"};
+  return it->second.data;
+}
+
+
+void condor2nav::CVfsMemory::Write(const bfs::path &path, const std::vector<boost::string_ref> &buffers)
+{
+  TFile file;
+  for(auto &buffer : buffers)
+    file.data.append(buffer.data(), buffer.size());
+  std::lock_guard<std::mutex> lock{_mutex};
+  file.time = ++_tick;
+  _files[path.generic_string()] = std::move(file);
+}
+
+
+bool condor2nav::CVfsMemory::Remove(const bfs::path &path)
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _files.erase(path.generic_string()) > 0;
+}
+
+
+void condor2nav::CVfsMemory::DirectoryCreate(const bfs::path &path)
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  for(auto dir = path; !dir.empty(); ) {
+    _dirs.insert(dir.generic_string());
+    auto parent = dir.parent_path();
+    if(parent == dir)
+      break;
+    dir = parent;
+  }
+}
+
+
+bool condor2nav::CVfsMemory::Exists(const bfs::path &path) const
+{
+  const auto key = path.generic_string();
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _files.count(key) || _dirs.count(key);
+}
+
+
+bool condor2nav::CVfsMemory::Stat(const bfs::path &path, TStat &stat) const
+{
+  const auto key = path.generic_string();
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto it = _files.find(key);
+  if(it != _files.end()) {
+    stat.size = it->second.data.size();
+    stat.time = it->second.time;
+    stat.directory = false;
+    return true;
+  }
+  if(_dirs.count(key)) {
+    stat.size = 0;
+    stat.time = 0;
+    stat.directory = true;
+    return true;
+  }
+  return false;
+}
+
+
+std::vector<bfs::path> condor2nav::CVfsMemory::List(const bfs::path &path) const
+{
+  const auto key = path.generic_string();
+  std::vector<bfs::path> entries;
+  std::lock_guard<std::mutex> lock{_mutex};
+  for(auto it = _files.lower_bound(key); it != _files.end() && it->first.compare(0, key.size(), key) == 0; ++it)
+    if(bfs::path{it->first}.parent_path().generic_string() == key)
+      entries.emplace_back(it->first);
+  for(auto it = _dirs.upper_bound(key); it != _dirs.end() && it->compare(0, key.size(), key) == 0; ++it)
+    if(bfs::path{*it}.parent_path().generic_string() == key)
+      entries.emplace_back(*it);
+  return entries;
+}
+
+
+void condor2nav::CVfsMemory::Replace(const bfs::path &src, const bfs::path &dest)
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto it = _files.find(src.generic_string());
+  if(it == _files.end())
+    throw EOperationFailed{"ERROR: Couldn't replace file '" + dest.string() + "'!!!"};
+  _files[dest.generic_string()] = std::move(it->second);
+  _files.erase(src.generic_string());
+}
+
+
+void condor2nav::CVfsMemory::Replace(const bfs::path &src, const bfs::path &dest, const bfs::path &backup)
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto it = _files.find(src.generic_string());
+  auto old = _files.find(dest.generic_string());
+  if(it == _files.end() || old == _files.end())
+    throw EOperationFailed{"ERROR: Couldn't replace file '" + dest.string() + "'!!!"};
+  _files[backup.generic_string()] = std::move(old->second);
+  _files[dest.generic_string()] = std::move(it->second);
+  _files.erase(src.generic_string());
+}
+
+
+/**
+ * @brief Removes all the files and directories.
+ */
+void condor2nav::CVfsMemory::Clear()
+{
+  std::lock_guard<std::mutex> lock{_mutex};
+  _files.clear();
+  _dirs.clear();
+}
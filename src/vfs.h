@@ -0,0 +1,251 @@
+//
+// This file is part of Condor2Nav file formats translator.
+//
+// Copyright (C) 2009-2012 Mateusz Pusz
+//
+// Condor2Nav is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Condor2Nav is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Condor2Nav. If not, see <http://www.gnu.org/licenses/>.
+//
+// Visit the project webpage (http://sf.net/projects/condor2nav) for more info.
+//
+
+/**
+ * @file vfs.h
+ *
+ * @brief Declares the condor2nav::CVfs class hierarchy.
+ */
+
+#ifndef __VFS_H__
+#define __VFS_H__
+
+#include "nonCopyable.h"
+#include "tools.h"
+#include "transfer.h"
+#include "boostfwd.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace condor2nav {
+
+  /**
+   * @brief Virtual file system interface.
+   *
+   * condor2nav::CVfs is an abstract interface to a storage of files. Backends
+   * are registered for URI schemes and selected with condor2nav::CVfs::Instance()
+   * based on the path prefix:
+   * - "mem://..." - in-memory storage (condor2nav::CVfsMemory)
+   * - "\..." (single backslash) - ActiveSync device (condor2nav::CVfsActiveSync)
+   * - any other path - local file system (condor2nav::CVfsLocal)
+   */
+  class CVfs : CNonCopyable {
+  public:
+    /**
+     * @brief File information.
+     */
+    struct TStat {
+      uint64_t size;                                  ///< @brief File size.
+      int64_t time;                                   ///< @brief Last write time (seconds since epoch).
+      bool directory;                                 ///< @brief true for directories.
+    };
+
+    static const char *SCHEME_LOCAL;                  ///< @brief Local file system scheme name.
+    static const char *SCHEME_ACTIVE_SYNC;            ///< @brief ActiveSync scheme name.
+    static const char *SCHEME_MEMORY;                 ///< @brief In-memory storage scheme name.
+
+    static std::string Scheme(const bfs::path &path);
+    static CVfs &Instance(const bfs::path &path);
+    static void Register(const std::string &scheme, std::shared_ptr<CVfs> vfs);
+    static void Unregister(const std::string &scheme);
+
+    virtual ~CVfs() {}
+
+    /**
+     * @brief Returns the type of paths handled by the backend.
+     */
+    virtual TPathType Type() const = 0;
+
+    /**
+     * @brief Reads the whole file.
+     *
+     * @param path The path of the file.
+     *
+     * @return File content.
+     */
+    virtual std::string Read(const bfs::path &path) const = 0;
+
+    /**
+     * @brief Creates or truncates the file and writes data to it.
+     *
+     * @param path    The path of the file.
+     * @param buffers The data to write.
+     */
+    virtual void Write(const bfs::path &path, const std::vector<boost::string_ref> &buffers) = 0;
+
+    /**
+     * @brief Removes the file.
+     *
+     * @param path The path of the file.
+     *
+     * @return false if the file did not exist.
+     */
+    virtual bool Remove(const bfs::path &path) = 0;
+
+    /**
+     * @brief Creates directory together with all its missing parents.
+     *
+     * @param path The path of the directory.
+     */
+    virtual void DirectoryCreate(const bfs::path &path) = 0;
+
+    /**
+     * @brief Checks if the file or directory exists.
+     *
+     * @param path The path to check.
+     */
+    virtual bool Exists(const bfs::path &path) const = 0;
+
+    /**
+     * @brief Returns file information.
+     *
+     * @param path       The path of the file.
+     * @param [out] stat File information.
+     *
+     * @return false if the file does not exist.
+     */
+    virtual bool Stat(const bfs::path &path, TStat &stat) const = 0;
+
+    /**
+     * @brief Returns the paths of all the entries of the directory.
+     *
+     * @param path The path of the directory.
+     */
+    virtual std::vector<bfs::path> List(const bfs::path &path) const = 0;
+
+    /**
+     * @brief Checks if condor2nav::CVfs::Replace() is supported.
+     */
+    virtual bool ReplaceSupported() const { return false; }
+
+    /**
+     * @brief Replaces the file with the other one in one operation.
+     *
+     * @param src  The path of the new file.
+     * @param dest The path of the file to replace.
+     */
+    virtual void Replace(const bfs::path &src, const bfs::path &dest);
+
+    /**
+     * @brief Replaces the existing file with the other one keeping a backup of it.
+     *
+     * @param src    The path of the new file.
+     * @param dest   The path of the file to replace.
+     * @param backup The path the replaced file is moved to.
+     */
+    virtual void Replace(const bfs::path &src, const bfs::path &dest, const bfs::path &backup);
+
+    /**
+     * @brief Copies a local file to the file system.
+     *
+     * @param src      The path of the local file.
+     * @param dest     The path of the destination file.
+     * @param progress Progress callback.
+     *
+     * @return The number of bytes copied.
+     */
+    virtual uint64_t Upload(const bfs::path &src, const bfs::path &dest, const CTransfer::FProgress &progress = CTransfer::FProgress());
+  };
+
+
+  /**
+   * @brief Local file system.
+   */
+  class CVfsLocal : public CVfs {
+  public:
+    TPathType Type() const override { return TPathType::LOCAL; }
+    std::string Read(const bfs::path &path) const override;
+    void Write(const bfs::path &path, const std::vector<boost::string_ref> &buffers) override;
+    bool Remove(const bfs::path &path) override;
+    void DirectoryCreate(const bfs::path &path) override;
+    bool Exists(const bfs::path &path) const override;
+    bool Stat(const bfs::path &path, TStat &stat) const override;
+    std::vector<bfs::path> List(const bfs::path &path) const override;
+    bool ReplaceSupported() const override { return true; }
+    void Replace(const bfs::path &src, const bfs::path &dest) override;
+    void Replace(const bfs::path &src, const bfs::path &dest, const bfs::path &backup) override;
+    uint64_t Upload(const bfs::path &src, const bfs::path &dest, const CTransfer::FProgress &progress = CTransfer::FProgress()) override;
+  };
+
+
+  /**
+   * @brief Files on the device connected with ActiveSync.
+   *
+   * ActiveSync connection is established on the first use.
+   */
+  class CVfsActiveSync : public CVfs {
+  public:
+    TPathType Type() const override { return TPathType::ACTIVE_SYNC; }
+    std::string Read(const bfs::path &path) const override;
+    void Write(const bfs::path &path, const std::vector<boost::string_ref> &buffers) override;
+    bool Remove(const bfs::path &path) override;
+    void DirectoryCreate(const bfs::path &path) override;
+    bool Exists(const bfs::path &path) const override;
+    bool Stat(const bfs::path &path, TStat &stat) const override;
+    std::vector<bfs::path> List(const bfs::path &path) const override;
+    uint64_t Upload(const bfs::path &src, const bfs::path &dest, const CTransfer::FProgress &progress = CTransfer::FProgress()) override;
+  };
+
+
+  /**
+   * @brief In-memory file system.
+   *
+   * Files are kept in memory only. Useful for tests and benchmarks that should
+   * not touch the disk. All the paths are compared in their generic form.
+   */
+  class CVfsMemory : public CVfs {
+    /**
+     * @brief In-memory file.
+     */
+    struct TFile {
+      std::string data;                               ///< @brief File content.
+      int64_t time;                                   ///< @brief Write counter value of the last write.
+    };
+
+    mutable std::mutex _mutex;                        ///< @brief Files access synchronization.
+    std::map<std::string, TFile> _files;              ///< @brief Files.
+    std::set<std::string> _dirs;                      ///< @brief Created directories.
+    int64_t _tick;                                    ///< @brief Write counter used as file time.
+
+  public:
+    CVfsMemory();
+    TPathType Type() const override { return TPathType::MEMORY; }
+    std::string Read(const bfs::path &path) const override;
+    void Write(const bfs::path &path, const std::vector<boost::string_ref> &buffers) override;
+    bool Remove(const bfs::path &path) override;
+    void DirectoryCreate(const bfs::path &path) override;
+    bool Exists(const bfs::path &path) const override;
+    bool Stat(const bfs::path &path, TStat &stat) const override;
+    std::vector<bfs::path> List(const bfs::path &path) const override;
+    bool ReplaceSupported() const override { return true; }
+    void Replace(const bfs::path &src, const bfs::path &dest) override;
+    void Replace(const bfs::path &src, const bfs::path &dest, const bfs::path &backup) override;
+    void Clear();
+  };
+
+}
+
+#endif /* __VFS_H__ */